@@ -1,6 +1,7 @@
 #include <assert.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -14,8 +15,17 @@ const size_t DYNAMIC_ARRAY_RESIZE_MULTIPLIER = 2;
 
 typedef bool d_array_realloc_status_t;
 
+/**
+ * @brief Bytes of data stored inside the structure itself
+ *
+ * Strings up to 32 bytes are read without calling the allocator.
+ */
+#define DYNAMIC_ARRAY_INLINE_SIZE 32
+
 /**
  * @brief Dynamic array structure
+ *
+ * Must not be copied by value: array->data may point inside the structure.
  */
 typedef struct dynamic_array
 {
@@ -23,6 +33,10 @@ typedef struct dynamic_array
     size_t size;            ///< Current nuumber of elements in the array
     size_t capacity;        ///< Current capacity of the array
     size_t element_size;    ///< Size of each element in the array in bytes
+    bool   inlined;         ///< data is inline_buffer
+
+    _Alignas (max_align_t)
+    unsigned char inline_buffer[DYNAMIC_ARRAY_INLINE_SIZE]; ///< Small buffer
 }
 d_array_t;
 
@@ -54,6 +68,20 @@ DynamicArrayCheckRealloc (d_array_t* const array);
 
 static d_array_error_t
 DynamicArrayExecuteRealloc (d_array_t* const array);
+
+static d_array_error_t
+DynamicArraySetCapacity (d_array_t* const array,
+                         const size_t     capacity);
+
+static d_array_error_t
+DynamicArrayGrow (d_array_t* const array,
+                  const size_t     min_capacity);
+
+static size_t
+DynamicArrayInitialCapacity (const d_array_t* const array);
+
+static void
+DynamicArrayFreeData (d_array_t* const array);
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -73,7 +101,9 @@ DynamicArrayExecuteRealloc (d_array_t* const array);
  * @return pointer to the structure if success, NULL if error
  * 
  * Allocates memory for the dynamic array structure, initializes and returns it.
- * array->data field is NULL at this point.
+ * array->data field is NULL at this point. The first push takes
+ * DYNAMIC_ARRAY_INLINE_SIZE / element_size elements of capacity in
+ * array->inline_buffer, data moves to the heap only when it doesn't fit.
  */
 d_array_t*
 DynamicArrayConstructor       (const size_t element_size);
@@ -164,6 +194,20 @@ DynamicArrayPopNoRealloc      (d_array_t* const array);
 void*
 DynamicArrayGetElemPtrByIndex (d_array_t* const array,
                                const size_t index);
+
+/**
+ * @brief Adds one element to the end of array and returns pointer to it
+ * 
+ * @param array pointer to dynamic array structure
+ * 
+ * @return pointer to the new element on success, NULL on error
+ * 
+ * The element is not initialized, caller writes it through the pointer,
+ * so there is no copying from a buffer. Capacity only grows, so the
+ * check is cheaper than the one of DynamicArrayPush().
+ */
+void*
+DynamicArrayEmplace           (d_array_t* const array);
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -195,7 +239,7 @@ DynamicArrayDestructor (d_array_t* const array)
     if (array == NULL)
         return NULL;
 
-    free(array->data);
+    DynamicArrayFreeData (array);
     free(array);
 
     return NULL;
@@ -273,6 +317,19 @@ DynamicArrayGetElemPtrByIndex (d_array_t* const array,
 
     return (char*)array->data + (index * array->element_size);
 }
+
+void*
+DynamicArrayEmplace (d_array_t* const array)
+{
+    if (array == NULL)
+        return NULL;
+
+    if (array->size == array->capacity &&
+        DynamicArrayGrow (array, array->size + 1) == DYNAMIC_ARRAY_ERROR)
+        return NULL;
+
+    return (char*)array->data + (array->size++ * array->element_size);
+}
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -301,7 +358,7 @@ DynamicArrayCheckRealloc (d_array_t* const array)
 
     if (capacity == 0)
     {
-        array->capacity = 1;
+        array->capacity = DynamicArrayInitialCapacity (array);
         return true;
     }
 
@@ -311,8 +368,10 @@ DynamicArrayCheckRealloc (d_array_t* const array)
         return true;
     }
 
+    // inline buffer costs nothing, so it is never shrunk
     else if (size < capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER / 
-                               DYNAMIC_ARRAY_RESIZE_MULTIPLIER)
+                               DYNAMIC_ARRAY_RESIZE_MULTIPLIER &&
+             !array->inlined)
     {
         array->capacity /= DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
         return true;
@@ -328,13 +387,87 @@ DynamicArrayExecuteRealloc (d_array_t* const array)
 
     const size_t num_of_bytes = array->capacity * array->element_size;
 
-    void* const new_ptr = realloc (array->data, num_of_bytes);
+    if (num_of_bytes <= DYNAMIC_ARRAY_INLINE_SIZE)
+    {
+        if (!array->inlined)
+        {
+            if (array->data != NULL)
+                memcpy (array->inline_buffer, array->data, array->size * array->element_size);
+
+            DynamicArrayFreeData (array);
+            array->data    = array->inline_buffer;
+            array->inlined = true;
+        }
+
+        return DYNAMIC_ARRAY_SUCCESS;
+    }
+
+    // inline buffer can't be realloc()-ed, it is copied to the heap once
+    void* const new_ptr = (array->inlined) ? malloc  (num_of_bytes) :
+                                             realloc (array->data, num_of_bytes);
     if (new_ptr == NULL)
         return DYNAMIC_ARRAY_ERROR;
 
+    if (array->inlined)
+    {
+        memcpy (new_ptr, array->inline_buffer, array->size * array->element_size);
+        array->inlined = false;
+    }
+
     array->data = new_ptr;
     return DYNAMIC_ARRAY_SUCCESS;
 }
+
+static d_array_error_t
+DynamicArraySetCapacity (d_array_t* const array,
+                         const size_t     capacity)
+{
+    const size_t old_capacity = array->capacity;
+
+    array->capacity = capacity;
+
+    if (DynamicArrayExecuteRealloc (array) == DYNAMIC_ARRAY_ERROR)
+    {
+        array->capacity = old_capacity;
+        return DYNAMIC_ARRAY_ERROR;
+    }
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static d_array_error_t
+DynamicArrayGrow (d_array_t* const array,
+                  const size_t     min_capacity)
+{
+    size_t capacity = array->capacity * DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
+
+    if (capacity < min_capacity) capacity = min_capacity;
+    if (capacity == 0)           capacity = DynamicArrayInitialCapacity (array);
+
+    return DynamicArraySetCapacity (array, capacity);
+}
+
+static size_t
+DynamicArrayInitialCapacity (const d_array_t* const array)
+{
+    // the whole inline buffer is free, so the first push takes all of it
+    if (array->element_size != 0 &&
+        array->element_size <= DYNAMIC_ARRAY_INLINE_SIZE)
+        return DYNAMIC_ARRAY_INLINE_SIZE / array->element_size;
+
+    return 1;
+}
+
+static void
+DynamicArrayFreeData (d_array_t* const array)
+{
+    // inline buffer is a part of the structure, nothing to free
+    if (!array->inlined)
+        free (array->data);
+
+    array->data    = NULL;
+    array->inlined = false;
+}
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -1348,19 +1481,21 @@ ReadString (d_array_t* const input_array)
     input_array->size = 0;
     char c = 0;
 
+    // capacity stays between strings, so emplace reallocates only for longer ones
     while (true)
     {
+        char* const slot = (char*) DynamicArrayEmplace (input_array);
+        assert (slot);
+
         c = getchar ();
 
         if (isspace (c))
         {
-            c = '\0';
-            DynamicArrayPush (input_array, &c);
+            *slot = '\0';
             break;
         }
 
-        else
-            DynamicArrayPush (input_array, &c);
+        *slot = c;
     }
 }
 
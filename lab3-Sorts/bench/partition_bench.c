@@ -0,0 +1,350 @@
+/**
+ * Microbenchmark of partition kernels on their own, without recursion
+ * and with the same fixed pivot for every kernel.
+ * Usage: partition_bench [elem_number] [repetitions]
+ * Output lines: "kernel distribution distinct_values ns_per_elem branch_misses_per_elem",
+ * branch misses are -1 if perf events are not available.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "../include/qsort.h"
+#include "../include/radix_sort.h"
+#include "../include/cpu_dispatch.h"
+
+const size_t PARTITION_BENCH_DEFAULT_SIZE        = 1 << 20;
+const size_t PARTITION_BENCH_DEFAULT_REPETITIONS = 10;
+
+enum distribution
+{
+    DISTRIBUTION_RANDOM   = 0,
+    DISTRIBUTION_SORTED   = 1,
+    DISTRIBUTION_REVERSED = 2,
+
+    DISTRIBUTION_NUMBER
+};
+
+static const char* const distribution_names[DISTRIBUTION_NUMBER] =
+{
+    "random",
+    "sorted",
+    "reversed"
+};
+
+/* number of distinct values is elem_number / divisor, 0 means 1 value */
+#define DUPLICATE_RATIOS_NUMBER 4
+static const size_t duplicate_divisors[DUPLICATE_RATIOS_NUMBER] = {1, 16, 1 << 16, 0};
+
+/**
+ * @brief Runs one kernel on [0, elem_number) of array, buffer is scratch
+ * for out of place kernels.
+ */
+struct partition_kernel
+{
+    const char*      name;
+    void           (*run) (int* const array, const size_t elem_number,
+                           const int pivot_elem, int* const buffer);
+    enum cpu_variant variant;   ///< For sort_kernels.partition only.
+};
+
+static void RunLomuto         (int* const, const size_t, const int, int* const);
+static void RunHoare          (int* const, const size_t, const int, int* const);
+static void RunThick          (int* const, const size_t, const int, int* const);
+static void RunBentleyMcIlroy (int* const, const size_t, const int, int* const);
+static void RunKernel         (int* const, const size_t, const int, int* const);
+
+static const struct partition_kernel partition_kernels[] =
+{
+    {"lomuto",          RunLomuto,         CPU_VARIANT_GENERIC},
+    {"hoare",           RunHoare,          CPU_VARIANT_GENERIC},
+    {"thick",           RunThick,          CPU_VARIANT_GENERIC},
+    {"bentley_mcilroy", RunBentleyMcIlroy, CPU_VARIANT_GENERIC},
+    {"kernel_generic",  RunKernel,         CPU_VARIANT_GENERIC},
+    {"kernel_sse42",    RunKernel,         CPU_VARIANT_SSE42},
+    {"kernel_avx2",     RunKernel,         CPU_VARIANT_AVX2},
+    {"kernel_avx512",   RunKernel,         CPU_VARIANT_AVX512}
+};
+
+static void
+GenerateArray (int* const              array,
+               const size_t            elem_number,
+               const enum distribution distribution,
+               const size_t            distinct_number);
+
+static int
+OpenBranchMissesCounter (void);
+
+static double
+GetWallTime (void);
+
+static uint64_t bench_random_state = 0x2545F4914F6CDD1DULL;
+
+static uint64_t
+BenchRandom (void);
+
+int main (int argc, char* argv[])
+{
+    const size_t elem_number = (argc > 1) ? strtoull (argv[1], NULL, 10) :
+                                            PARTITION_BENCH_DEFAULT_SIZE;
+    const size_t repetitions = (argc > 2) ? strtoull (argv[2], NULL, 10) :
+                                            PARTITION_BENCH_DEFAULT_REPETITIONS;
+    if (elem_number < 2 || repetitions == 0)
+    {
+        fprintf (stderr, "usage: %s [elem_number >= 2] [repetitions >= 1]\n", argv[0]);
+        return 1;
+    }
+
+    int* const source = (int*) malloc (elem_number * sizeof (int));
+    int* const sorted = (int*) malloc (elem_number * sizeof (int));
+    int* const array  = (int*) malloc (elem_number * sizeof (int));
+    int* const buffer = (int*) malloc (elem_number * sizeof (int));
+    if (source == NULL || sorted == NULL || array == NULL || buffer == NULL)
+    {
+        fprintf (stderr, "can't allocate arrays\n");
+        return 1;
+    }
+
+    /* every partition takes the middle element as pivot */
+    PivotSetStrategy (PIVOT_MIDDLE);
+    const size_t pivot_index = (elem_number - 1) / 2;
+
+    const int counter = OpenBranchMissesCounter ();
+
+    for (int distribution = 0; distribution < DISTRIBUTION_NUMBER; ++distribution)
+    {
+        for (size_t ratio = 0; ratio < DUPLICATE_RATIOS_NUMBER; ++ratio)
+        {
+            size_t distinct_number = (duplicate_divisors[ratio] == 0) ? 1 :
+                                     elem_number / duplicate_divisors[ratio];
+            if (distinct_number == 0) distinct_number = 1;
+
+            GenerateArray (source, elem_number, (enum distribution) distribution,
+                           distinct_number);
+
+            /* fixed pivot: median value, placed where PivotFind() takes it */
+            memcpy (sorted, source, elem_number * sizeof (int));
+            RadixSort (sorted, elem_number);
+            const int pivot_elem = sorted[elem_number / 2];
+
+            for (size_t i = 0; i < elem_number; ++i)
+            {
+                if (source[i] == pivot_elem)
+                {
+                    source[i]           = source[pivot_index];
+                    source[pivot_index] = pivot_elem;
+                    break;
+                }
+            }
+
+            for (size_t kernel = 0;
+                 kernel < sizeof (partition_kernels) / sizeof (partition_kernels[0]);
+                 ++kernel)
+            {
+                if (CpuDispatchForce (partition_kernels[kernel].variant) != CPU_DISPATCH_SUCCESS)
+                    continue;
+
+                double    total_time   = 0;
+                long long total_misses = 0;
+
+                for (size_t rep = 0; rep < repetitions; ++rep)
+                {
+                    memcpy (array, source, elem_number * sizeof (int));
+
+                    if (counter >= 0)
+                    {
+                        ioctl (counter, PERF_EVENT_IOC_RESET,  0);
+                        ioctl (counter, PERF_EVENT_IOC_ENABLE, 0);
+                    }
+
+                    const double begin = GetWallTime ();
+                    partition_kernels[kernel].run (array, elem_number, pivot_elem, buffer);
+                    const double end   = GetWallTime ();
+
+                    if (counter >= 0)
+                    {
+                        ioctl (counter, PERF_EVENT_IOC_DISABLE, 0);
+
+                        long long misses = 0;
+                        if (read (counter, &misses, sizeof (misses)) == sizeof (misses))
+                            total_misses += misses;
+                    }
+
+                    total_time += end - begin;
+                }
+
+                const double elem_total = (double) elem_number * (double) repetitions;
+
+                printf ("%s %s %zu %.3lf %.4lf\n",
+                        partition_kernels[kernel].name, distribution_names[distribution],
+                        distinct_number, total_time * 1e9 / elem_total,
+                        (counter >= 0) ? (double) total_misses / elem_total : -1.0);
+            }
+        }
+    }
+
+    CpuDispatchInit ();
+
+    if (counter >= 0) close (counter);
+
+    free (source);
+    free (sorted);
+    free (array);
+    free (buffer);
+
+    return 0;
+}
+
+static void
+RunLomuto (int* const   array,
+           const size_t elem_number,
+           const int    pivot_elem,
+           int* const   buffer)
+{
+    (void) pivot_elem;
+    (void) buffer;
+
+    LomutoPartition (array, 0, elem_number - 1);
+}
+
+static void
+RunHoare (int* const   array,
+          const size_t elem_number,
+          const int    pivot_elem,
+          int* const   buffer)
+{
+    (void) pivot_elem;
+    (void) buffer;
+
+    HoarePartition (array, 0, elem_number - 1);
+}
+
+static void
+RunThick (int* const   array,
+          const size_t elem_number,
+          const int    pivot_elem,
+          int* const   buffer)
+{
+    (void) pivot_elem;
+    (void) buffer;
+
+    size_t equals_from = 0;
+    size_t equals_to   = 0;
+
+    ThickPartition (array, 0, elem_number - 1, &equals_from, &equals_to);
+}
+
+static void
+RunBentleyMcIlroy (int* const   array,
+                   const size_t elem_number,
+                   const int    pivot_elem,
+                   int* const   buffer)
+{
+    (void) pivot_elem;
+    (void) buffer;
+
+    size_t less_end      = 0;
+    size_t greater_begin = 0;
+
+    BentleyMcIlroyPartition (array, 0, elem_number - 1, &less_end, &greater_begin);
+}
+
+/**
+ * @details Out of place kernel bound by CpuDispatchForce(),
+ * time doesn't include copying back.
+ */
+static void
+RunKernel (int* const   array,
+           const size_t elem_number,
+           const int    pivot_elem,
+           int* const   buffer)
+{
+    sort_kernels.partition (array, elem_number, pivot_elem, buffer);
+}
+
+/**
+ * @brief Values in [0, distinct_number), random or monotone.
+ */
+static void
+GenerateArray (int* const              array,
+               const size_t            elem_number,
+               const enum distribution distribution,
+               const size_t            distinct_number)
+{
+    assert (array);
+    assert (distinct_number > 0);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        switch (distribution)
+        {
+            case DISTRIBUTION_RANDOM:
+                array[i] = (int) (BenchRandom () % distinct_number);
+                break;
+
+            case DISTRIBUTION_SORTED:
+                array[i] = (int) ((unsigned __int128) i * distinct_number / elem_number);
+                break;
+
+            case DISTRIBUTION_REVERSED:
+                array[i] = (int) ((unsigned __int128) (elem_number - 1 - i) *
+                                  distinct_number / elem_number);
+                break;
+
+            case DISTRIBUTION_NUMBER:
+            default:
+                assert (0);
+        }
+    }
+}
+
+/**
+ * @brief Opens user space branch misses counter of this thread.
+ * @return File descriptor or -1 if perf events are not available.
+ */
+static int
+OpenBranchMissesCounter (void)
+{
+    struct perf_event_attr attr = {};
+
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof (attr);
+    attr.config         = PERF_COUNT_HW_BRANCH_MISSES;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    const long counter = syscall (SYS_perf_event_open, &attr, 0, -1, -1, 0);
+
+    if (counter < 0)
+        fprintf (stderr, "perf events are not available, branch misses are not counted\n");
+
+    return (int) counter;
+}
+
+static double
+GetWallTime (void)
+{
+    struct timespec time = {};
+    clock_gettime (CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief xorshift64*, the same sequence on every run.
+ */
+static uint64_t
+BenchRandom (void)
+{
+    bench_random_state ^= bench_random_state >> 12;
+    bench_random_state ^= bench_random_state << 25;
+    bench_random_state ^= bench_random_state >> 27;
+
+    return bench_random_state * 0x2545F4914F6CDD1DULL;
+}
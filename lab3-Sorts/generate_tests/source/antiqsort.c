@@ -0,0 +1,169 @@
+/**
+ * McIlroy's adversary for quick sorts ("A Killer Adversary for Quicksort").
+ *
+ * Sorts are built with -DSORT_ADVERSARY, so every comparison goes through
+ * AdversaryCompare(). Array being sorted holds element indices, values
+ * of elements are decided lazily: all of them start as "gas" (bigger than
+ * everything else), and a gas element is frozen to the next small "solid"
+ * value only when the sort compares two gas elements. The element that
+ * looks like the pivot candidate stays gas as long as possible,
+ * so the partition is as bad as possible.
+ *
+ * Values recorded after the sort form the killer input for this sort:
+ * the same sort on them (without the adversary) makes the same comparisons.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "../../include/common.h"
+#include "../../include/quadratic.h"
+#include "../../include/heapsort.h"
+#include "../../include/mergesort.h"
+#include "../../include/qsort.h"
+#include "../../include/qsort_optimization.h"
+#include "../../include/pivot.h"
+
+// process name, number of elements and sort name, optional pivot strategy
+const size_t MIN_ARG_NUMBER           = 3;
+
+const size_t ELEM_NUMBER_ARG_INDEX    = 1;
+const size_t SORT_NAME_ARG_INDEX      = 2;
+const size_t PIVOT_STRATEGY_ARG_INDEX = 3;
+
+struct adversary_sort
+{
+    const char* name;
+    void (*sort) (int* const, const size_t);
+};
+
+static void
+HeapSort2 (int* const   array,
+           const size_t elem_number);
+
+static const struct adversary_sort ADVERSARY_SORTS[] =
+{
+    {"lomuto",          QuickLomutoSort},
+    {"hoare",           QuickHoareSort},
+    {"thick",           QuickThickSort},
+    {"bentley_mcilroy", QuickBentleyMcIlroySort},
+    {"hoare_less_rec",  QuickOneRecursionBranchSort},
+    {"merge_rec",       MergeRecursiveSort},
+    {"merge_it",        MergeIterativeSort},
+    {"heap",            HeapSort2},
+    {"insertion",       InsertionSort},
+    {"shell",           ShellSort}
+};
+
+static struct adversary_state
+{
+    int*   values;
+    int    gas;
+    int    solid_number;
+    int    candidate;
+    size_t comparisons;
+} adversary = {};
+
+static int
+AdversaryCompare (const int first,
+                  const int second);
+
+static void
+AdversaryFreeze (const int index);
+
+int main (const int argc, const char** const argv)
+{
+    assert (argc >= (int) MIN_ARG_NUMBER);
+    assert (argv);
+    assert (argv[ELEM_NUMBER_ARG_INDEX]);
+    assert (argv[SORT_NAME_ARG_INDEX]);
+
+    const size_t elem_number =
+        (size_t) atoll (argv[ELEM_NUMBER_ARG_INDEX]);
+    assert (elem_number < (size_t) __INT_MAX__);
+
+    void (*sort) (int* const, const size_t) = NULL;
+
+    for (size_t i = 0; i < sizeof (ADVERSARY_SORTS) / sizeof (ADVERSARY_SORTS[0]); ++i)
+        if (strcmp (argv[SORT_NAME_ARG_INDEX], ADVERSARY_SORTS[i].name) == 0)
+            sort = ADVERSARY_SORTS[i].sort;
+
+    if (sort == NULL)
+    {
+        fprintf (stderr, "antiqsort: unknown sort \"%s\"\n", argv[SORT_NAME_ARG_INDEX]);
+        return 1;
+    }
+
+    if (argc > (int) PIVOT_STRATEGY_ARG_INDEX)
+        PivotSetStrategy ((enum pivot_strategy) atoi (argv[PIVOT_STRATEGY_ARG_INDEX]));
+
+    int* const indices = (int*) calloc (elem_number + 1, sizeof (int));
+    int* const values  = (int*) calloc (elem_number + 1, sizeof (int));
+    assert (indices);
+    assert (values);
+
+    adversary.values       = values;
+    adversary.gas          = (int) elem_number - 1;
+    adversary.solid_number = 0;
+    adversary.candidate    = 0;
+    adversary.comparisons  = 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        indices[i] = (int) i;
+        values [i] = adversary.gas;
+    }
+
+    sort_adversary_compare = AdversaryCompare;
+    sort (indices, elem_number);
+    sort_adversary_compare = NULL;
+
+    fprintf (stderr, "antiqsort: %s, %zd elements, %zd comparisons\n",
+             argv[SORT_NAME_ARG_INDEX], elem_number, adversary.comparisons);
+
+    printf ("%zd\n", elem_number);
+
+    for (size_t i = 0; i < elem_number; ++i)
+        printf ("%d\n", values[i]);
+
+    free (indices);
+    free (values);
+
+    return 0;
+}
+
+static int
+AdversaryCompare (const int first,
+                  const int second)
+{
+    assert (adversary.values);
+
+    adversary.comparisons++;
+
+    const int gas = adversary.gas;
+    int* const values = adversary.values;
+
+    if (values[first] == gas && values[second] == gas)
+    {
+        if (first == adversary.candidate) AdversaryFreeze (first);
+        else                              AdversaryFreeze (second);
+    }
+
+    if      (values[first]  == gas) adversary.candidate = first;
+    else if (values[second] == gas) adversary.candidate = second;
+
+    return (values[first] > values[second]) - (values[first] < values[second]);
+}
+
+static void
+AdversaryFreeze (const int index)
+{
+    adversary.values[index] = adversary.solid_number++;
+}
+
+static void
+HeapSort2 (int* const   array,
+           const size_t elem_number)
+{
+    HeapSort (array, elem_number, K_2);
+}
@@ -1,13 +1,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
 #include <time.h>
+#include <math.h>
 
-// process name, number of elements and max possible value
+// process name, number of elements and max possible value,
+// optional pattern: random (default), sorted, reversed, organ_pipe,
+// or skewed: exponential, power
 const size_t MIN_ARG_NUMBER           = 3;
 
 const size_t ELEM_NUMBER_ARG_INDEX    = 1;
 const size_t MAX_POSSIBLE_VALUE_INDEX = 2;
+const size_t PATTERN_ARG_INDEX        = 3;
+
+// mean of exponential pattern is max_value / EXPONENTIAL_MEAN_DIVISOR
+const double EXPONENTIAL_MEAN_DIVISOR = 16;
+// power pattern is max_value * u^POWER_EXPONENT for uniform u
+const double POWER_EXPONENT           = 4;
+
+/**
+ * @brief Value of i-th element of ascending array from 0 to max_value.
+ */
+static int
+AscendingValue (const size_t i,
+                const size_t elem_number,
+                const int    max_value);
+
+/**
+ * @brief Uniform random value in (0, 1).
+ */
+static double
+UniformValue (void);
 
 int main (const int argc, const char** const argv)
 {
@@ -27,10 +51,74 @@ int main (const int argc, const char** const argv)
     // adding pointer value is kinda random enough
     srand ((size_t)time (NULL) + (size_t) argv);
 
+    const char* const pattern =
+        (argc > (int) PATTERN_ARG_INDEX) ? argv[PATTERN_ARG_INDEX] : "random";
+
     printf ("%zd\n", elem_number);
 
-    for (size_t i = 0; i < elem_number; ++i)
-        printf ("%d\n", rand() / (RAND_MAX / (max_value + 1) + 1));
+    if (strcmp (pattern, "sorted") == 0)
+    {
+        for (size_t i = 0; i < elem_number; ++i)
+            printf ("%d\n", AscendingValue (i, elem_number, max_value));
+    }
+
+    else if (strcmp (pattern, "reversed") == 0)
+    {
+        for (size_t i = 0; i < elem_number; ++i)
+            printf ("%d\n", AscendingValue (elem_number - 1 - i, elem_number, max_value));
+    }
+
+    // ascending first half, then descending second half
+    else if (strcmp (pattern, "organ_pipe") == 0)
+    {
+        const size_t half = (elem_number + 1) / 2;
+
+        for (size_t i = 0; i < elem_number; ++i)
+            printf ("%d\n", AscendingValue (i < half ? i : elem_number - 1 - i,
+                                            half, max_value));
+    }
+
+    // most values are small, long tail up to max_value
+    else if (strcmp (pattern, "exponential") == 0)
+    {
+        const double mean = max_value / EXPONENTIAL_MEAN_DIVISOR;
+
+        for (size_t i = 0; i < elem_number; ++i)
+        {
+            const double value = -log (UniformValue ()) * mean;
+            printf ("%d\n", (value < max_value) ? (int) value : max_value);
+        }
+    }
+
+    else if (strcmp (pattern, "power") == 0)
+    {
+        for (size_t i = 0; i < elem_number; ++i)
+            printf ("%d\n", (int) (pow (UniformValue (), POWER_EXPONENT) * max_value));
+    }
+
+    else
+    {
+        assert (strcmp (pattern, "random") == 0);
+
+        for (size_t i = 0; i < elem_number; ++i)
+            printf ("%d\n", rand() / (RAND_MAX / (max_value + 1) + 1));
+    }
 
     return 0;
 }
+
+static int
+AscendingValue (const size_t i,
+                const size_t elem_number,
+                const int    max_value)
+{
+    assert (i < elem_number);
+
+    return (int) ((long long) i * max_value / (long long) elem_number);
+}
+
+static double
+UniformValue (void)
+{
+    return ((double) rand () + 1) / ((double) RAND_MAX + 2);
+}
@@ -0,0 +1,53 @@
+#ifndef BANDWIDTH_H
+#define BANDWIDTH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <assert.h>
+
+/**
+ * @brief Sustainable memory bandwidth measured by STREAM-like kernels,
+ * bytes per second, best of several repetitions.
+ * @details Kernels on arrays of doubles much bigger than caches:
+ * copy a = b, scale a = q * b, add a = b + c, triad a = b + q * c.
+ * Bytes are counted as in STREAM: every read and every written element,
+ * write allocate traffic is not counted.
+ */
+struct memory_bandwidth
+{
+    double copy;
+    double scale;
+    double add;
+    double triad;
+    double peak;    ///< Max of the kernels, denominator of fraction of peak.
+};
+
+/**
+ * @brief Bandwidth of this machine, measured on the first call (about 0.5 s)
+ * and printed to stderr, later calls return the same measurement.
+ * @return Pointer to measurement, peak is 0 if arrays can't be allocated.
+ */
+const struct memory_bandwidth*
+MemoryBandwidth (void);
+
+/**
+ * @brief Prints roofline columns of one sort run: elements per second and,
+ * with SORT_STATS, memory traffic, GB/s and fraction of peak bandwidth.
+ * @details Traffic is counted as in STREAM, reads plus writes: every counted
+ * comparison reads two elements, every moved or swapped byte is read
+ * and written. Without SORT_STATS the traffic of a sort is unknown,
+ * so only elements per second are printed.
+ * @param output File to print to.
+ * @param elem_number Number of sorted elements.
+ * @param elem_size Size of one compared element in bytes.
+ * @param seconds Time of the run.
+ */
+void
+RooflinePrint (FILE* const  output,
+               const size_t elem_number,
+               const size_t elem_size,
+               const double seconds);
+
+#endif /* BANDWIDTH_H */
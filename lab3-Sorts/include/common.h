@@ -2,6 +2,8 @@
 #define COMMON_H
 
 #include <assert.h>
+#include <stddef.h>
+#include "sort_stats.h"
 
 enum int_compare
 {
@@ -10,6 +12,40 @@ enum int_compare
     GREATER =  1
 };
 
+#ifdef SORT_ADVERSARY
+
+/**
+ * @brief Comparator that replaces int comparisons in all sorts.
+ * @details Only compiled with SORT_ADVERSARY (see generate_tests/source/antiqsort.c).
+ * Must return negative, zero or positive value like int_cmp().
+ * If NULL, values are compared as usual.
+ */
+extern int (*sort_adversary_compare) (const int, const int);
+
+#define INT_COMPARE(a, b)                                           \
+    (sort_adversary_compare ? sort_adversary_compare ((a), (b)) :   \
+                              ((a) > (b)) - ((a) < (b)))
+
+#define INT_LESS(a, b)          (SORT_STATS_COMPARE (), INT_COMPARE (a, b) <  0)
+#define INT_LESS_EQUAL(a, b)    (SORT_STATS_COMPARE (), INT_COMPARE (a, b) <= 0)
+#define INT_GREATER(a, b)       (SORT_STATS_COMPARE (), INT_COMPARE (a, b) >  0)
+#define INT_GREATER_EQUAL(a, b) (SORT_STATS_COMPARE (), INT_COMPARE (a, b) >= 0)
+#define INT_EQUAL(a, b)         (SORT_STATS_COMPARE (), INT_COMPARE (a, b) == 0)
+
+#else
+
+/**
+ * Comparisons of int elements in sorts. Every comparison is counted
+ * in sort_stats_counters if SORT_STATS is defined.
+ */
+#define INT_LESS(a, b)          (SORT_STATS_COMPARE (), (a) <  (b))
+#define INT_LESS_EQUAL(a, b)    (SORT_STATS_COMPARE (), (a) <= (b))
+#define INT_GREATER(a, b)       (SORT_STATS_COMPARE (), (a) >  (b))
+#define INT_GREATER_EQUAL(a, b) (SORT_STATS_COMPARE (), (a) >= (b))
+#define INT_EQUAL(a, b)         (SORT_STATS_COMPARE (), (a) == (b))
+
+#endif /* SORT_ADVERSARY */
+
 int 
 int_cmp (void* elem1,
          void* elem2);
@@ -17,4 +53,16 @@ int_cmp (void* elem1,
 void
 int_swap (int* first, int* second);
 
+/**
+ * @brief Number of threads for a parallel sort.
+ * @details Online CPUs, but not more than max_threads and not so many
+ * that a thread gets less than min_thread_elem of elem_number elements.
+ * Zero min_thread_elem means no limit by size, at least one thread then.
+ * @return Number of threads, 0 or 1 means the sort runs in one thread.
+ */
+size_t
+SortThreadNumber (const size_t max_threads,
+                  const size_t elem_number,
+                  const size_t min_thread_elem);
+
 #endif /* COMMON_H */
\ No newline at end of file
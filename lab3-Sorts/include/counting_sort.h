@@ -0,0 +1,26 @@
+#ifndef COUNTING_SORT_H
+#define COUNTING_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "common.h"
+#include "qsort.h"
+#include "cpu_dispatch.h"
+
+/**
+ * @brief Sorts array with counting sort if its values range is small.
+ * @details One pass finds min and max values (SIMD minmax kernel). If max - min is small enough
+ * compared to elem_number and the histogram fits in cache, array is sorted
+ * with two more linear passes (count and write back). For big arrays
+ * histograms are counted and merged by several threads.
+ * Otherwise falls back to QuickHoareSort().
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+CountingSort (int* const   array,
+              const size_t elem_number);
+
+#endif /* COUNTING_SORT_H */
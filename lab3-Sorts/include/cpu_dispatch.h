@@ -0,0 +1,136 @@
+#ifndef CPU_DISPATCH_H
+#define CPU_DISPATCH_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <assert.h>
+
+/**
+ * @brief Instruction set variants of SIMD kernels.
+ * @details Only kernels are compiled for these instruction sets (with target
+ * attributes), the rest of the program is compiled without -m flags,
+ * so one binary runs on any x86-64 machine.
+ */
+enum cpu_variant
+{
+    CPU_VARIANT_GENERIC = 0,    ///< Plain C, no SIMD intrinsics.
+    CPU_VARIANT_SSE42   = 1,    ///< SSE4.2, 4 ints per vector.
+    CPU_VARIANT_AVX2    = 2,    ///< AVX2, 8 ints per vector.
+    CPU_VARIANT_AVX512  = 3,    ///< AVX-512F, 16 ints per vector.
+
+    CPU_VARIANT_NUMBER
+};
+
+/**
+ * @brief Error status for functions' return type.
+ */
+enum cpu_dispatch_error_status
+{
+    CPU_DISPATCH_SUCCESS = 0,   ///< No errors occured, succes
+    CPU_DISPATCH_ERROR   = 1    ///< Some error occured
+};
+
+typedef int cpu_dispatch_error_t;
+
+/**
+ * @brief Finds min and max values of nonempty array.
+ */
+typedef void
+(*minmax_kernel_t) (const int* const array,
+                    const size_t     elem_number,
+                    int* const       min_value,
+                    int* const       max_value);
+
+/**
+ * @brief Number of elements less than value. Used by searches:
+ * for sorted array it is the lower bound index.
+ */
+typedef size_t
+(*count_less_kernel_t) (const int* const array,
+                        const size_t     elem_number,
+                        const int        value);
+
+/**
+ * @brief Out of place partition: elements less than pivot are written
+ * to the beginning of dest, others to the end of dest in any order.
+ * @return Number of elements less than pivot.
+ */
+typedef size_t
+(*partition_kernel_t) (const int* const src,
+                       const size_t     elem_number,
+                       const int        pivot,
+                       int* const       dest);
+
+/**
+ * @brief Merges two sorted arrays into dest.
+ */
+typedef void
+(*merge_kernel_t) (const int* const first,
+                   const size_t     first_size,
+                   const int* const second,
+                   const size_t     second_size,
+                   int* const       dest);
+
+/**
+ * @brief Sorts array of at most 16 elements.
+ */
+typedef void
+(*network_sort_kernel_t) (int* const   array,
+                          const size_t elem_number);
+
+/**
+ * @brief Kernels bound to the best variant supported by CPU.
+ */
+struct sort_kernels
+{
+    minmax_kernel_t       minmax;
+    count_less_kernel_t   count_less;
+    partition_kernel_t    partition;
+    merge_kernel_t        merge;
+    network_sort_kernel_t network_sort;
+};
+
+/* Max array size for network_sort kernel */
+#define SORT_KERNELS_NETWORK_MAX_SIZE 16
+
+/**
+ * @brief Kernels to call. Bound at program start by CpuDispatchInit().
+ */
+extern struct sort_kernels sort_kernels;
+
+/**
+ * @brief Detects CPU features (cpuid) and binds kernels to the best variant.
+ * @details Called automatically before main(). If SORT_CPU_VARIANT environment
+ * variable is set to generic, sse4.2, avx2 or avx512, this variant is used
+ * instead, if CPU supports it.
+ */
+void
+CpuDispatchInit (void);
+
+/**
+ * @brief Binds kernels to given variant, for A/B comparisons.
+ * @warning Must not be called while other threads use kernels.
+ * @return Error status, kernels are not changed if CPU doesn't support variant.
+ */
+cpu_dispatch_error_t
+CpuDispatchForce (const enum cpu_variant variant);
+
+/**
+ * @brief Whether CPU supports variant.
+ */
+bool
+CpuDispatchSupported (const enum cpu_variant variant);
+
+/**
+ * @brief Variant the kernels are bound to.
+ */
+enum cpu_variant
+CpuDispatchVariant (void);
+
+/**
+ * @brief Name of variant for benchmark output: generic, sse4.2, avx2 or avx512.
+ */
+const char*
+CpuDispatchVariantName (const enum cpu_variant variant);
+
+#endif /* CPU_DISPATCH_H */
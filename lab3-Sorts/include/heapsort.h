@@ -2,6 +2,7 @@
 #define HEAP_SORT_H
 
 #include "../lib/include/k_heap.h"
+#include "../lib/include/k_heap_typed.h"
 #include <limits.h>
 #include "common.h"
 
@@ -14,9 +15,24 @@ enum heap_k_value
     K_6 = 6
 };
 
+/**
+ * @brief Heap sort with k-ary max-heap.
+ * @details Arities of enum heap_k_value use K_HEAP_TYPED_DEFINE() heaps
+ * with inlined int comparison and hole-based sifts, other arities use
+ * generic struct k_heap. With SORT_STATS the generic heap counts swaps,
+ * writes and recursion depth of its sift down, typed heaps count every
+ * write into the hole as a move and, sifting in loops, have no depth.
+ */
 void
 HeapSort (int* const   array,
           const size_t elem_number,
           const size_t heap_k_value);
 
+/**
+ * @brief HeapSort() with binary heap, for tests taking sorts of two arguments.
+ */
+void
+TwoHeapSort (int* const   array,
+             const size_t elem_number);
+
 #endif
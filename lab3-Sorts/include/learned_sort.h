@@ -0,0 +1,29 @@
+#ifndef LEARNED_SORT_H
+#define LEARNED_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "qsort.h"
+#include "radix_sort.h"
+#include "cpu_dispatch.h"
+
+/**
+ * @brief Learned sort: elements are scattered by a model of their CDF.
+ * @details A sample of about 1% of array (at least 1024 elements) is sorted,
+ * its 256 quantiles are knots of a piecewise-linear CDF model. Every element's
+ * position is predicted by the model, elements are scattered into buckets
+ * of about 32 expected elements by predicted position. The model is monotone,
+ * so buckets are ordered and every bucket is sorted on its own: by network_sort
+ * kernel, insertion sort or QuickHoareSort() if it got too many elements
+ * (many duplicates or the model failed). Small arrays are sorted with QuickHoareSort(),
+ * so is the array if memory can't be allocated.
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+LearnedSort (int* const   array,
+             const size_t elem_number);
+
+#endif /* LEARNED_SORT_H */
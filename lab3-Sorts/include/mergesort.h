@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <assert.h>
+#include "common.h"
 
 void
 MergeRecursiveSort (int* const   array,
@@ -13,4 +14,16 @@ void
 MergeIterativeSort (int* const   array,
                     const size_t elem_number);
 
+/**
+ * @brief Merges two sorted arrays into dest.
+ * @warning dest must not overlap first and second arrays
+ * and must have place for first_size + second_size elements.
+ */
+void
+MergeSortedArrays (const int* const first,
+                   const size_t     first_size,
+                   const int* const second,
+                   const size_t     second_size,
+                   int* const       dest);
+
 #endif /* MERGE_SORT_H */
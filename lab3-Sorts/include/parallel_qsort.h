@@ -0,0 +1,30 @@
+#ifndef PARALLEL_QSORT_H
+#define PARALLEL_QSORT_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include "../lib/include/task_scheduler.h"
+#include "qsort.h"
+
+/**
+ * @brief Quick sort with Hoare partition, parts are sorted in parallel
+ * by work-stealing scheduler.
+ * @details Bigger part of every partition is spawned as a task,
+ * smaller part is partitioned further by the same worker. Parts smaller than 1 << 14 elements
+ * are sorted by QuickHoareSort(). Uses TaskSchedulerDefault().
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+ParallelQuickSort (int* const   array,
+                   const size_t elem_number);
+
+/**
+ * @brief ParallelQuickSort() on given scheduler.
+ */
+void
+ParallelQuickSortWithScheduler (struct task_scheduler* const scheduler,
+                                int* const                   array,
+                                const size_t                 elem_number);
+
+#endif /* PARALLEL_QSORT_H */
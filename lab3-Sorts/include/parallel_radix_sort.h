@@ -0,0 +1,37 @@
+#ifndef PARALLEL_RADIX_SORT_H
+#define PARALLEL_RADIX_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "../lib/include/task_scheduler.h"
+#include "radix_sort.h"
+
+/**
+ * @brief LSD radix sort by bytes, every pass is split between workers.
+ * @details Array is cut into one block per worker. Every block task counts
+ * its own digit histogram, prefix sum over (digit, block) pairs gives every
+ * block its own scatter offset of every digit, so blocks scatter without
+ * synchronization and the sort stays stable. Scatter goes through
+ * write-combining buffers of one cache line per digit: elements are
+ * collected in the buffer and written out by whole aligned cache lines.
+ * Passes where all elements have the same byte are skipped like in
+ * RadixSort(). Arrays smaller than 1 << 16 elements are sorted by RadixSort(),
+ * it is also the fallback if memory can't be allocated. Uses TaskSchedulerDefault().
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+ParallelRadixSort (int* const   array,
+                   const size_t elem_number);
+
+/**
+ * @brief ParallelRadixSort() on given scheduler.
+ */
+void
+ParallelRadixSortWithScheduler (struct task_scheduler* const scheduler,
+                                int* const                   array,
+                                const size_t                 elem_number);
+
+#endif /* PARALLEL_RADIX_SORT_H */
@@ -0,0 +1,57 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <stdlib.h>
+#include <assert.h>
+#include "common.h"
+#include "pivot.h"
+
+/**
+ * Partitions of quick sorts in qsort.c. All of them take pivot from PivotFind(),
+ * so pivot can be fixed with PIVOT_MIDDLE strategy and pivot value put
+ * in the middle of the range (see bench/partition_bench.c).
+ */
+
+/**
+ * @brief Lomuto partition of [left_index, right_index].
+ * @return Final index of pivot, left of it are less elements.
+ */
+size_t
+LomutoPartition (int* const   array,
+                 const size_t left_index,
+                 const size_t right_index);
+
+/**
+ * @brief Hoare partition of [left_index, right_index].
+ * @return Index j: [left_index, j] <= pivot <= (j, right_index].
+ */
+size_t
+HoarePartition (int* const   array,
+                const size_t left_index,
+                const size_t right_index);
+
+/**
+ * @brief Dutch flag partition of [left_index, right_index] into
+ * less, equal and greater parts.
+ * @details [equals_from, equals_to] are equal to pivot.
+ */
+void
+ThickPartition (int* const   array,
+                size_t left_index,
+                size_t right_index,
+                size_t* const equals_from,
+                size_t* const equals_to);
+
+/**
+ * @brief Bentley-McIlroy 3-way partition of [left_index, right_index].
+ * @details [left_index, less_end) are less than pivot,
+ * [greater_begin, right_index] are greater, the rest are equal.
+ */
+void
+BentleyMcIlroyPartition (int* const   array,
+                         const size_t left_index,
+                         const size_t right_index,
+                         size_t* const less_end,
+                         size_t* const greater_begin);
+
+#endif /* PARTITION_H */
@@ -0,0 +1,84 @@
+#ifndef PIVOT_H
+#define PIVOT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "common.h"
+
+/**
+ * @brief Pivot selection strategies for quick sorts.
+ */
+enum pivot_strategy
+{
+    PIVOT_MIDDLE          = 0,  ///< Middle element of the range.
+    PIVOT_MEDIAN_3        = 1,  ///< Median of first, middle and last elements.
+    PIVOT_RANDOM_MEDIAN_3 = 2,  ///< Median of three random elements.
+    PIVOT_NINTHER         = 3,  ///< Tukey's ninther: median of three medians of three.
+    PIVOT_SAMPLE_MEDIAN   = 4   ///< Median of sqrt(n) evenly spaced elements.
+};
+
+/**
+ * @brief Sets strategy used by PivotFind() in all quick sorts.
+ * Default strategy is PIVOT_MIDDLE.
+ * @param strategy New pivot strategy.
+ */
+void
+PivotSetStrategy (const enum pivot_strategy strategy);
+
+enum pivot_strategy
+PivotGetStrategy (void);
+
+/**
+ * @brief Finds pivot index in [left_index, right_index]
+ * with the current strategy.
+ * @details PIVOT_SAMPLE_MEDIAN moves its sample to the beginning
+ * of the range, other strategies don't change the array.
+ * @return Index of pivot element.
+ */
+size_t
+PivotFind (int* const   array,
+           const size_t left_index,
+           const size_t right_index);
+
+size_t
+PivotMiddle (int* const   array,
+             const size_t left_index,
+             const size_t right_index);
+
+size_t
+PivotMedian3 (int* const   array,
+              const size_t left_index,
+              const size_t right_index);
+
+size_t
+PivotRandomMedian3 (int* const   array,
+                    const size_t left_index,
+                    const size_t right_index);
+
+/**
+ * @brief Tukey's ninther. Falls back to PivotMedian3() for small ranges.
+ */
+size_t
+PivotNinther (int* const   array,
+              const size_t left_index,
+              const size_t right_index);
+
+/**
+ * @brief Median of sqrt(n) evenly spaced elements, found with quickselect.
+ * Falls back to PivotNinther() for small ranges.
+ */
+size_t
+PivotSampleMedian (int* const   array,
+                   const size_t left_index,
+                   const size_t right_index);
+
+/**
+ * @brief Fast xorshift64* generator with a separate state for each thread.
+ * @return Random 64-bit value.
+ */
+uint64_t
+PivotRandom (void);
+
+#endif /* PIVOT_H */
@@ -2,8 +2,11 @@
 #define QSORT_H
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include <assert.h>
 #include "common.h"
+#include "pivot.h"
+#include "partition.h"
 
 void
 QuickLomutoSort (int* const   array,
@@ -17,4 +20,15 @@ void
 QuickThickSort (int* const   array,
                 const size_t elem_number);
 
+/**
+ * @brief Quick sort with Bentley-McIlroy 3-way partition.
+ * @details Keys equal to pivot are swapped to the ends of the range
+ * during Hoare-style scan and then moved to the middle in bulk,
+ * so equal keys are excluded from recursion without a swap
+ * for every element.
+ */
+void
+QuickBentleyMcIlroySort (int* const   array,
+                         const size_t elem_number);
+
 #endif /* QSORT_H */
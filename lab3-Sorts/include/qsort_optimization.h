@@ -1,10 +1,27 @@
 #ifndef QSORT_OPTIMIZATION_H
 #define QSORT_OPTIMIZATION_H
 
+#include <string.h>
+#include <limits.h>
 #include "qsort.h"
+#include "cpu_dispatch.h"
 
 void
 QuickOneRecursionBranchSort (int* const   array,
                              const size_t elem_number);
 
+/**
+ * @brief Quick sort built on SIMD kernels of cpu_dispatch.h.
+ * @details Every range is partitioned out of place by partition kernel
+ * into a buffer and copied back, ranges up to 16 elements are sorted
+ * by network_sort kernel. If there is no element less than pivot,
+ * elements equal to it are split off and are not sorted again.
+ * Falls back to QuickHoareSort() if buffer can't be allocated.
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+QuickKernelSort (int* const   array,
+                 const size_t elem_number);
+
 #endif /* QSORT_OPTIMIZATION_H */
\ No newline at end of file
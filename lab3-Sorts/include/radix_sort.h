@@ -0,0 +1,32 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief LSD radix sort by bytes.
+ * @details All four byte histograms are counted in one pass, then every
+ * byte is scattered to a buffer and back. Passes where all elements
+ * have the same byte are skipped. Sign bit is flipped in keys, so
+ * negative values go first. Falls back to QuickHoareSort() if the
+ * buffer can't be allocated.
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ */
+void
+RadixSort (int* const   array,
+           const size_t elem_number);
+
+/**
+ * @brief RadixSort() with a caller's buffer of at least elem_number elements.
+ * @details For sorting a lot of small arrays without allocation per call.
+ */
+void
+RadixSortWithBuffer (int* const   array,
+                     const size_t elem_number,
+                     int* const   buffer);
+
+#endif /* RADIX_SORT_H */
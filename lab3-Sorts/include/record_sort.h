@@ -0,0 +1,87 @@
+#ifndef RECORD_SORT_H
+#define RECORD_SORT_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+/**
+ * @brief Error status for functions' return type.
+ */
+enum record_sort_error_status
+{
+    RECORD_SORT_SUCCESS = 0,    ///< No errors occured, succes
+    RECORD_SORT_ERROR   = 1     ///< Some error occured
+};
+
+/**
+ * @brief Return type for functions with record_sort_error_status values.
+ */
+typedef int record_sort_error_t;
+
+/**
+ * @brief Type of record field used as a key.
+ */
+enum record_key_type
+{
+    RECORD_KEY_INT    = 0,      ///< int field.
+    RECORD_KEY_STRING = 1       ///< const char* field, null-terminated string.
+};
+
+enum record_key_order
+{
+    RECORD_KEY_ASCENDING  = 0,
+    RECORD_KEY_DESCENDING = 1
+};
+
+/**
+ * @brief One column of composite key.
+ */
+struct record_key
+{
+    enum record_key_type  type;
+    enum record_key_order order;
+    size_t                offset;       ///< offsetof () of the field in record.
+    size_t                prefix_len;   ///< Bytes of string in normalized key, unused for ints.
+};
+
+/**
+ * @brief Sorts records by composite key, columns compared in given order.
+ * @details Every record's key is normalized to fixed-width bytes,
+ * so that memcmp () of normalized keys gives key order: ints are stored
+ * big-endian with flipped sign bit, strings are truncated to prefix_len
+ * and padded with zeros, descending columns have all bytes inverted.
+ * Normalized key ends with the first string column: strings equal in
+ * prefix may differ after it, so the columns after it are not used.
+ * Indices of records are sorted by MSD radix sort of normalized keys,
+ * small buckets by insertion sort with memcmp (). Only records with
+ * equal normalized keys are compared by the full comparator, and only
+ * if there is a string column.
+ * Finally records are permuted by sorted indices. Sort is not stable.
+ * @param records Pointer to array of records.
+ * @param record_number Number of records.
+ * @param record_size Size of one record in bytes.
+ * @param keys Columns of composite key, the first is the most significant.
+ * @param key_number Number of columns.
+ * @return Error status, records are not changed on error.
+ */
+record_sort_error_t
+RecordSort (void* const                    records,
+            const size_t                   record_number,
+            const size_t                   record_size,
+            const struct record_key* const keys,
+            const size_t                   key_number);
+
+/**
+ * @brief Full comparator of two records by composite key, like in qsort ().
+ */
+int
+RecordCompare (const void* const              first,
+               const void* const              second,
+               const struct record_key* const keys,
+               const size_t                   key_number);
+
+#endif /* RECORD_SORT_H */
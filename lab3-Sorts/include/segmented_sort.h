@@ -0,0 +1,39 @@
+#ifndef SEGMENTED_SORT_H
+#define SEGMENTED_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "common.h"
+#include "radix_sort.h"
+#include "cpu_dispatch.h"
+
+/**
+ * @brief Sorts every segment of array independently.
+ * @details Segment i is [offsets[i], offsets[i + 1]), so offsets holds
+ * segment_number + 1 nondecreasing values. Segments up to 16 elements
+ * are sorted by branchless sorting networks, up to 64 by networks on
+ * blocks of 16 and merge kernel, bigger ones by RadixSortWithBuffer().
+ * If there are enough elements, segments are split between several
+ * threads by elements count.
+ * @param array Pointer to flat buffer with all segments.
+ * @param offsets Pointer to segment_number + 1 segment bounds.
+ * @param segment_number Number of segments.
+ */
+void
+SegmentedSort (int* const          array,
+               const size_t* const offsets,
+               const size_t        segment_number);
+
+/**
+ * @brief Sorts array of at most 16 elements with Batcher's sorting network.
+ * @details Generic network_sort kernel of cpu_dispatch.h.
+ * @param array Pointer to array to sort.
+ * @param elem_number Number of elements in array, not greater than 16.
+ */
+void
+NetworkSort (int* const   array,
+             const size_t elem_number);
+
+#endif /* SEGMENTED_SORT_H */
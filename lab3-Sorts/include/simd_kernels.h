@@ -0,0 +1,131 @@
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "mergesort.h"
+
+/**
+ * Kernel variants for cpu_dispatch.h. Each function is compiled for its
+ * instruction set with a target attribute and must only be called
+ * if CPU supports it. Generic merge is MergeSortedArrays(), generic
+ * network sort is NetworkSort() of segmented_sort.h.
+ */
+
+void
+MinMaxGeneric (const int* const array,
+               const size_t     elem_number,
+               int* const       min_value,
+               int* const       max_value);
+
+size_t
+CountLessGeneric (const int* const array,
+                  const size_t     elem_number,
+                  const int        value);
+
+size_t
+PartitionGeneric (const int* const src,
+                  const size_t     elem_number,
+                  const int        pivot,
+                  int* const       dest);
+
+//-----------------------------------------------------------------------------
+// SSE4.2
+//-----------------------------------------------------------------------------
+
+void
+MinMaxSse42 (const int* const array,
+             const size_t     elem_number,
+             int* const       min_value,
+             int* const       max_value);
+
+size_t
+CountLessSse42 (const int* const array,
+                const size_t     elem_number,
+                const int        value);
+
+size_t
+PartitionSse42 (const int* const src,
+                const size_t     elem_number,
+                const int        pivot,
+                int* const       dest);
+
+void
+MergeSse42 (const int* const first,
+            const size_t     first_size,
+            const int* const second,
+            const size_t     second_size,
+            int* const       dest);
+
+void
+NetworkSortSse42 (int* const   array,
+                  const size_t elem_number);
+
+//-----------------------------------------------------------------------------
+// AVX2
+//-----------------------------------------------------------------------------
+
+void
+MinMaxAvx2 (const int* const array,
+            const size_t     elem_number,
+            int* const       min_value,
+            int* const       max_value);
+
+size_t
+CountLessAvx2 (const int* const array,
+               const size_t     elem_number,
+               const int        value);
+
+size_t
+PartitionAvx2 (const int* const src,
+               const size_t     elem_number,
+               const int        pivot,
+               int* const       dest);
+
+void
+MergeAvx2 (const int* const first,
+           const size_t     first_size,
+           const int* const second,
+           const size_t     second_size,
+           int* const       dest);
+
+void
+NetworkSortAvx2 (int* const   array,
+                 const size_t elem_number);
+
+//-----------------------------------------------------------------------------
+// AVX-512
+//-----------------------------------------------------------------------------
+
+void
+MinMaxAvx512 (const int* const array,
+              const size_t     elem_number,
+              int* const       min_value,
+              int* const       max_value);
+
+size_t
+CountLessAvx512 (const int* const array,
+                 const size_t     elem_number,
+                 const int        value);
+
+size_t
+PartitionAvx512 (const int* const src,
+                 const size_t     elem_number,
+                 const int        pivot,
+                 int* const       dest);
+
+void
+MergeAvx512 (const int* const first,
+             const size_t     first_size,
+             const int* const second,
+             const size_t     second_size,
+             int* const       dest);
+
+void
+NetworkSortAvx512 (int* const   array,
+                   const size_t elem_number);
+
+#endif /* SIMD_KERNELS_H */
@@ -0,0 +1,87 @@
+#ifndef SORT_STATS_H
+#define SORT_STATS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Operation counters of one sort run.
+ * @details Counters are updated only if SORT_STATS is defined
+ * (make SORT_STATS=1), otherwise all counting macros are compiled out.
+ * Counters are global and not thread safe, multithreaded sorts
+ * are not instrumented.
+ */
+struct sort_stats
+{
+    size_t comparisons;     ///< Number of element comparisons.
+    size_t swaps;           ///< Number of int_swap() calls.
+    size_t bytes_moved;     ///< Bytes written by swaps and element copies.
+    size_t depth;           ///< Current recursion depth.
+    size_t max_depth;       ///< Max recursion depth during the run.
+};
+
+extern struct sort_stats sort_stats_counters;
+
+/**
+ * Expensive comparisons for benchmarks: with make SORT_CMP_COST=N every
+ * counted comparison also does N iterations of dummy work (SortCompareCost()),
+ * so sorts doing fewer comparisons win as with string or record keys.
+ */
+#ifdef SORT_CMP_COST
+
+void
+SortCompareCost (void);
+
+#define SORT_COMPARE_COST()     SortCompareCost ()
+
+#else
+
+#define SORT_COMPARE_COST()     ((void) 0)
+
+#endif /* SORT_CMP_COST */
+
+#ifdef SORT_STATS
+
+#define SORT_STATS_COMPARE()                                        \
+    ((void) (sort_stats_counters.comparisons++, SORT_COMPARE_COST ()))
+
+#define SORT_STATS_SWAP(bytes)                                      \
+    ((void) (sort_stats_counters.swaps++,                           \
+             sort_stats_counters.bytes_moved += (bytes)))
+
+#define SORT_STATS_MOVE(bytes)                                      \
+    ((void) (sort_stats_counters.bytes_moved += (bytes)))
+
+#define SORT_STATS_ENTER()                                          \
+    ((void) (++sort_stats_counters.depth > sort_stats_counters.max_depth ? \
+             sort_stats_counters.max_depth = sort_stats_counters.depth : 0))
+
+#define SORT_STATS_LEAVE()                                          \
+    ((void) sort_stats_counters.depth--)
+
+#else
+
+#define SORT_STATS_COMPARE()    SORT_COMPARE_COST ()
+#define SORT_STATS_SWAP(bytes)  ((void) 0)
+#define SORT_STATS_MOVE(bytes)  ((void) 0)
+#define SORT_STATS_ENTER()      ((void) 0)
+#define SORT_STATS_LEAVE()      ((void) 0)
+
+#endif /* SORT_STATS */
+
+/**
+ * @brief Sets all counters to zero before a sort run.
+ */
+void
+SortStatsReset (void);
+
+/**
+ * @brief Prints counters as extra columns of test output line:
+ * comparisons, swaps, bytes moved and max recursion depth.
+ * Prints nothing if SORT_STATS is not defined.
+ * @param output File to print to.
+ */
+void
+SortStatsPrint (FILE* const output);
+
+#endif /* SORT_STATS_H */
@@ -0,0 +1,47 @@
+#ifndef SORT_UNIQUE_H
+#define SORT_UNIQUE_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "radix_sort.h"
+
+/**
+ * @brief Distinct key and number of its occurrences.
+ */
+struct key_count
+{
+    int    key;
+    size_t count;
+};
+
+/**
+ * @brief Counts distinct keys of array and sorts them.
+ * @details Keys are counted in an open addressing hash table in one pass,
+ * then only distinct keys are sorted. So for duplicate heavy arrays
+ * it is O(n + d log d) instead of sorting all n elements. If most keys
+ * of the first 2^16 elements are distinct, copy of array is radix sorted
+ * and equal neighbours are counted instead.
+ * @param array Pointer to array, not changed.
+ * @param elem_number Number of elements in array.
+ * @param key_counts Pointer to result, allocated by the function
+ * and must be freed by caller. Sorted by key.
+ * @return Number of distinct keys. 0 and NULL result if array is empty
+ * or memory can't be allocated.
+ */
+size_t
+SortCount (const int* const         array,
+           const size_t             elem_number,
+           struct key_count** const key_counts);
+
+/**
+ * @brief Replaces the beginning of array with its distinct keys in sorted order.
+ * @return Number of distinct keys, elements after them are not specified.
+ */
+size_t
+SortUnique (int* const   array,
+            const size_t elem_number);
+
+#endif /* SORT_UNIQUE_H */
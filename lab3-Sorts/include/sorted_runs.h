@@ -0,0 +1,119 @@
+#ifndef SORTED_RUNS_H
+#define SORTED_RUNS_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "../lib/include/dynamic_array.h"
+#include "mergesort.h"
+#include "cpu_dispatch.h"
+#include "qsort.h"
+
+/* Default number of runs of one level before they are merged */
+extern const size_t SORTED_RUNS_DEFAULT_FAN_OUT;
+
+/**
+ * @brief Error status for functions' return type.
+ */
+enum sorted_runs_error_status
+{
+    SORTED_RUNS_SUCCESS = 0,    ///< No errors occured, succes
+    SORTED_RUNS_ERROR   = 1     ///< Some error occured
+};
+
+/**
+ * @brief Return type for functions with sorted_runs_error_status values.
+ */
+typedef int sorted_runs_error_t;
+
+/**
+ * @brief One sorted array owned by the container.
+ */
+struct sorted_run
+{
+    int*   array;
+    size_t size;
+};
+
+/**
+ * @brief Incrementally sorted container of log-structured sorted runs.
+ * @details Every appended batch is sorted on its own and becomes a new run.
+ * Run level is floor(log_fan_out (size)). Runs are kept from the biggest
+ * to the smallest, when there are fan_out runs at the end with levels
+ * not bigger than the last one, they are merged into one run of a higher
+ * level. Every element is merged O(log n) times in total, so appending
+ * costs amortized O(log n) per element instead of sorting everything again.
+ */
+struct sorted_runs
+{
+    struct dynamic_array* runs;     ///< Runs, struct sorted_run elements.
+    size_t fan_out;                 ///< Number of runs of one level to merge.
+    size_t elem_number;             ///< Number of elements in all runs.
+};
+
+/**
+ * @brief Makes empty container.
+ * @param fan_out Number of runs to merge, at least 2.
+ * @return Pointer to container, NULL if allocation failed.
+ */
+struct sorted_runs*
+SortedRunsConstructor (const size_t fan_out);
+
+/**
+ * @brief Frees all runs and the container.
+ * @return NULL
+ */
+struct sorted_runs*
+SortedRunsDestructor (struct sorted_runs* const runs);
+
+/**
+ * @brief Copies and sorts batch as a new run, merges runs if needed.
+ * @param runs Pointer to container.
+ * @param batch Elements to add, not changed.
+ * @param batch_size Number of elements in batch.
+ * @return Error status. Container is not changed on error.
+ */
+sorted_runs_error_t
+SortedRunsAppend (struct sorted_runs* const runs,
+                  const int* const          batch,
+                  const size_t              batch_size);
+
+/**
+ * @brief Merges all runs into one.
+ * @return Pointer to all elements in sorted order, valid until next append.
+ * NULL if container is empty or merge memory can't be allocated.
+ */
+const int*
+SortedRunsMaterialize (struct sorted_runs* const runs);
+
+/**
+ * @brief Number of elements less than value, i.e. index of the first
+ * element not less than value in the sorted view.
+ * @details Binary search in every run, runs are not merged.
+ */
+size_t
+SortedRunsLowerBound (const struct sorted_runs* const runs,
+                      const int                       value);
+
+/**
+ * @brief Number of runs in container.
+ */
+size_t
+SortedRunsRunNumber (const struct sorted_runs* const runs);
+
+/**
+ * @brief Merges sorted arrays into a new one.
+ * @details Runs are merged in pairs by rounds with merge kernel, two
+ * buffers are used in turn, so every element is copied log2 (run_number)
+ * times. Runs are not changed.
+ * @param runs Sorted arrays to merge.
+ * @param run_number Number of runs, at least 1.
+ * @return Sorted array of all elements allocated by the function, must be
+ * freed by caller. NULL if memory can't be allocated.
+ */
+int*
+SortedRunsMerge (const struct sorted_run* const runs,
+                 const size_t                   run_number);
+
+#endif /* SORTED_RUNS_H */
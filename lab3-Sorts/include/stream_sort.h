@@ -0,0 +1,31 @@
+#ifndef STREAM_SORT_H
+#define STREAM_SORT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "common.h"
+#include "radix_sort.h"
+#include "mergesort.h"
+#include "cpu_dispatch.h"
+#include "sorted_runs.h"
+
+/**
+ * @brief Reads whitespace separated ints from input until EOF and sorts them.
+ * @details '-' right after digits starts the next number, "5-3" is 5 and -3.
+ * Calling thread reads and parses input in fixed size chunks,
+ * every full chunk is given to worker threads that sort it while the next
+ * one is parsed. At EOF sorted chunks are merged by SortedRunsMerge(). So sorting is mostly
+ * hidden behind reading and parsing instead of starting after it.
+ * @param input Opened file to read from, read from its current position.
+ * @param elem_number Pointer to number of read elements.
+ * @return Sorted array allocated by the function, must be freed by caller.
+ * NULL if nothing was read or memory can't be allocated.
+ */
+int*
+StreamSort (FILE* const   input,
+            size_t* const elem_number);
+
+#endif /* STREAM_SORT_H */
@@ -0,0 +1,66 @@
+#ifndef STRING_SORT_H
+#define STRING_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+#include "../lib/include/dynamic_array.h"
+
+/**
+ * @brief String to sort: pointer to its bytes and its length.
+ * @details Strings are compared byte by byte as unsigned chars,
+ * a proper prefix is less than the string. Bytes are not copied,
+ * sorts only move these refs. str may contain '\0' bytes.
+ */
+struct string_ref
+{
+    const char* str;
+    size_t      len;
+};
+
+/**
+ * @brief Compares two strings like memcmp() with shorter prefix being less.
+ * @return Negative, zero or positive value.
+ */
+int
+StringRefCompare (const struct string_ref* const first,
+                  const struct string_ref* const second);
+
+/**
+ * @brief Multikey (3-way radix) quick sort.
+ * @details Partitions strings by one character at a time into <, = and >
+ * parts, only = part goes to the next character, so shared prefixes are
+ * never compared again. Characters of the current depth are cached
+ * in a separate array, partition scans it sequentially instead of
+ * dereferencing every string.
+ * @param strings Array of string refs to sort.
+ * @param string_number Number of strings.
+ */
+void
+MultikeyQuickSort (struct string_ref* const strings,
+                   const size_t             string_number);
+
+/**
+ * @brief Burstsort: distributes strings into buckets of a trie by their
+ * characters, buckets that grow too big burst into a new trie node.
+ * @details Strings are inserted in one pass, then buckets are sorted by
+ * MultikeyQuickSort() from the depth of the bucket and written back
+ * in trie order. Buckets are small enough to stay in cache.
+ * @param strings Array of string refs to sort.
+ * @param string_number Number of strings.
+ */
+void
+BurstSort (struct string_ref* const strings,
+           const size_t             string_number);
+
+/**
+ * @brief Sorts strings with BurstSort() for big arrays
+ * and MultikeyQuickSort() for small ones.
+ */
+void
+StringSort (struct string_ref* const strings,
+            const size_t             string_number);
+
+#endif /* STRING_SORT_H */
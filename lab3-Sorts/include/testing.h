@@ -6,6 +6,19 @@
 #include "mergesort.h"
 #include "qsort.h"
 #include "qsort_optimization.h"
+#include "counting_sort.h"
+#include "string_sort.h"
+#include "segmented_sort.h"
+#include "sorted_runs.h"
+#include "sort_unique.h"
+#include "stream_sort.h"
+#include "cpu_dispatch.h"
+#include "record_sort.h"
+#include "parallel_qsort.h"
+#include "learned_sort.h"
+#include "parallel_radix_sort.h"
+#include "weak_heap_sort.h"
+#include "bandwidth.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,6 +40,12 @@ struct file_input_str
     size_t answer_str_index;
 };
 
+/**
+ * @brief Benchmarks sort on test files of test_folder, checks results by answer files.
+ * @details Output lines are "size time [counters] variant bytes_moved elements_per_sec GB/s
+ * fraction_of_peak", counters are printed with SORT_STATS (see sort_stats.h),
+ * bandwidth columns are described in bandwidth.h.
+ */
 void
 TestSort (const char*  const test_folder,
           const char*  const output_file_name,
@@ -36,6 +55,124 @@ TestSort (const char*  const test_folder,
           const size_t size_tests_num,
           void (*sort) (int* const, size_t));
 
+/**
+ * @brief Benchmarks string sort on generated strings.
+ * @details Strings look like dictionary keys: one of a few common
+ * prefixes and a random lowercase suffix. Result is checked against
+ * qsort() with StringRefCompare(). Output lines are "size time".
+ */
+void
+TestStringSort (const char*  const output_file_name,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num,
+                void (*sort) (struct string_ref* const, const size_t));
+
+/**
+ * @brief Benchmarks SegmentedSort() on random segments.
+ * @details Segment sizes are random in [segment_min_size, segment_max_size],
+ * number of segments goes from "from" to "to". Every segment is checked
+ * against qsort(). Output lines are "segments time segments_per_second".
+ */
+void
+TestSegmentedSort (const char*  const output_file_name,
+                   const size_t segment_min_size,
+                   const size_t segment_max_size,
+                   const size_t from,
+                   const size_t   to,
+                   const size_t step,
+                   const size_t size_tests_num);
+
+/**
+ * @brief Benchmarks appending random batches to sorted_runs container.
+ * @details Batches of batch_size elements are appended until container
+ * has cur_size elements, then sorted view is checked against qsort()
+ * and SortedRunsLowerBound() against it. Only appends are timed.
+ * Output lines are "size time runs_number".
+ */
+void
+TestSortedRuns (const char*  const output_file_name,
+                const size_t fan_out,
+                const size_t batch_size,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num);
+
+/**
+ * @brief Benchmarks SortCount() against sorting all elements and scanning them.
+ * @details Tests are read like in TestSort(), keys and counts are checked
+ * against answer files. Output lines are
+ * "size sort_count_time sort_and_scan_time distinct_keys".
+ */
+void
+TestSortCount (const char*  const test_folder,
+               const char*  const output_file_name,
+               const size_t from,
+               const size_t   to,
+               const size_t step,
+               const size_t size_tests_num);
+
+/**
+ * @brief Benchmarks StreamSort() on test files against reading the whole
+ * file, parsing it and only then sorting with RadixSort().
+ * @details Both times include reading and parsing. Output lines are
+ * "size stream_sort_time read_then_sort_time".
+ */
+void
+TestStreamSort (const char*  const test_folder,
+                const char*  const output_file_name,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num);
+
+/**
+ * @brief Benchmarks RecordSort() on generated records (group ascending,
+ * score descending, name ascending) against qsort () with multi-field comparator.
+ * @details If name_key_last is false, name goes before score, so the
+ * truncated name prefix is followed by another column. Output lines are
+ * "size record_sort_time qsort_time".
+ */
+void
+TestRecordSort (const char*  const output_file_name,
+                const bool         name_key_last,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num);
+
+/**
+ * @brief Benchmarks dynamic_array of ints in given memory mode on push-heavy workload:
+ * cur_size pushes from empty array, then cur_size reads at random indices.
+ * @details Output lines are "size push_time random_read_time memory_mode".
+ */
+void
+TestDynamicArrayPush (const char*  const                  output_file_name,
+                      const enum dynamic_array_memory_mode memory_mode,
+                      const size_t                         from,
+                      const size_t                         to,
+                      const size_t                         step,
+                      const size_t                         size_tests_num);
+
+/**
+ * @brief Tests K_HEAP_TYPED_DEFINE() heaps of arity 2, 3 (min-heap) or 4
+ * against a log of all keys.
+ * @details Every run inserts cur_size random keys, does cur_size / 2 random
+ * DeleteKey(), key changes fixed by SiftUp()/SiftDown() and inserts, checks
+ * heap order, then extracts all keys: they must come in heap order and be
+ * exactly the inserted keys without the removed ones. Output lines are
+ * "size run_time".
+ */
+void
+TestKHeapTyped (const char*  const output_file_name,
+                const size_t arity,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num);
+
 struct file_names*
 FileNamesConstructor (const char* const test_folder);
 
@@ -0,0 +1,45 @@
+#ifndef WEAK_HEAP_SORT_H
+#define WEAK_HEAP_SORT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "common.h"
+
+/**
+ * @brief Comparator like in qsort ().
+ */
+typedef int (*weak_heap_compare_t) (const void* first, const void* second);
+
+/**
+ * @brief Weak-heap sort of elements of any size.
+ * @details Weak heap is a binary tree where every node is not less than
+ * the nodes of its right subtree only, the root has no left subtree.
+ * Reverse bit of a node swaps its children, so joining two weak heaps
+ * is one comparison and a bit flip instead of a sift down. Building
+ * takes n - 1 comparisons, every extraction takes one comparison per
+ * level, so the sort does at most n * log2 (n) - 0.9 * n comparisons
+ * against about 2 * n * log2 (n) of binary heap sort. Takes n bytes
+ * for reverse bits, if they can't be allocated the array is sorted
+ * by binary heap sort in place.
+ * Sort is not stable.
+ * @param base Pointer to array to sort.
+ * @param elem_number Number of elements in array.
+ * @param elem_size Size of one element in bytes.
+ * @param compare Comparator of two elements.
+ */
+void
+WeakHeapSort (void* const               base,
+              const size_t              elem_number,
+              const size_t              elem_size,
+              const weak_heap_compare_t compare);
+
+/**
+ * @brief WeakHeapSort() of int array, comparisons go through int_cmp().
+ */
+void
+WeakHeapIntSort (int* const   array,
+                 const size_t elem_number);
+
+#endif /* WEAK_HEAP_SORT_H */
@@ -15,6 +15,15 @@ extern const size_t DYNAMIC_ARRAY_NULL_SIZE;
 /* Used to fill struct fields when destroyed, or array place after pop. Equals to 0 */
 extern const char   DYNAMIC_ARRAY_POISON_BYTE;
 
+/* Alignment of data_array in DYNAMIC_ARRAY_MEMORY_ALIGNED mode, bytes */
+extern const size_t DYNAMIC_ARRAY_CACHE_LINE_SIZE;
+
+/* Bytes from which DYNAMIC_ARRAY_MEMORY_LARGE mode moves data_array to mmap */
+extern const size_t DYNAMIC_ARRAY_MMAP_THRESHOLD;
+
+/* Bytes from which DYNAMIC_ARRAY_MEMORY_LARGE mode asks for transparent huge pages */
+extern const size_t DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD;
+
 /**
  * @brief Error status for functions' return type.
  */
@@ -48,6 +57,25 @@ enum dynamic_array_save_array
     DYNAMIC_ARRAY_SAVE    = true    ///< Array won't be destroyed and freed.
 };
 
+/**
+ * @brief Where data_array memory comes from.
+ */
+enum dynamic_array_memory_mode
+{
+    DYNAMIC_ARRAY_MEMORY_HEAP    = 0,   ///< calloc () and realloc (), the default.
+    DYNAMIC_ARRAY_MEMORY_ALIGNED = 1,   ///< aligned_alloc () by cache line, growth copies.
+    /**
+     * Heap while data_array is smaller than DYNAMIC_ARRAY_MMAP_THRESHOLD,
+     * then anonymous mmap () grown by mremap () with MREMAP_MAYMOVE, so pages
+     * are remapped instead of copied. From DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD
+     * mapping is madvise ()-d with MADV_HUGEPAGE to use less TLB entries.
+     * Mapped capacity is not poisoned, its fresh pages are zero already
+     * and stay unallocated until elements are written to them.
+     * Can't be used with DYNAMIC_ARRAY_SAVE, data_array is not free ()-able.
+     */
+    DYNAMIC_ARRAY_MEMORY_LARGE   = 2
+};
+
 /**
  * @brief Return type for functions with dynamic_array_error_status values.
  */
@@ -66,6 +94,12 @@ struct dynamic_array
 
     bool enable_realloc;        ///< Enable or disable realloc during push/pop.
     bool save_array;            ///< Save or destroy data_array in DynamicArrayDestructor().
+
+    enum dynamic_array_memory_mode memory_mode;
+    size_t allocated_bytes;     ///< Bytes of data_array allocation, page-rounded if mapped.
+    bool   mapped;              ///< data_array is mmap ()-ed.
+
+    size_t reserved_capacity;   ///< Capacity kept by push/pop, see DynamicArrayReserve().
 };
 
 /**
@@ -82,6 +116,18 @@ DynamicArrayConstructor  (const size_t initial_data_array_capaity,
                           const bool enable_realloc,
                           const bool save_array);
 
+/**
+ * @brief DynamicArrayConstructor() with given memory mode.
+ * @return Struct with filled fields, NULL on error or if
+ * DYNAMIC_ARRAY_MEMORY_LARGE is used with DYNAMIC_ARRAY_SAVE.
+ */
+struct dynamic_array*
+DynamicArrayConstructorMode (const size_t                         initial_data_array_capacity,
+                             const size_t                         elem_size,
+                             const bool                           enable_realloc,
+                             const bool                           save_array,
+                             const enum dynamic_array_memory_mode memory_mode);
+
 /**
  * @brief Destroys the struct and clear its fields.
  * If save_array field is set to DYNAMIC_ARRAY_SAVE, doesn't destroy
@@ -102,7 +148,8 @@ dynamic_array_error_t
 DynamicArrayReallocCheck (struct dynamic_array* const d_array);
 
 /**
- * @brief Reallocs data_array field up and down.
+ * @brief Reallocs data_array field up and down to data_array_capacity elements
+ * the way memory_mode says.
  * @param d_array Pointer to dynamic array struct.
  * @return Error status.
  */
@@ -139,4 +186,58 @@ void*
 DynamicArrayGetElemPtrByIndex (struct dynamic_array* const d_array,
                                const  size_t elem_index);
 
+/**
+ * @brief Reserves place for at least capacity elements.
+ * Reallocs once if data_array_capacity is smaller. Push/pop don't shrink
+ * the array below reserved capacity until DynamicArrayShrinkToFit().
+ * @param d_array Pointer to dynamic array struct.
+ * @param capacity Number of elements to reserve place for.
+ * @return Error status, error if realloc is needed but disabled.
+ */
+dynamic_array_error_t
+DynamicArrayReserve      (struct dynamic_array* const d_array,
+                          const  size_t               capacity);
+
+/**
+ * @brief Pushes elem_number elements from push_buffer in the end of the array.
+ * Reallocs at most once, then copies all elements with one memcpy ().
+ * @param d_array Pointer to dynamic array struct.
+ * @param push_buffer Pointer to elem_number elements to copy.
+ * @param elem_number Number of elements.
+ * @return Error status.
+ */
+dynamic_array_error_t
+DynamicArrayPushN        (struct dynamic_array* const d_array,
+                          const  void*          const push_buffer,
+                          const  size_t               elem_number);
+
+/**
+ * @brief Adds one element in the end of the array without initializing it.
+ * Capacity only grows, caller writes the element through returned pointer.
+ * @param d_array Pointer to dynamic array struct.
+ * @return Pointer to new element. NULL on error.
+ */
+void*
+DynamicArrayEmplace      (struct dynamic_array* const d_array);
+
+/**
+ * @brief Sets data_array_size, new elements are filled with zero bytes.
+ * Capacity only grows.
+ * @param d_array Pointer to dynamic array struct.
+ * @param new_size New number of elements.
+ * @return Error status.
+ */
+dynamic_array_error_t
+DynamicArrayResize       (struct dynamic_array* const d_array,
+                          const  size_t               new_size);
+
+/**
+ * @brief Reallocs data_array to data_array_size elements (at least one,
+ * so the array stays usable) and drops reserved capacity.
+ * @param d_array Pointer to dynamic array struct.
+ * @return Error status.
+ */
+dynamic_array_error_t
+DynamicArrayShrinkToFit  (struct dynamic_array* const d_array);
+
 #endif /* DYNAMIC_ARRAY_H */
\ No newline at end of file
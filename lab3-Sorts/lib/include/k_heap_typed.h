@@ -0,0 +1,243 @@
+#ifndef K_HEAP_TYPED_H
+#define K_HEAP_TYPED_H
+
+#include "k_heap.h"
+#include "../../include/sort_stats.h"
+
+/**
+ * Type-specialized k-heap with the API of k_heap.h.
+ *
+ * K_HEAP_TYPED_DEFINE (name, type, arity, before) defines "struct name" and
+ * static functions nameConstructor(), nameDestructor(), nameSiftUp(),
+ * nameSiftDown(), nameInsert(), nameExtractRoot() and nameDeleteKey().
+ * before (a, b) is an expression of two type values, true if a must be
+ * closer to the root than b, so "(a) > (b)" makes max-heap.
+ *
+ * Unlike struct k_heap, elements are type values, not elem_size bytes, the
+ * comparison is inlined, arity is a constant, so child index is computed
+ * with shifts for powers of two, and elements are read from data_array
+ * without DynamicArrayGetElemPtrByIndex() checks. Sifts move a hole instead
+ * of swapping: the sifted element is kept in a local variable, every level
+ * moves one element into the hole, and the element is written once at the
+ * end. DeleteKey() fills the hole with the last element and sifts it,
+ * so no infinity value is needed. Every element written into the heap
+ * counts as SORT_STATS_MOVE(), there are no swaps and, as sifts are loops,
+ * no recursion depth.
+ *
+ * Switching from struct k_heap:
+ *     KHeapConstructor (d_array, k, sizeof (int), &inf, int_cmp)
+ * becomes
+ *     K_HEAP_TYPED_DEFINE (IntMaxHeap, int, 4, (a) > (b))
+ *     IntMaxHeapConstructor (d_array)
+ * with the same calls of Insert(), ExtractRoot() and the rest.
+ */
+
+#define K_HEAP_TYPED_DEFINE(name, type, arity, before)                          \
+                                                                                \
+_Static_assert ((arity) >= 2, "k-heap arity must be at least 2");               \
+                                                                                \
+struct name                                                                     \
+{                                                                               \
+    struct dynamic_array* d_array;                                              \
+};                                                                              \
+                                                                                \
+static inline int                                                               \
+name##Before (const type a, const type b)                                       \
+{                                                                               \
+    return (before);                                                            \
+}                                                                               \
+                                                                                \
+/* puts value in the hole at key_index, parents after it move down */           \
+static inline void                                                              \
+name##SiftUpValue (type* const data, size_t key_index, const type value)        \
+{                                                                               \
+    while (key_index > K_HEAP_ROOT_INDEX)                                       \
+    {                                                                           \
+        const size_t parent = (key_index - 1) / (arity);                        \
+                                                                                \
+        if (!name##Before (value, data[parent])) break;                         \
+                                                                                \
+        data[key_index] = data[parent];                                         \
+        SORT_STATS_MOVE (sizeof (type));                                        \
+        key_index       = parent;                                               \
+    }                                                                           \
+                                                                                \
+    data[key_index] = value;                                                    \
+    SORT_STATS_MOVE (sizeof (type));                                            \
+}                                                                               \
+                                                                                \
+/* puts value in the hole at key_index, children before it move up */           \
+static inline void                                                              \
+name##SiftDownValue (type* const data, const size_t size,                       \
+                     size_t key_index, const type value)                        \
+{                                                                               \
+    while (true)                                                                \
+    {                                                                           \
+        const size_t first_child = key_index * (arity) + 1;                     \
+        if (first_child >= size) break;                                         \
+                                                                                \
+        const size_t last_child = (size - first_child > (arity)) ?              \
+                                  first_child + (arity) : size;                 \
+                                                                                \
+        size_t best_child = first_child;                                        \
+        for (size_t child = first_child + 1; child < last_child; ++child)       \
+            if (name##Before (data[child], data[best_child]))                   \
+                best_child = child;                                             \
+                                                                                \
+        if (!name##Before (data[best_child], value)) break;                     \
+                                                                                \
+        data[key_index] = data[best_child];                                     \
+        SORT_STATS_MOVE (sizeof (type));                                        \
+        key_index       = best_child;                                           \
+    }                                                                           \
+                                                                                \
+    data[key_index] = value;                                                    \
+    SORT_STATS_MOVE (sizeof (type));                                            \
+}                                                                               \
+                                                                                \
+static inline k_heap_error_t                                                    \
+name##SiftUp (struct name* const heap,                                          \
+              const size_t key_index)                                           \
+{                                                                               \
+    if (heap == NULL || key_index >= heap->d_array->data_array_size)            \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    type* const data = (type*) heap->d_array->data_array;                       \
+    name##SiftUpValue (data, key_index, data[key_index]);                       \
+                                                                                \
+    return K_HEAP_SUCCESS;                                                      \
+}                                                                               \
+                                                                                \
+static inline k_heap_error_t                                                    \
+name##SiftDown (struct name* const heap,                                        \
+                const size_t key_index)                                         \
+{                                                                               \
+    if (heap == NULL || key_index >= heap->d_array->data_array_size)            \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    type* const data = (type*) heap->d_array->data_array;                       \
+    name##SiftDownValue (data, heap->d_array->data_array_size,                  \
+                         key_index, data[key_index]);                           \
+                                                                                \
+    return K_HEAP_SUCCESS;                                                      \
+}                                                                               \
+                                                                                \
+/* heap of d_array elements, empty reallocating heap if d_array is NULL */      \
+static inline struct name*                                                      \
+name##Constructor (struct dynamic_array* d_array)                               \
+{                                                                               \
+    struct name* const heap = (struct name*) calloc (1, sizeof (struct name));  \
+    if (heap == NULL) return NULL;                                              \
+                                                                                \
+    if (d_array == NULL)                                                        \
+    {                                                                           \
+        d_array = DynamicArrayConstructor (K_HEAP_INITIAL_DATA_ARRAY_CAPACITY,  \
+                                           sizeof (type),                       \
+                                           DYNAMIC_ARRAY_REALLOC_ENABLED,       \
+                                           DYNAMIC_ARRAY_DESTROY);              \
+        if (d_array == NULL)                                                    \
+        {                                                                       \
+            free (heap);                                                        \
+            return NULL;                                                        \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    assert (d_array->elem_size == sizeof (type));                               \
+    heap->d_array = d_array;                                                    \
+                                                                                \
+    type* const  data = (type*) d_array->data_array;                            \
+    const size_t size = d_array->data_array_size;                               \
+                                                                                \
+    /* from the last parent to the root */                                      \
+    for (size_t i = (size > 1) ? (size - 2) / (arity) + 1 : 0; i > 0; --i)      \
+        name##SiftDownValue (data, size, i - 1, data[i - 1]);                   \
+                                                                                \
+    return heap;                                                                \
+}                                                                               \
+                                                                                \
+static inline struct name*                                                      \
+name##Destructor (struct name* const heap)                                      \
+{                                                                               \
+    if (heap == NULL) return NULL;                                              \
+                                                                                \
+    heap->d_array = DynamicArrayDestructor (heap->d_array);                     \
+    free (heap);                                                                \
+                                                                                \
+    return NULL;                                                                \
+}                                                                               \
+                                                                                \
+static inline k_heap_error_t                                                    \
+name##Insert (struct name* const heap,                                          \
+              const type*  const insert_buffer)                                 \
+{                                                                               \
+    if (heap == NULL || insert_buffer == NULL)                                  \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    const type value = *insert_buffer;                                          \
+                                                                                \
+    if (DynamicArrayEmplace (heap->d_array) == NULL)                            \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    name##SiftUpValue ((type*) heap->d_array->data_array,                       \
+                       heap->d_array->data_array_size - 1, value);              \
+                                                                                \
+    return K_HEAP_SUCCESS;                                                      \
+}                                                                               \
+                                                                                \
+static inline k_heap_error_t                                                    \
+name##ExtractRoot (struct name* const heap,                                     \
+                   type*        const get_buffer)                               \
+{                                                                               \
+    if (heap == NULL || heap->d_array->data_array_size == 0)                    \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    type* data = (type*) heap->d_array->data_array;                             \
+    const size_t last = heap->d_array->data_array_size - 1;                     \
+                                                                                \
+    if (get_buffer != NULL)                                                     \
+        *get_buffer = data[K_HEAP_ROOT_INDEX];                                  \
+                                                                                \
+    const type last_value = data[last];                                         \
+                                                                                \
+    if (DynamicArrayPop (heap->d_array) == DYNAMIC_ARRAY_ERROR)                 \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    /* pop may realloc */                                                       \
+    data = (type*) heap->d_array->data_array;                                   \
+                                                                                \
+    if (last > 0)                                                               \
+        name##SiftDownValue (data, last, K_HEAP_ROOT_INDEX, last_value);        \
+                                                                                \
+    return K_HEAP_SUCCESS;                                                      \
+}                                                                               \
+                                                                                \
+static inline k_heap_error_t                                                    \
+name##DeleteKey (struct name* const heap,                                       \
+                 const size_t key_index)                                        \
+{                                                                               \
+    if (heap == NULL || key_index >= heap->d_array->data_array_size)            \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    type* data = (type*) heap->d_array->data_array;                             \
+    const size_t last = heap->d_array->data_array_size - 1;                     \
+                                                                                \
+    const type last_value = data[last];                                         \
+                                                                                \
+    if (DynamicArrayPop (heap->d_array) == DYNAMIC_ARRAY_ERROR)                 \
+        return K_HEAP_ERROR;                                                    \
+                                                                                \
+    data = (type*) heap->d_array->data_array;                                   \
+                                                                                \
+    if (key_index == last) return K_HEAP_SUCCESS;                               \
+                                                                                \
+    /* last element goes up if it's before parent of the hole, else down */     \
+    if (key_index > K_HEAP_ROOT_INDEX &&                                        \
+        name##Before (last_value, data[(key_index - 1) / (arity)]))             \
+        name##SiftUpValue (data, key_index, last_value);                        \
+    else                                                                        \
+        name##SiftDownValue (data, last, key_index, last_value);                \
+                                                                                \
+    return K_HEAP_SUCCESS;                                                      \
+}
+
+#endif /* K_HEAP_TYPED_H */
@@ -0,0 +1,166 @@
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <assert.h>
+
+/**
+ * Fork-join runtime: every worker has its own Chase-Lev deque of tasks,
+ * it pushes and pops tasks at the bottom, idle workers steal from the top
+ * of random victims. TaskSpawn() and TaskSync() work only inside
+ * TaskSchedulerRun(), outside of it spawned task is executed immediately.
+ */
+
+extern const size_t TASK_DEQUE_CAPACITY;
+
+enum task_scheduler_error_status
+{
+    TASK_SCHEDULER_SUCCESS = 0,
+    TASK_SCHEDULER_ERROR   = 1
+};
+
+typedef int task_scheduler_error_t;
+
+typedef void (*task_function_t) (void* arg);
+
+/**
+ * @brief Tasks spawned before one TaskSync().
+ * @details Must be zero-initialized, for example "struct task_group group = {};".
+ */
+struct task_group
+{
+    atomic_size_t pending;
+};
+
+/**
+ * @brief Spawned task. Memory is owned by spawner and must live
+ * until TaskSync() of its group returns, stack of spawner is fine.
+ */
+struct task
+{
+    task_function_t    function;
+    void*              arg;
+    struct task_group* group;
+};
+
+/**
+ * @brief Chase-Lev deque with fixed capacity.
+ */
+struct task_deque
+{
+    atomic_llong            top;
+    atomic_llong            bottom;
+    _Atomic (struct task*)* tasks;
+};
+
+/**
+ * @brief Counters for tuning, summed over workers by TaskSchedulerGetStats().
+ */
+struct task_scheduler_stats
+{
+    size_t tasks_executed;
+    size_t steals;              ///< Successful steals.
+    size_t failed_steals;       ///< Steal attempts from empty or contended deques.
+    double idle_time;           ///< Seconds spent looking for work.
+};
+
+struct task_worker
+{
+    struct task_deque        deque;
+    struct task_scheduler*   scheduler;
+    size_t                   index;
+    pthread_t                thread;
+    bool                     started;
+    unsigned long long       random_state;
+
+    atomic_size_t            tasks_executed;
+    atomic_size_t            steals;
+    atomic_size_t            failed_steals;
+    atomic_ullong            idle_nanoseconds;
+};
+
+struct task_scheduler
+{
+    struct task_worker* workers;
+    size_t              worker_number;  ///< Including the thread calling TaskSchedulerRun().
+    bool                pin_workers;
+
+    pthread_mutex_t     run_mutex;      ///< One TaskSchedulerRun() at a time.
+    pthread_mutex_t     sleep_mutex;
+    pthread_cond_t      wake_up;
+    atomic_bool         running;        ///< Workers look for tasks only while running.
+    atomic_bool         shutdown;
+};
+
+/**
+ * @param worker_number Number of workers, 0 means number of online CPUs.
+ * Caller of TaskSchedulerRun() is worker 0, others are threads.
+ * @param pin_workers Whether to pin worker thread i to CPU i,
+ * the calling thread (worker 0) is not pinned.
+ */
+struct task_scheduler*
+TaskSchedulerConstructor (size_t     worker_number,
+                          const bool pin_workers);
+
+struct task_scheduler*
+TaskSchedulerDestructor (struct task_scheduler* const scheduler);
+
+/**
+ * @brief Calls function (arg) as worker 0 and returns when it returns.
+ * @details Workers look for tasks while it runs and sleep otherwise.
+ * function must sync all tasks it spawns.
+ */
+task_scheduler_error_t
+TaskSchedulerRun (struct task_scheduler* const scheduler,
+                  task_function_t              function,
+                  void* const                  arg);
+
+/**
+ * @brief Scheduler shared by library functions, created on the first call
+ * with one worker per CPU and destroyed at exit.
+ */
+struct task_scheduler*
+TaskSchedulerDefault (void);
+
+/**
+ * @brief Pushes task to deque of current worker, executes it immediately
+ * if it is called outside of TaskSchedulerRun() or deque is full.
+ */
+void
+TaskSpawn (struct task_group* const group,
+           struct task* const       task,
+           task_function_t          function,
+           void* const              arg);
+
+/**
+ * @brief Waits until all tasks of group are done, executing own
+ * and stolen tasks meanwhile.
+ */
+void
+TaskSync (struct task_group* const group);
+
+/**
+ * @brief Index of current worker or 0 outside of workers.
+ */
+size_t
+TaskWorkerIndex (void);
+
+task_scheduler_error_t
+TaskSchedulerGetStats (const struct task_scheduler* const scheduler,
+                       struct task_scheduler_stats* const stats);
+
+void
+TaskSchedulerResetStats (struct task_scheduler* const scheduler);
+
+/**
+ * @brief Prints stats of every worker.
+ */
+void
+TaskSchedulerDumpStats (const struct task_scheduler* const scheduler,
+                        FILE* const                        output);
+
+#endif /* TASK_SCHEDULER_H */
@@ -1,9 +1,16 @@
+#define _GNU_SOURCE
 #include "../include/dynamic_array.h"
+#include <sys/mman.h>
+#include <unistd.h>
 
 const size_t DYNAMIC_ARRAY_RESIZE_MULTIPLIER = 2;
 const size_t DYNAMIC_ARRAY_NULL_SIZE   = 0;
 const char   DYNAMIC_ARRAY_POISON_BYTE = 0;
 
+const size_t DYNAMIC_ARRAY_CACHE_LINE_SIZE     = 64;
+const size_t DYNAMIC_ARRAY_MMAP_THRESHOLD      = 1 << 20;
+const size_t DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD = 1 << 21;
+
 /**
  * @brief Checks whether the struct pointers are OK.
  * @param d_array Pointer to struct.
@@ -12,37 +19,105 @@ const char   DYNAMIC_ARRAY_POISON_BYTE = 0;
 static inline dynamic_array_error_t
 DynamicArrayCheck (struct dynamic_array* const d_array);
 
+/**
+ * @brief Resizes data_array allocation to new_bytes the way memory_mode says.
+ * @details Allocates if data_array is NULL. New bytes are not initialized.
+ * @param d_array Pointer to struct.
+ * @param new_bytes New size of data_array in bytes.
+ * @return Error status, data_array is not changed on error.
+ */
+static dynamic_array_error_t
+DynamicArrayResizeMemory (struct dynamic_array* const d_array,
+                          const size_t                new_bytes);
+
+/**
+ * @brief Frees data_array the way it was allocated.
+ */
+static void
+DynamicArrayFreeMemory (struct dynamic_array* const d_array);
+
+static size_t
+DynamicArrayRoundUp (const size_t value,
+                     const size_t alignment);
+
+/**
+ * @brief Sets data_array_capacity to capacity and reallocs data_array.
+ * @return Error status, the struct is not changed on error.
+ */
+static dynamic_array_error_t
+DynamicArraySetCapacity (struct dynamic_array* const d_array,
+                         const size_t                capacity);
+
+/**
+ * @brief Grows capacity at least to min_capacity, at least twice.
+ */
+static dynamic_array_error_t
+DynamicArrayGrow (struct dynamic_array* const d_array,
+                  const size_t                min_capacity);
+
+/**
+ * @brief Fills elements [from_index, to_index) with DYNAMIC_ARRAY_POISON_BYTE.
+ * @details Does nothing if data_array is mapped: fresh pages of mmap () and
+ * mremap () are already zero, and writing them would fault in every page
+ * of the capacity the array doesn't use yet.
+ */
+static void
+DynamicArrayPoison (struct dynamic_array* const d_array,
+                    const size_t                from_index,
+                    const size_t                to_index);
+
 struct dynamic_array*
 DynamicArrayConstructor (const size_t initial_data_array_capaity,
                          const size_t elem_size,
                          const bool enable_realloc,
                          const bool save_array)
 {
+    return DynamicArrayConstructorMode (initial_data_array_capaity, elem_size,
+                                        enable_realloc, save_array,
+                                        DYNAMIC_ARRAY_MEMORY_HEAP);
+}
+
+struct dynamic_array*
+DynamicArrayConstructorMode (const size_t                         initial_data_array_capacity,
+                             const size_t                         elem_size,
+                             const bool                           enable_realloc,
+                             const bool                           save_array,
+                             const enum dynamic_array_memory_mode memory_mode)
+{
+    /* mapped data_array can't be given away to be free ()-d */
+    if (memory_mode == DYNAMIC_ARRAY_MEMORY_LARGE && save_array == DYNAMIC_ARRAY_SAVE)
+        return NULL;
+
     struct dynamic_array* new_dynamic_array =
         (struct dynamic_array*) calloc (1, sizeof (struct dynamic_array));
     if (new_dynamic_array == NULL)
         return NULL;
 
-    void* new_data_array = NULL;
+    new_dynamic_array->memory_mode = memory_mode;
 
-    if (initial_data_array_capaity != DYNAMIC_ARRAY_NULL_SIZE &&
-        elem_size                  != DYNAMIC_ARRAY_NULL_SIZE)
+    if (initial_data_array_capacity != DYNAMIC_ARRAY_NULL_SIZE &&
+        elem_size                   != DYNAMIC_ARRAY_NULL_SIZE)
     {
-        new_data_array = calloc (initial_data_array_capaity, elem_size);
-        if (new_data_array == NULL)
+        const size_t num_of_bytes = initial_data_array_capacity * elem_size;
+
+        if (DynamicArrayResizeMemory (new_dynamic_array, num_of_bytes) ==
+            DYNAMIC_ARRAY_ERROR)
         {
             free (new_dynamic_array);
             return NULL;
         }
+
     }
 
-    new_dynamic_array->data_array          = new_data_array;
-    new_dynamic_array->data_array_capacity = initial_data_array_capaity;
+    new_dynamic_array->data_array_capacity = initial_data_array_capacity;
     new_dynamic_array->data_array_size     = DYNAMIC_ARRAY_NULL_SIZE;
     new_dynamic_array->elem_size           = elem_size;
     new_dynamic_array->enable_realloc      = enable_realloc;
     new_dynamic_array->save_array          = save_array;
 
+    if (new_dynamic_array->data_array != NULL)
+        DynamicArrayPoison (new_dynamic_array, 0, initial_data_array_capacity);
+
     return new_dynamic_array;
 }
 
@@ -55,13 +130,9 @@ DynamicArrayDestructor (struct dynamic_array* const d_array)
     if (d_array->data_array != NULL &&
         d_array->save_array == DYNAMIC_ARRAY_DESTROY)
     {
-        for (size_t i = 0; i < d_array->data_array_capacity; ++i)
-        {
-            memset (DynamicArrayGetElemPtrByIndex (d_array, i),
-                    DYNAMIC_ARRAY_POISON_BYTE, d_array->elem_size);
-        }
+        DynamicArrayPoison (d_array, 0, d_array->data_array_capacity);
 
-        free (d_array->data_array);
+        DynamicArrayFreeMemory (d_array);
     }
 
     memset (d_array, DYNAMIC_ARRAY_POISON_BYTE, sizeof (struct dynamic_array));
@@ -89,10 +160,13 @@ DynamicArrayReallocCheck (struct dynamic_array* const d_array)
             return DYNAMIC_ARRAY_ERROR;
     }
 
-    /* realloc down */
+    /* realloc down, not below reserved capacity and not to empty array */
     else if (d_array->data_array_size <=
              d_array->data_array_capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER /
-                                            DYNAMIC_ARRAY_RESIZE_MULTIPLIER)
+                                            DYNAMIC_ARRAY_RESIZE_MULTIPLIER &&
+             d_array->data_array_capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER >=
+             d_array->reserved_capacity &&
+             d_array->data_array_capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER > 0)
     {
         d_array->data_array_capacity /= DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
 
@@ -112,19 +186,11 @@ DynamicArrayRealloc (struct dynamic_array* const d_array)
     const size_t num_of_bytes =
         d_array->data_array_capacity * d_array->elem_size;
 
-    void* new_data_array = realloc (d_array->data_array, num_of_bytes);
-    if (new_data_array == NULL)
+    if (DynamicArrayResizeMemory (d_array, num_of_bytes) == DYNAMIC_ARRAY_ERROR)
         return DYNAMIC_ARRAY_ERROR;
 
-    d_array->data_array = new_data_array;
-
     /* poison new bytes */
-    for (size_t i = d_array->data_array_size;
-                i < d_array->data_array_capacity; ++i)
-    {
-        memset (DynamicArrayGetElemPtrByIndex (d_array, i),
-                DYNAMIC_ARRAY_POISON_BYTE, d_array->elem_size);
-    }
+    DynamicArrayPoison (d_array, d_array->data_array_size, d_array->data_array_capacity);
 
     return DYNAMIC_ARRAY_SUCCESS;
 }
@@ -188,6 +254,93 @@ DynamicArrayGetElemPtrByIndex (struct dynamic_array* const d_array,
                             d_array->elem_size * elem_index);
 }
 
+dynamic_array_error_t
+DynamicArrayReserve (struct dynamic_array* const d_array,
+                     const  size_t               capacity)
+{
+    if (d_array == NULL) return DYNAMIC_ARRAY_ERROR;
+
+    if (capacity > d_array->reserved_capacity)
+        d_array->reserved_capacity = capacity;
+
+    if (capacity <= d_array->data_array_capacity && d_array->data_array != NULL)
+        return DYNAMIC_ARRAY_SUCCESS;
+
+    return DynamicArraySetCapacity (d_array, capacity);
+}
+
+dynamic_array_error_t
+DynamicArrayPushN (struct dynamic_array* const d_array,
+                   const  void*          const push_buffer,
+                   const  size_t               elem_number)
+{
+    if (d_array == NULL || (push_buffer == NULL && elem_number != 0))
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (elem_number == 0) return DYNAMIC_ARRAY_SUCCESS;
+
+    const size_t new_size = d_array->data_array_size + elem_number;
+
+    if ((new_size > d_array->data_array_capacity || d_array->data_array == NULL) &&
+        DynamicArrayGrow (d_array, new_size) == DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    memcpy ((char*) d_array->data_array + d_array->data_array_size * d_array->elem_size,
+            push_buffer, elem_number * d_array->elem_size);
+    d_array->data_array_size = new_size;
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+void*
+DynamicArrayEmplace (struct dynamic_array* const d_array)
+{
+    if (d_array == NULL) return NULL;
+
+    if ((d_array->data_array_size == d_array->data_array_capacity ||
+         d_array->data_array == NULL) &&
+        DynamicArrayGrow (d_array, d_array->data_array_size + 1) == DYNAMIC_ARRAY_ERROR)
+        return NULL;
+
+    return (char*) d_array->data_array +
+                   d_array->elem_size * d_array->data_array_size++;
+}
+
+dynamic_array_error_t
+DynamicArrayResize (struct dynamic_array* const d_array,
+                    const  size_t               new_size)
+{
+    if (d_array == NULL) return DYNAMIC_ARRAY_ERROR;
+
+    if ((new_size > d_array->data_array_capacity || d_array->data_array == NULL) &&
+        DynamicArrayGrow (d_array, new_size) == DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (new_size > d_array->data_array_size)
+        memset ((char*) d_array->data_array + d_array->data_array_size * d_array->elem_size,
+                0, (new_size - d_array->data_array_size) * d_array->elem_size);
+
+    d_array->data_array_size = new_size;
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+dynamic_array_error_t
+DynamicArrayShrinkToFit (struct dynamic_array* const d_array)
+{
+    if (DynamicArrayCheck (d_array) == DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    d_array->reserved_capacity = 0;
+
+    const size_t capacity =
+        (d_array->data_array_size > 0) ? d_array->data_array_size : 1;
+
+    if (capacity == d_array->data_array_capacity) return DYNAMIC_ARRAY_SUCCESS;
+
+    return DynamicArraySetCapacity (d_array, capacity);
+}
+
 static inline dynamic_array_error_t
 DynamicArrayCheck (struct dynamic_array* const d_array)
 {
@@ -196,3 +349,180 @@ DynamicArrayCheck (struct dynamic_array* const d_array)
 
     return DYNAMIC_ARRAY_SUCCESS;
 }
+
+static dynamic_array_error_t
+DynamicArrayResizeMemory (struct dynamic_array* const d_array,
+                          const size_t                new_bytes)
+{
+    assert (d_array);
+
+    void* new_data_array = NULL;
+
+    switch (d_array->memory_mode)
+    {
+        case DYNAMIC_ARRAY_MEMORY_HEAP:
+            new_data_array = realloc (d_array->data_array, new_bytes);
+            if (new_data_array == NULL)
+                return DYNAMIC_ARRAY_ERROR;
+
+            d_array->allocated_bytes = new_bytes;
+            break;
+
+        /* realloc () doesn't keep alignment, so data is copied */
+        case DYNAMIC_ARRAY_MEMORY_ALIGNED:
+        {
+            const size_t aligned_bytes =
+                DynamicArrayRoundUp (new_bytes, DYNAMIC_ARRAY_CACHE_LINE_SIZE);
+
+            new_data_array = aligned_alloc (DYNAMIC_ARRAY_CACHE_LINE_SIZE, aligned_bytes);
+            if (new_data_array == NULL)
+                return DYNAMIC_ARRAY_ERROR;
+
+            if (d_array->data_array != NULL)
+            {
+                memcpy (new_data_array, d_array->data_array,
+                        (d_array->allocated_bytes < aligned_bytes) ?
+                         d_array->allocated_bytes : aligned_bytes);
+                free (d_array->data_array);
+            }
+
+            d_array->allocated_bytes = aligned_bytes;
+            break;
+        }
+
+        case DYNAMIC_ARRAY_MEMORY_LARGE:
+        {
+            if (!d_array->mapped && new_bytes < DYNAMIC_ARRAY_MMAP_THRESHOLD)
+            {
+                new_data_array = realloc (d_array->data_array, new_bytes);
+                if (new_data_array == NULL)
+                    return DYNAMIC_ARRAY_ERROR;
+
+                d_array->allocated_bytes = new_bytes;
+                break;
+            }
+
+            const long   page_size    = sysconf (_SC_PAGESIZE);
+            const size_t mapped_bytes =
+                DynamicArrayRoundUp (new_bytes, (page_size > 0) ? (size_t) page_size : 4096);
+
+            if (d_array->mapped)
+            {
+                /* pages are moved by page tables, not copied */
+                new_data_array = mremap (d_array->data_array, d_array->allocated_bytes,
+                                         mapped_bytes, MREMAP_MAYMOVE);
+                if (new_data_array == MAP_FAILED)
+                    return DYNAMIC_ARRAY_ERROR;
+            }
+
+            else
+            {
+                new_data_array = mmap (NULL, mapped_bytes, PROT_READ | PROT_WRITE,
+                                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (new_data_array == MAP_FAILED)
+                    return DYNAMIC_ARRAY_ERROR;
+
+                /* the last copy, from now on growth is mremap () */
+                if (d_array->data_array != NULL)
+                {
+                    memcpy (new_data_array, d_array->data_array,
+                            (d_array->allocated_bytes < mapped_bytes) ?
+                             d_array->allocated_bytes : mapped_bytes);
+                    free (d_array->data_array);
+                }
+
+                d_array->mapped = true;
+            }
+
+            /* only a hint, the array works without huge pages too */
+            if (mapped_bytes >= DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD)
+                madvise (new_data_array, mapped_bytes, MADV_HUGEPAGE);
+
+            d_array->allocated_bytes = mapped_bytes;
+            break;
+        }
+
+        default:
+            return DYNAMIC_ARRAY_ERROR;
+    }
+
+    d_array->data_array = new_data_array;
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static void
+DynamicArrayFreeMemory (struct dynamic_array* const d_array)
+{
+    assert (d_array);
+
+    if (d_array->mapped)
+        munmap (d_array->data_array, d_array->allocated_bytes);
+    else
+        free (d_array->data_array);
+
+    d_array->data_array      = NULL;
+    d_array->allocated_bytes = 0;
+    d_array->mapped          = false;
+}
+
+static size_t
+DynamicArrayRoundUp (const size_t value,
+                     const size_t alignment)
+{
+    assert (alignment > 0);
+
+    /* empty allocation still has a valid pointer */
+    if (value == 0) return alignment;
+
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static dynamic_array_error_t
+DynamicArraySetCapacity (struct dynamic_array* const d_array,
+                         const size_t                capacity)
+{
+    assert (d_array);
+
+    if (d_array->enable_realloc == DYNAMIC_ARRAY_REALLOC_DISABLED ||
+        d_array->elem_size == DYNAMIC_ARRAY_NULL_SIZE || capacity == 0)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (DynamicArrayResizeMemory (d_array, capacity * d_array->elem_size) ==
+        DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    d_array->data_array_capacity = capacity;
+
+    /* poison new bytes */
+    DynamicArrayPoison (d_array, d_array->data_array_size, capacity);
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static dynamic_array_error_t
+DynamicArrayGrow (struct dynamic_array* const d_array,
+                  const size_t                min_capacity)
+{
+    assert (d_array);
+
+    size_t capacity = d_array->data_array_capacity * DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
+
+    if (capacity < min_capacity) capacity = min_capacity;
+    if (capacity == 0)           capacity = 1;
+
+    return DynamicArraySetCapacity (d_array, capacity);
+}
+
+static void
+DynamicArrayPoison (struct dynamic_array* const d_array,
+                    const size_t                from_index,
+                    const size_t                to_index)
+{
+    assert (d_array);
+
+    if (d_array->mapped || from_index >= to_index) return;
+
+    memset ((char*) d_array->data_array + from_index * d_array->elem_size,
+            DYNAMIC_ARRAY_POISON_BYTE, (to_index - from_index) * d_array->elem_size);
+}
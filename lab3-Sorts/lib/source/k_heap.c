@@ -1,4 +1,5 @@
 #include "../include/k_heap.h"
+#include "../../include/sort_stats.h"
 #include <stdio.h>
 
 const size_t K_HEAP_NULL_SIZE  = 0;
@@ -63,6 +64,7 @@ KHeapDestructor (struct k_heap* const heap)
     heap->k = K_HEAP_NULL_SIZE;
     heap->cmp = NULL;
 
+    free (heap);
     return NULL;
 }
 
@@ -132,7 +134,10 @@ KHeapSiftDown (struct k_heap* const heap,
     {
         swap (KHeapGetElemPtrByIndex (heap, key_index),
               cur_ptr, heap->d_array->elem_size);
+
+        SORT_STATS_ENTER ();
         KHeapSiftDown (heap, cur_index);
+        SORT_STATS_LEAVE ();
     }
 
     return K_HEAP_SUCCESS;
@@ -173,6 +178,7 @@ KHeapExtractRoot (struct k_heap* const heap,
         memcpy (get_buffer, root_ptr, heap->d_array->elem_size);
 
     memcpy (root_ptr, last_ptr, heap->d_array->elem_size);
+    SORT_STATS_MOVE (heap->d_array->elem_size);
 
     if (DynamicArrayPop (heap->d_array) == DYNAMIC_ARRAY_ERROR)
         return K_HEAP_ERROR;
@@ -193,6 +199,7 @@ KHeapDeleteKey (struct k_heap* const heap,
     // a[key_index] = inf;
     memcpy (KHeapGetElemPtrByIndex (heap, key_index),
             heap->infinity_value, heap->d_array->elem_size);
+    SORT_STATS_MOVE (heap->d_array->elem_size);
 
     if (KHeapSiftUp (heap, key_index) == K_HEAP_ERROR)
         return K_HEAP_ERROR;
@@ -221,7 +228,11 @@ swap (void* elem1, void* elem2, const size_t elem_size)
     void* tmp_elem = calloc (1, elem_size);
     assert (tmp_elem);
 
+    SORT_STATS_SWAP (2 * elem_size);
+
     memcpy (tmp_elem, elem2,    elem_size);
     memcpy (elem2,    elem1,    elem_size);
     memcpy (elem1,    tmp_elem, elem_size);
+
+    free (tmp_elem);
 }
\ No newline at end of file
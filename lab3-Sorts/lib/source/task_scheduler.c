@@ -0,0 +1,540 @@
+#define _GNU_SOURCE
+#include "../include/task_scheduler.h"
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+/* power of 2, tasks spawned into full deque are executed immediately */
+const size_t TASK_DEQUE_CAPACITY = 1 << 13;
+/* failed steal rounds before worker yields its CPU */
+const size_t TASK_WORKER_SPIN_ROUNDS = 64;
+
+static _Thread_local struct task_worker* current_worker = NULL;
+
+static struct task_scheduler* default_scheduler      = NULL;
+static pthread_once_t         default_scheduler_once = PTHREAD_ONCE_INIT;
+
+static void
+TaskSchedulerDefaultInit (void);
+
+static void
+TaskSchedulerDefaultDestroy (void);
+
+static void*
+TaskWorkerRoutine (void* worker_ptr);
+
+static struct task*
+TaskWorkerFindTask (struct task_worker* const worker);
+
+static void
+TaskExecute (struct task_worker* const worker,
+             struct task* const        task);
+
+static bool
+TaskDequePush (struct task_deque* const deque,
+               struct task* const       task);
+
+static struct task*
+TaskDequeTake (struct task_deque* const deque);
+
+static struct task*
+TaskDequeSteal (struct task_deque* const deque);
+
+static unsigned long long
+TaskGetNanoseconds (void);
+
+struct task_scheduler*
+TaskSchedulerConstructor (size_t     worker_number,
+                          const bool pin_workers)
+{
+    if (worker_number == 0)
+    {
+        const long cpu_number = sysconf (_SC_NPROCESSORS_ONLN);
+        worker_number = (cpu_number > 0) ? (size_t) cpu_number : 1;
+    }
+
+    struct task_scheduler* const scheduler =
+        (struct task_scheduler*) calloc (1, sizeof (struct task_scheduler));
+    if (scheduler == NULL) return NULL;
+
+    scheduler->workers =
+        (struct task_worker*) calloc (worker_number, sizeof (struct task_worker));
+    if (scheduler->workers == NULL)
+    {
+        free (scheduler);
+        return NULL;
+    }
+
+    scheduler->worker_number = worker_number;
+    scheduler->pin_workers   = pin_workers;
+
+    pthread_mutex_init (&scheduler->run_mutex,   NULL);
+    pthread_mutex_init (&scheduler->sleep_mutex, NULL);
+    pthread_cond_init  (&scheduler->wake_up,     NULL);
+    atomic_init (&scheduler->running,  false);
+    atomic_init (&scheduler->shutdown, false);
+
+    for (size_t i = 0; i < worker_number; ++i)
+    {
+        struct task_worker* const worker = &scheduler->workers[i];
+
+        worker->scheduler    = scheduler;
+        worker->index        = i;
+        worker->random_state = 0x9E3779B97F4A7C15ULL * (i + 1);
+
+        atomic_init (&worker->deque.top,    0);
+        atomic_init (&worker->deque.bottom, 0);
+        worker->deque.tasks =
+            (_Atomic (struct task*)*) calloc (TASK_DEQUE_CAPACITY, sizeof (struct task*));
+
+        if (worker->deque.tasks == NULL)
+            return TaskSchedulerDestructor (scheduler);
+    }
+
+    /* worker 0 is the thread calling TaskSchedulerRun () */
+    for (size_t i = 1; i < worker_number; ++i)
+    {
+        struct task_worker* const worker = &scheduler->workers[i];
+
+        worker->started =
+            pthread_create (&worker->thread, NULL, TaskWorkerRoutine, worker) == 0;
+
+        if (worker->started && pin_workers)
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO (&cpu_set);
+            CPU_SET  (i % CPU_SETSIZE, &cpu_set);
+
+            pthread_setaffinity_np (worker->thread, sizeof (cpu_set), &cpu_set);
+        }
+    }
+
+    return scheduler;
+}
+
+struct task_scheduler*
+TaskSchedulerDestructor (struct task_scheduler* const scheduler)
+{
+    if (scheduler == NULL) return NULL;
+
+    pthread_mutex_lock (&scheduler->sleep_mutex);
+    atomic_store (&scheduler->shutdown, true);
+    pthread_cond_broadcast (&scheduler->wake_up);
+    pthread_mutex_unlock (&scheduler->sleep_mutex);
+
+    for (size_t i = 1; i < scheduler->worker_number; ++i)
+        if (scheduler->workers[i].started)
+            pthread_join (scheduler->workers[i].thread, NULL);
+
+    for (size_t i = 0; i < scheduler->worker_number; ++i)
+        free (scheduler->workers[i].deque.tasks);
+
+    pthread_mutex_destroy (&scheduler->run_mutex);
+    pthread_mutex_destroy (&scheduler->sleep_mutex);
+    pthread_cond_destroy  (&scheduler->wake_up);
+
+    free (scheduler->workers);
+    free (scheduler);
+
+    return NULL;
+}
+
+task_scheduler_error_t
+TaskSchedulerRun (struct task_scheduler* const scheduler,
+                  task_function_t              function,
+                  void* const                  arg)
+{
+    if (scheduler == NULL || function == NULL) return TASK_SCHEDULER_ERROR;
+
+    /* nested run from a task of the same scheduler */
+    if (current_worker != NULL && current_worker->scheduler == scheduler)
+    {
+        function (arg);
+        return TASK_SCHEDULER_SUCCESS;
+    }
+
+    pthread_mutex_lock (&scheduler->run_mutex);
+
+    struct task_worker* const outer_worker = current_worker;
+    current_worker = &scheduler->workers[0];
+
+    pthread_mutex_lock (&scheduler->sleep_mutex);
+    atomic_store (&scheduler->running, true);
+    pthread_cond_broadcast (&scheduler->wake_up);
+    pthread_mutex_unlock (&scheduler->sleep_mutex);
+
+    function (arg);
+
+    atomic_store (&scheduler->running, false);
+
+    current_worker = outer_worker;
+
+    pthread_mutex_unlock (&scheduler->run_mutex);
+
+    return TASK_SCHEDULER_SUCCESS;
+}
+
+struct task_scheduler*
+TaskSchedulerDefault (void)
+{
+    pthread_once (&default_scheduler_once, TaskSchedulerDefaultInit);
+
+    return default_scheduler;
+}
+
+void
+TaskSpawn (struct task_group* const group,
+           struct task* const       task,
+           task_function_t          function,
+           void* const              arg)
+{
+    assert (group);
+    assert (task);
+    assert (function);
+
+    task->function = function;
+    task->arg      = arg;
+    task->group    = group;
+
+    struct task_worker* const worker = current_worker;
+
+    if (worker == NULL)
+    {
+        function (arg);
+        return;
+    }
+
+    atomic_fetch_add_explicit (&group->pending, 1, memory_order_relaxed);
+
+    if (!TaskDequePush (&worker->deque, task))
+        TaskExecute (worker, task);
+}
+
+void
+TaskSync (struct task_group* const group)
+{
+    assert (group);
+
+    struct task_worker* const worker = current_worker;
+
+    unsigned long long idle_begin = 0;
+    size_t             idle_rounds = 0;
+
+    while (atomic_load_explicit (&group->pending, memory_order_acquire) != 0)
+    {
+        assert (worker);
+
+        struct task* const task = TaskWorkerFindTask (worker);
+
+        if (task != NULL)
+        {
+            if (idle_begin != 0)
+            {
+                atomic_fetch_add_explicit (&worker->idle_nanoseconds,
+                                           TaskGetNanoseconds () - idle_begin,
+                                           memory_order_relaxed);
+                idle_begin = 0;
+            }
+
+            TaskExecute (worker, task);
+            continue;
+        }
+
+        if (idle_begin == 0) idle_begin = TaskGetNanoseconds ();
+
+        /* stolen tasks of the group are still running on other workers */
+        if (++idle_rounds % TASK_WORKER_SPIN_ROUNDS == 0) sched_yield ();
+    }
+
+    if (idle_begin != 0)
+        atomic_fetch_add_explicit (&worker->idle_nanoseconds,
+                                   TaskGetNanoseconds () - idle_begin,
+                                   memory_order_relaxed);
+}
+
+size_t
+TaskWorkerIndex (void)
+{
+    return (current_worker != NULL) ? current_worker->index : 0;
+}
+
+task_scheduler_error_t
+TaskSchedulerGetStats (const struct task_scheduler* const scheduler,
+                       struct task_scheduler_stats* const stats)
+{
+    if (scheduler == NULL || stats == NULL) return TASK_SCHEDULER_ERROR;
+
+    stats->tasks_executed = 0;
+    stats->steals         = 0;
+    stats->failed_steals  = 0;
+    stats->idle_time      = 0;
+
+    for (size_t i = 0; i < scheduler->worker_number; ++i)
+    {
+        struct task_worker* const worker = &scheduler->workers[i];
+
+        stats->tasks_executed += atomic_load (&worker->tasks_executed);
+        stats->steals         += atomic_load (&worker->steals);
+        stats->failed_steals  += atomic_load (&worker->failed_steals);
+        stats->idle_time      += (double) atomic_load (&worker->idle_nanoseconds) * 1e-9;
+    }
+
+    return TASK_SCHEDULER_SUCCESS;
+}
+
+void
+TaskSchedulerResetStats (struct task_scheduler* const scheduler)
+{
+    if (scheduler == NULL) return;
+
+    for (size_t i = 0; i < scheduler->worker_number; ++i)
+    {
+        struct task_worker* const worker = &scheduler->workers[i];
+
+        atomic_store (&worker->tasks_executed,   0);
+        atomic_store (&worker->steals,           0);
+        atomic_store (&worker->failed_steals,    0);
+        atomic_store (&worker->idle_nanoseconds, 0);
+    }
+}
+
+void
+TaskSchedulerDumpStats (const struct task_scheduler* const scheduler,
+                        FILE* const                        output)
+{
+    if (scheduler == NULL || output == NULL) return;
+
+    fprintf (output, "worker tasks steals failed_steals idle_sec\n");
+
+    for (size_t i = 0; i < scheduler->worker_number; ++i)
+    {
+        struct task_worker* const worker = &scheduler->workers[i];
+
+        fprintf (output, "%zu %zu %zu %zu %lg\n", i,
+                 atomic_load (&worker->tasks_executed),
+                 atomic_load (&worker->steals),
+                 atomic_load (&worker->failed_steals),
+                 (double) atomic_load (&worker->idle_nanoseconds) * 1e-9);
+    }
+}
+
+static void
+TaskSchedulerDefaultInit (void)
+{
+    default_scheduler = TaskSchedulerConstructor (0, false);
+
+    if (default_scheduler != NULL)
+        atexit (TaskSchedulerDefaultDestroy);
+}
+
+static void
+TaskSchedulerDefaultDestroy (void)
+{
+    default_scheduler = TaskSchedulerDestructor (default_scheduler);
+}
+
+/**
+ * @brief Sleeps until TaskSchedulerRun (), then executes own and stolen tasks.
+ */
+static void*
+TaskWorkerRoutine (void* worker_ptr)
+{
+    assert (worker_ptr);
+    struct task_worker*    const worker    = (struct task_worker*) worker_ptr;
+    struct task_scheduler* const scheduler = worker->scheduler;
+
+    current_worker = worker;
+
+    while (true)
+    {
+        pthread_mutex_lock (&scheduler->sleep_mutex);
+
+        while (!atomic_load (&scheduler->running) && !atomic_load (&scheduler->shutdown))
+            pthread_cond_wait (&scheduler->wake_up, &scheduler->sleep_mutex);
+
+        pthread_mutex_unlock (&scheduler->sleep_mutex);
+
+        if (atomic_load (&scheduler->shutdown)) break;
+
+        unsigned long long idle_begin  = TaskGetNanoseconds ();
+        size_t             idle_rounds = 0;
+
+        while (atomic_load_explicit (&scheduler->running, memory_order_relaxed))
+        {
+            struct task* const task = TaskWorkerFindTask (worker);
+
+            if (task == NULL)
+            {
+                if (++idle_rounds % TASK_WORKER_SPIN_ROUNDS == 0) sched_yield ();
+                continue;
+            }
+
+            atomic_fetch_add_explicit (&worker->idle_nanoseconds,
+                                       TaskGetNanoseconds () - idle_begin,
+                                       memory_order_relaxed);
+
+            TaskExecute (worker, task);
+
+            idle_begin = TaskGetNanoseconds ();
+        }
+
+        atomic_fetch_add_explicit (&worker->idle_nanoseconds,
+                                   TaskGetNanoseconds () - idle_begin,
+                                   memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Takes task from own deque or steals one from a random victim.
+ */
+static struct task*
+TaskWorkerFindTask (struct task_worker* const worker)
+{
+    assert (worker);
+
+    struct task* task = TaskDequeTake (&worker->deque);
+    if (task != NULL) return task;
+
+    struct task_scheduler* const scheduler = worker->scheduler;
+    if (scheduler->worker_number == 1) return NULL;
+
+    /* xorshift64 */
+    worker->random_state ^= worker->random_state << 13;
+    worker->random_state ^= worker->random_state >> 7;
+    worker->random_state ^= worker->random_state << 17;
+
+    size_t victim = (size_t) (worker->random_state % (scheduler->worker_number - 1));
+    if (victim >= worker->index) victim++;
+
+    task = TaskDequeSteal (&scheduler->workers[victim].deque);
+
+    if (task != NULL)
+        atomic_fetch_add_explicit (&worker->steals,        1, memory_order_relaxed);
+    else
+        atomic_fetch_add_explicit (&worker->failed_steals, 1, memory_order_relaxed);
+
+    return task;
+}
+
+static void
+TaskExecute (struct task_worker* const worker,
+             struct task* const        task)
+{
+    assert (worker);
+    assert (task);
+
+    struct task_group* const group = task->group;
+
+    task->function (task->arg);
+
+    atomic_fetch_add_explicit (&worker->tasks_executed, 1, memory_order_relaxed);
+
+    /* task memory may be freed by spawner right after this */
+    atomic_fetch_sub_explicit (&group->pending, 1, memory_order_release);
+}
+
+//-----------------------------------------------------------------------------
+// Chase-Lev deque, "Correct and Efficient Work-Stealing for Weak Memory Models",
+// fences are replaced by seq_cst operations, so ThreadSanitizer understands them
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Pushes task to the bottom, only owner calls it.
+ * @return false if deque is full.
+ */
+static bool
+TaskDequePush (struct task_deque* const deque,
+               struct task* const       task)
+{
+    assert (deque);
+    assert (task);
+
+    const long long bottom = atomic_load_explicit (&deque->bottom, memory_order_relaxed);
+    const long long top    = atomic_load_explicit (&deque->top,    memory_order_acquire);
+
+    if (bottom - top >= (long long) TASK_DEQUE_CAPACITY) return false;
+
+    atomic_store_explicit (&deque->tasks[bottom & (long long) (TASK_DEQUE_CAPACITY - 1)],
+                           task, memory_order_relaxed);
+    /* publishes task for thieves reading bottom */
+    atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * @brief Pops task from the bottom, only owner calls it.
+ */
+static struct task*
+TaskDequeTake (struct task_deque* const deque)
+{
+    assert (deque);
+
+    const long long bottom = atomic_load_explicit (&deque->bottom, memory_order_relaxed) - 1;
+    /* seq_cst store and load instead of a fence: thieves must see new bottom
+       before this thread reads top, otherwise both may take the last task */
+    atomic_store_explicit (&deque->bottom, bottom, memory_order_seq_cst);
+    long long top = atomic_load_explicit (&deque->top, memory_order_seq_cst);
+
+    struct task* task = NULL;
+
+    if (top <= bottom)
+    {
+        task = atomic_load_explicit (&deque->tasks[bottom & (long long) (TASK_DEQUE_CAPACITY - 1)],
+                                     memory_order_relaxed);
+
+        /* the last task, race with thieves */
+        if (top == bottom)
+        {
+            if (!atomic_compare_exchange_strong_explicit (&deque->top, &top, top + 1,
+                                                          memory_order_seq_cst,
+                                                          memory_order_relaxed))
+                task = NULL;
+
+            atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_relaxed);
+        }
+    }
+
+    else
+        atomic_store_explicit (&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return task;
+}
+
+/**
+ * @brief Steals task from the top, called by other workers.
+ * @return NULL if deque is empty or another thief won.
+ */
+static struct task*
+TaskDequeSteal (struct task_deque* const deque)
+{
+    assert (deque);
+
+    long long top = atomic_load_explicit (&deque->top, memory_order_seq_cst);
+    const long long bottom = atomic_load_explicit (&deque->bottom, memory_order_seq_cst);
+
+    if (top >= bottom) return NULL;
+
+    struct task* const task =
+        atomic_load_explicit (&deque->tasks[top & (long long) (TASK_DEQUE_CAPACITY - 1)],
+                              memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit (&deque->top, &top, top + 1,
+                                                  memory_order_seq_cst,
+                                                  memory_order_relaxed))
+        return NULL;
+
+    return task;
+}
+
+static unsigned long long
+TaskGetNanoseconds (void)
+{
+    struct timespec time = {};
+    clock_gettime (CLOCK_MONOTONIC, &time);
+
+    return (unsigned long long) time.tv_sec * 1000000000ULL +
+           (unsigned long long) time.tv_nsec;
+}
@@ -0,0 +1,181 @@
+#include "../include/bandwidth.h"
+#include "../include/sort_stats.h"
+
+/* elements of one array, 3 arrays of 32 MB are much bigger than caches */
+const size_t BANDWIDTH_ARRAY_SIZE  = 1 << 22;
+const size_t BANDWIDTH_REPETITIONS = 5;
+const double BANDWIDTH_SCALAR      = 3.0;
+
+/**
+ * Kernels are compiled with optimizations and without sanitizers,
+ * so that instrumented builds measure the memory, not the instrumentation.
+ */
+#define BANDWIDTH_KERNEL \
+    __attribute__((noinline, no_sanitize ("address", "undefined"), optimize ("O2")))
+
+static struct memory_bandwidth memory_bandwidth      = {};
+static pthread_once_t          memory_bandwidth_once = PTHREAD_ONCE_INIT;
+
+static void
+MemoryBandwidthMeasure (void);
+
+BANDWIDTH_KERNEL static void
+StreamCopy  (double* const a, const double* const b, const size_t size);
+
+BANDWIDTH_KERNEL static void
+StreamScale (double* const a, const double* const b, const double q, const size_t size);
+
+BANDWIDTH_KERNEL static void
+StreamAdd   (double* const a, const double* const b, const double* const c, const size_t size);
+
+BANDWIDTH_KERNEL static void
+StreamTriad (double* const a, const double* const b, const double* const c, const double q,
+             const size_t size);
+
+static double
+BandwidthGetTime (void);
+
+const struct memory_bandwidth*
+MemoryBandwidth (void)
+{
+    pthread_once (&memory_bandwidth_once, MemoryBandwidthMeasure);
+
+    return &memory_bandwidth;
+}
+
+void
+RooflinePrint (FILE* const  output,
+               const size_t elem_number,
+               const size_t elem_size,
+               const double seconds)
+{
+    assert (output);
+
+    /* too fast runs are not measured by the timer */
+    const double elements_per_second = (seconds > 0) ? (double) elem_number / seconds : 0;
+
+#ifdef SORT_STATS
+    /* as in STREAM: every read and every written byte, moved bytes are read and written */
+    const size_t bytes_read    = sort_stats_counters.comparisons * 2 * elem_size +
+                                 sort_stats_counters.bytes_moved;
+    const size_t bytes_written = sort_stats_counters.bytes_moved;
+    const size_t traffic       = bytes_read + bytes_written;
+
+    const double peak             = MemoryBandwidth ()->peak;
+    const double bytes_per_second = (seconds > 0) ? (double) traffic / seconds : 0;
+
+    fprintf (output, " %lg %zu %lg %lg", elements_per_second, traffic,
+             bytes_per_second * 1e-9, (peak > 0) ? bytes_per_second / peak : 0);
+#else
+    (void) elem_size;
+
+    fprintf (output, " %lg", elements_per_second);
+#endif
+}
+
+static void
+MemoryBandwidthMeasure (void)
+{
+    double* const a = (double*) malloc (BANDWIDTH_ARRAY_SIZE * sizeof (double));
+    double* const b = (double*) malloc (BANDWIDTH_ARRAY_SIZE * sizeof (double));
+    double* const c = (double*) malloc (BANDWIDTH_ARRAY_SIZE * sizeof (double));
+
+    if (a == NULL || b == NULL || c == NULL)
+    {
+        free (a);
+        free (b);
+        free (c);
+        fprintf (stderr, "can't allocate arrays, memory bandwidth is not measured\n");
+        return;
+    }
+
+    /* touch every page before timing */
+    for (size_t i = 0; i < BANDWIDTH_ARRAY_SIZE; ++i)
+    {
+        a[i] = 1.0;
+        b[i] = 2.0;
+        c[i] = 0.0;
+    }
+
+    double best[4] = {};
+    const double bytes_two   = 2.0 * sizeof (double) * (double) BANDWIDTH_ARRAY_SIZE;
+    const double bytes_three = 3.0 * sizeof (double) * (double) BANDWIDTH_ARRAY_SIZE;
+
+    for (size_t rep = 0; rep < BANDWIDTH_REPETITIONS; ++rep)
+    {
+        double times[5] = {};
+
+        times[0] = BandwidthGetTime ();
+        StreamCopy  (c, a, BANDWIDTH_ARRAY_SIZE);
+        times[1] = BandwidthGetTime ();
+        StreamScale (b, c, BANDWIDTH_SCALAR, BANDWIDTH_ARRAY_SIZE);
+        times[2] = BandwidthGetTime ();
+        StreamAdd   (c, a, b, BANDWIDTH_ARRAY_SIZE);
+        times[3] = BandwidthGetTime ();
+        StreamTriad (a, b, c, BANDWIDTH_SCALAR, BANDWIDTH_ARRAY_SIZE);
+        times[4] = BandwidthGetTime ();
+
+        const double bytes[4] = {bytes_two, bytes_two, bytes_three, bytes_three};
+
+        for (size_t kernel = 0; kernel < 4; ++kernel)
+        {
+            const double rate = bytes[kernel] / (times[kernel + 1] - times[kernel]);
+            if (rate > best[kernel]) best[kernel] = rate;
+        }
+    }
+
+    memory_bandwidth.copy  = best[0];
+    memory_bandwidth.scale = best[1];
+    memory_bandwidth.add   = best[2];
+    memory_bandwidth.triad = best[3];
+
+    memory_bandwidth.peak = 0;
+    for (size_t kernel = 0; kernel < 4; ++kernel)
+        if (best[kernel] > memory_bandwidth.peak) memory_bandwidth.peak = best[kernel];
+
+    fprintf (stderr, "memory bandwidth, GB/s: copy %.2lf scale %.2lf add %.2lf triad %.2lf\n",
+             memory_bandwidth.copy  * 1e-9, memory_bandwidth.scale * 1e-9,
+             memory_bandwidth.add   * 1e-9, memory_bandwidth.triad * 1e-9);
+
+    free (a);
+    free (b);
+    free (c);
+}
+
+BANDWIDTH_KERNEL static void
+StreamCopy (double* const a, const double* const b, const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        a[i] = b[i];
+}
+
+BANDWIDTH_KERNEL static void
+StreamScale (double* const a, const double* const b, const double q, const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        a[i] = q * b[i];
+}
+
+BANDWIDTH_KERNEL static void
+StreamAdd (double* const a, const double* const b, const double* const c, const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        a[i] = b[i] + c[i];
+}
+
+BANDWIDTH_KERNEL static void
+StreamTriad (double* const a, const double* const b, const double* const c, const double q,
+             const size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+        a[i] = b[i] + q * c[i];
+}
+
+static double
+BandwidthGetTime (void)
+{
+    struct timespec time = {};
+    clock_gettime (CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
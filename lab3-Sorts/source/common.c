@@ -1,4 +1,9 @@
 #include "../include/common.h"
+#include <unistd.h>
+
+#ifdef SORT_ADVERSARY
+int (*sort_adversary_compare) (const int, const int) = NULL;
+#endif
 
 int int_cmp (void* elem1,
              void* elem2)
@@ -6,6 +11,16 @@ int int_cmp (void* elem1,
     assert (elem1);
     assert (elem2);
 
+    SORT_STATS_COMPARE ();
+
+#ifdef SORT_ADVERSARY
+    if (sort_adversary_compare)
+    {
+        const int result = sort_adversary_compare (*(int*)elem1, *(int*)elem2);
+        return (result > 0) - (result < 0);
+    }
+#endif
+
     if (*(int*)elem1 > *(int*)elem2) return GREATER;
     if (*(int*)elem1 < *(int*)elem2) return LESS;
     return EQUAL;
@@ -17,7 +32,28 @@ int_swap (int* first, int* second)
     assert (first);
     assert (second);
 
+    SORT_STATS_SWAP (2 * sizeof (int));
+
     int temp_value = *second;
     *second = *first;
     *first  = temp_value;
 }
+
+size_t
+SortThreadNumber (const size_t max_threads,
+                  const size_t elem_number,
+                  const size_t min_thread_elem)
+{
+    long cpu_number = sysconf (_SC_NPROCESSORS_ONLN);
+    if (cpu_number < 1) cpu_number = 1;
+
+    size_t thread_number = (size_t) cpu_number;
+
+    if (thread_number > max_threads)
+        thread_number = max_threads;
+
+    if (min_thread_elem > 0 && thread_number > elem_number / min_thread_elem)
+        thread_number = elem_number / min_thread_elem;
+
+    return thread_number;
+}
@@ -0,0 +1,292 @@
+#include "../include/counting_sort.h"
+#include <pthread.h>
+
+/* 1 << 16 counters of uint32_t take 256 KB, which stays in L2 cache */
+const size_t COUNTING_SORT_MAX_RANGE         = 1 << 16;
+/* value range is small if it is not greater than elem_number * factor */
+const size_t COUNTING_SORT_RANGE_FACTOR      = 2;
+/* arrays smaller than this are counted by one thread */
+const size_t COUNTING_SORT_PARALLEL_MIN_ELEM = 1 << 20;
+const size_t COUNTING_SORT_MAX_THREADS       = 8;
+
+/**
+ * @brief Piece of work for one counting sort thread.
+ * @details Threads count their own part of array [elem_from, elem_to)
+ * to their own histogram, then each thread sums all histograms
+ * in bins [bin_from, bin_to) and writes these bins back to array.
+ */
+struct counting_sort_task
+{
+    int*      array;
+    size_t    elem_from;
+    size_t    elem_to;
+
+    uint32_t* histogram;            ///< thread's own histogram.
+    uint32_t* histograms;           ///< all threads' histograms, one by one.
+    uint32_t* total_histogram;
+    size_t    thread_number;
+    size_t    range_size;
+
+    size_t    bin_from;
+    size_t    bin_to;
+    size_t    write_from;           ///< first array index of bin_from values.
+
+    int       min_value;
+};
+
+static void
+CountingSortSerial (int* const     array,
+                    const size_t   elem_number,
+                    const int      min_value,
+                    const size_t   range_size);
+
+static bool
+CountingSortParallel (int* const   array,
+                      const size_t elem_number,
+                      const int    min_value,
+                      const size_t range_size);
+
+static void
+CountingSortRunThreads (void* (*routine) (void*),
+                        struct counting_sort_task* const tasks,
+                        const size_t thread_number);
+
+static void*
+CountingSortCountRoutine (void* task_ptr);
+
+static void*
+CountingSortMergeRoutine (void* task_ptr);
+
+static void*
+CountingSortWriteRoutine (void* task_ptr);
+
+static void
+CountingSortWriteBins (int* const            array,
+                       const uint32_t* const histogram,
+                       const size_t          bin_from,
+                       const size_t          bin_to,
+                       size_t                write_index,
+                       const int             min_value);
+
+void
+CountingSort (int* const   array,
+              const size_t elem_number)
+{
+    if (array == NULL || elem_number <= 1) return;
+
+    int min_value = 0;
+    int max_value = 0;
+
+    sort_kernels.minmax (array, elem_number, &min_value, &max_value);
+
+    const size_t range_size =
+        (size_t) ((long long) max_value - (long long) min_value) + 1;
+
+    if (range_size > COUNTING_SORT_MAX_RANGE                   ||
+        range_size > elem_number * COUNTING_SORT_RANGE_FACTOR  ||
+        elem_number > UINT32_MAX)
+    {
+        QuickHoareSort (array, elem_number);
+        return;
+    }
+
+    if (elem_number >= COUNTING_SORT_PARALLEL_MIN_ELEM &&
+        CountingSortParallel (array, elem_number, min_value, range_size))
+        return;
+
+    CountingSortSerial (array, elem_number, min_value, range_size);
+}
+
+static void
+CountingSortSerial (int* const     array,
+                    const size_t   elem_number,
+                    const int      min_value,
+                    const size_t   range_size)
+{
+    assert (array);
+
+    uint32_t* const histogram =
+        (uint32_t*) calloc (range_size, sizeof (uint32_t));
+    if (histogram == NULL)
+    {
+        QuickHoareSort (array, elem_number);
+        return;
+    }
+
+    for (size_t i = 0; i < elem_number; ++i)
+        histogram[array[i] - min_value]++;
+
+    CountingSortWriteBins (array, histogram, 0, range_size, 0, min_value);
+
+    free (histogram);
+}
+
+/**
+ * @brief Counts histograms in several threads and merges them.
+ * @return false if threads' memory could not be allocated,
+ * so serial version must be used.
+ */
+static bool
+CountingSortParallel (int* const   array,
+                      const size_t elem_number,
+                      const int    min_value,
+                      const size_t range_size)
+{
+    assert (array);
+
+    /* every thread gets at least a half of parallel threshold */
+    const size_t thread_number = SortThreadNumber (COUNTING_SORT_MAX_THREADS, elem_number,
+                                                   COUNTING_SORT_PARALLEL_MIN_ELEM / 2);
+    if (thread_number <= 1) return false;
+
+    struct counting_sort_task* const tasks =
+        (struct counting_sort_task*) calloc (thread_number,
+                                             sizeof (struct counting_sort_task));
+
+    /* all threads' histograms and the total one after them */
+    uint32_t* const histograms =
+        (uint32_t*) calloc ((thread_number + 1) * range_size, sizeof (uint32_t));
+
+    if (tasks == NULL || histograms == NULL)
+    {
+        free (tasks);
+        free (histograms);
+        return false;
+    }
+
+    uint32_t* const total_histogram = histograms + thread_number * range_size;
+
+    const size_t elem_step = elem_number / thread_number;
+    const size_t bin_step  = range_size  / thread_number;
+
+    for (size_t i = 0; i < thread_number; ++i)
+    {
+        tasks[i].array           = array;
+        tasks[i].elem_from       = i * elem_step;
+        tasks[i].elem_to         = (i == thread_number - 1) ?
+                                   elem_number : (i + 1) * elem_step;
+        tasks[i].histogram       = histograms + i * range_size;
+        tasks[i].histograms      = histograms;
+        tasks[i].total_histogram = total_histogram;
+        tasks[i].thread_number   = thread_number;
+        tasks[i].range_size      = range_size;
+        tasks[i].bin_from        = i * bin_step;
+        tasks[i].bin_to          = (i == thread_number - 1) ?
+                                   range_size : (i + 1) * bin_step;
+        tasks[i].min_value       = min_value;
+    }
+
+    CountingSortRunThreads (CountingSortCountRoutine, tasks, thread_number);
+    CountingSortRunThreads (CountingSortMergeRoutine, tasks, thread_number);
+
+    /* prefix sums over thread bins ranges, range_size is small */
+    size_t write_from = 0;
+
+    for (size_t i = 0; i < thread_number; ++i)
+    {
+        tasks[i].write_from = write_from;
+
+        for (size_t bin = tasks[i].bin_from; bin < tasks[i].bin_to; ++bin)
+            write_from += total_histogram[bin];
+    }
+
+    CountingSortRunThreads (CountingSortWriteRoutine, tasks, thread_number);
+
+    free (tasks);
+    free (histograms);
+
+    return true;
+}
+
+/**
+ * @brief Runs routine for every task, one thread per task.
+ * @details If a thread can't be created, its task is done by the caller.
+ */
+static void
+CountingSortRunThreads (void* (*routine) (void*),
+                        struct counting_sort_task* const tasks,
+                        const size_t thread_number)
+{
+    assert (routine);
+    assert (tasks);
+
+    pthread_t threads[COUNTING_SORT_MAX_THREADS];
+    bool      started[COUNTING_SORT_MAX_THREADS];
+
+    for (size_t i = 1; i < thread_number; ++i)
+        started[i] = pthread_create (&threads[i], NULL, routine, &tasks[i]) == 0;
+
+    routine (&tasks[0]);
+
+    for (size_t i = 1; i < thread_number; ++i)
+    {
+        if (started[i]) pthread_join (threads[i], NULL);
+        else routine (&tasks[i]);
+    }
+}
+
+static void*
+CountingSortCountRoutine (void* task_ptr)
+{
+    assert (task_ptr);
+    struct counting_sort_task* const task = (struct counting_sort_task*) task_ptr;
+
+    const int*      const array     = task->array;
+    uint32_t*       const histogram = task->histogram;
+    const int             min_value = task->min_value;
+
+    for (size_t i = task->elem_from; i < task->elem_to; ++i)
+        histogram[array[i] - min_value]++;
+
+    return NULL;
+}
+
+static void*
+CountingSortMergeRoutine (void* task_ptr)
+{
+    assert (task_ptr);
+    struct counting_sort_task* const task = (struct counting_sort_task*) task_ptr;
+
+    for (size_t i = 0; i < task->thread_number; ++i)
+    {
+        const uint32_t* const histogram = task->histograms + i * task->range_size;
+
+        for (size_t bin = task->bin_from; bin < task->bin_to; ++bin)
+            task->total_histogram[bin] += histogram[bin];
+    }
+
+    return NULL;
+}
+
+static void*
+CountingSortWriteRoutine (void* task_ptr)
+{
+    assert (task_ptr);
+    struct counting_sort_task* const task = (struct counting_sort_task*) task_ptr;
+
+    CountingSortWriteBins (task->array, task->total_histogram,
+                           task->bin_from, task->bin_to,
+                           task->write_from, task->min_value);
+
+    return NULL;
+}
+
+static void
+CountingSortWriteBins (int* const            array,
+                       const uint32_t* const histogram,
+                       const size_t          bin_from,
+                       const size_t          bin_to,
+                       size_t                write_index,
+                       const int             min_value)
+{
+    assert (array);
+    assert (histogram);
+
+    for (size_t bin = bin_from; bin < bin_to; ++bin)
+    {
+        const int value = (int) ((long long) min_value + (long long) bin);
+
+        for (uint32_t i = 0; i < histogram[bin]; ++i)
+            array[write_index++] = value;
+    }
+}
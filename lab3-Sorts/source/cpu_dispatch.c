@@ -0,0 +1,126 @@
+#include "../include/cpu_dispatch.h"
+#include "../include/simd_kernels.h"
+#include "../include/segmented_sort.h"
+#include "../include/mergesort.h"
+#include <string.h>
+
+/* name of environment variable that forces variant */
+static const char* const CPU_DISPATCH_ENV_NAME = "SORT_CPU_VARIANT";
+
+static const char* const cpu_variant_names[CPU_VARIANT_NUMBER] =
+{
+    "generic",
+    "sse4.2",
+    "avx2",
+    "avx512"
+};
+
+static const struct sort_kernels cpu_variant_kernels[CPU_VARIANT_NUMBER] =
+{
+    {MinMaxGeneric, CountLessGeneric, PartitionGeneric, MergeSortedArrays, NetworkSort},
+    {MinMaxSse42,   CountLessSse42,   PartitionSse42,   MergeSse42,        NetworkSortSse42},
+    {MinMaxAvx2,    CountLessAvx2,    PartitionAvx2,    MergeAvx2,         NetworkSortAvx2},
+    {MinMaxAvx512,  CountLessAvx512,  PartitionAvx512,  MergeAvx512,       NetworkSortAvx512}
+};
+
+/* generic until CpuDispatchInit(), so kernels may be called at any time */
+struct sort_kernels sort_kernels =
+    {MinMaxGeneric, CountLessGeneric, PartitionGeneric, MergeSortedArrays, NetworkSort};
+
+static enum cpu_variant cpu_variant = CPU_VARIANT_GENERIC;
+
+static enum cpu_variant
+CpuDispatchBestVariant (void);
+
+static enum cpu_variant
+CpuDispatchParseVariant (const char* const name);
+
+__attribute__ ((constructor)) void
+CpuDispatchInit (void)
+{
+    __builtin_cpu_init ();
+
+    enum cpu_variant variant = CpuDispatchBestVariant ();
+
+    const char* const env_variant = getenv (CPU_DISPATCH_ENV_NAME);
+
+    if (env_variant != NULL)
+    {
+        const enum cpu_variant forced = CpuDispatchParseVariant (env_variant);
+
+        if (forced != CPU_VARIANT_NUMBER && CpuDispatchSupported (forced))
+            variant = forced;
+    }
+
+    CpuDispatchForce (variant);
+}
+
+cpu_dispatch_error_t
+CpuDispatchForce (const enum cpu_variant variant)
+{
+    if (variant >= CPU_VARIANT_NUMBER || !CpuDispatchSupported (variant))
+        return CPU_DISPATCH_ERROR;
+
+    sort_kernels = cpu_variant_kernels[variant];
+    cpu_variant  = variant;
+
+    return CPU_DISPATCH_SUCCESS;
+}
+
+/**
+ * @details __builtin_cpu_supports() also checks that OS saves
+ * AVX and AVX-512 registers on context switch.
+ */
+bool
+CpuDispatchSupported (const enum cpu_variant variant)
+{
+    switch (variant)
+    {
+        case CPU_VARIANT_GENERIC: return true;
+        case CPU_VARIANT_SSE42:   return __builtin_cpu_supports ("sse4.2");
+        case CPU_VARIANT_AVX2:    return __builtin_cpu_supports ("avx2");
+        case CPU_VARIANT_AVX512:  return __builtin_cpu_supports ("avx512f");
+
+        case CPU_VARIANT_NUMBER:
+        default:                  return false;
+    }
+}
+
+enum cpu_variant
+CpuDispatchVariant (void)
+{
+    return cpu_variant;
+}
+
+const char*
+CpuDispatchVariantName (const enum cpu_variant variant)
+{
+    if (variant >= CPU_VARIANT_NUMBER) return "unknown";
+
+    return cpu_variant_names[variant];
+}
+
+static enum cpu_variant
+CpuDispatchBestVariant (void)
+{
+    for (int variant = CPU_VARIANT_NUMBER - 1; variant > CPU_VARIANT_GENERIC; --variant)
+        if (CpuDispatchSupported ((enum cpu_variant) variant))
+            return (enum cpu_variant) variant;
+
+    return CPU_VARIANT_GENERIC;
+}
+
+/**
+ * @return Variant with given name or CPU_VARIANT_NUMBER if there is no such.
+ */
+static enum cpu_variant
+CpuDispatchParseVariant (const char* const name)
+{
+    assert (name);
+
+    for (size_t variant = 0; variant < CPU_VARIANT_NUMBER; ++variant)
+        if (strcmp (name, cpu_variant_names[variant]) == 0)
+            return (enum cpu_variant) variant;
+
+    return CPU_VARIANT_NUMBER;
+}
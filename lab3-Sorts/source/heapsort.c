@@ -16,6 +16,61 @@ HeapSortInitHeap (int* const array,
                   const size_t elem_number,
                   const size_t heap_k_value);
 
+/**
+ * @brief Makes dynamic array over given array, like HeapSortInitHeap().
+ */
+static struct dynamic_array*
+HeapSortInitArray (int* const   array,
+                   const size_t elem_number);
+
+static void
+HeapSortGeneric (int* const   array,
+                 const size_t elem_number,
+                 const size_t heap_k_value);
+
+/**
+ * Defines int max-heap IntMaxHeap<arity> and HeapSort<arity>() using it,
+ * the loop is the one of HeapSortGeneric().
+ */
+#define HEAP_SORT_DEFINE(arity)                                                 \
+                                                                                \
+K_HEAP_TYPED_DEFINE (IntMaxHeap##arity, int, arity, INT_GREATER (a, b))         \
+                                                                                \
+static void                                                                     \
+HeapSort##arity (int* const   array,                                            \
+                 const size_t elem_number)                                      \
+{                                                                               \
+    struct dynamic_array* const d_array =                                       \
+        HeapSortInitArray (array, elem_number);                                 \
+    assert (d_array);                                                           \
+                                                                                \
+    struct IntMaxHeap##arity* const heap =                                      \
+        IntMaxHeap##arity##Constructor (d_array);                               \
+    assert (heap);                                                              \
+                                                                                \
+    int root_value = 0;                                                         \
+                                                                                \
+    for (size_t i = 0; i < elem_number; ++i)                                    \
+    {                                                                           \
+        IntMaxHeap##arity##ExtractRoot (heap, &root_value);                     \
+                                                                                \
+        int* const root_place = (int*) DynamicArrayEmplace (heap->d_array);     \
+        assert (root_place);                                                    \
+        *root_place = root_value;                                               \
+        SORT_STATS_MOVE (sizeof (int));                                         \
+        heap->d_array->data_array_size--;                                       \
+    }                                                                           \
+                                                                                \
+    heap->d_array->data_array_size = elem_number;                               \
+    IntMaxHeap##arity##Destructor (heap);                                       \
+}
+
+HEAP_SORT_DEFINE (2)
+HEAP_SORT_DEFINE (3)
+HEAP_SORT_DEFINE (4)
+HEAP_SORT_DEFINE (5)
+HEAP_SORT_DEFINE (6)
+
 void
 HeapSort (int* const   array,
           const size_t elem_number,
@@ -23,6 +78,24 @@ HeapSort (int* const   array,
 {
     if (array == NULL) return;
 
+    switch (heap_k_value)
+    {
+        case K_2: HeapSort2 (array, elem_number); break;
+        case K_3: HeapSort3 (array, elem_number); break;
+        case K_4: HeapSort4 (array, elem_number); break;
+        case K_5: HeapSort5 (array, elem_number); break;
+        case K_6: HeapSort6 (array, elem_number); break;
+
+        default:
+            HeapSortGeneric (array, elem_number, heap_k_value);
+    }
+}
+
+static void
+HeapSortGeneric (int* const   array,
+                 const size_t elem_number,
+                 const size_t heap_k_value)
+{
     struct k_heap* const heap =
         HeapSortInitHeap (array, elem_number, heap_k_value);
     assert (heap);
@@ -32,7 +105,12 @@ HeapSort (int* const   array,
     for (size_t i = 0; i < elem_number; ++i)
     {
         KHeapExtractRoot (heap, &root_value);
-        DynamicArrayPush (heap->d_array, &root_value);
+
+        /* place freed by extraction, realloc is disabled and not needed */
+        int* const root_place = (int*) DynamicArrayEmplace (heap->d_array);
+        assert (root_place);
+        *root_place = root_value;
+        SORT_STATS_MOVE (sizeof (int));
         heap->d_array->data_array_size--;
     }
 
@@ -40,6 +118,13 @@ HeapSort (int* const   array,
     KHeapDestructor (heap);
 }
 
+void
+TwoHeapSort (int* const   array,
+             const size_t elem_number)
+{
+    HeapSort (array, elem_number, K_2);
+}
+
 static struct k_heap*
 HeapSortInitHeap (int* const array,
                   const size_t elem_number,
@@ -47,11 +132,32 @@ HeapSortInitHeap (int* const array,
 {
     assert (array);
 
+    struct dynamic_array* const d_array = HeapSortInitArray (array, elem_number);
+    if (d_array == NULL) return NULL;
+
+    int infinite_value = INT_MAX;
+
+    struct k_heap* const heap =
+        KHeapConstructor (d_array, heap_k_value, sizeof (int),
+                          &infinite_value, int_cmp);
+
+    if (heap == NULL)
+        DynamicArrayDestructor (d_array);
+
+    return heap;
+}
+
+static struct dynamic_array*
+HeapSortInitArray (int* const   array,
+                   const size_t elem_number)
+{
+    assert (array);
+
     /**
      * Make dynamic array of null size, that doesn't do realloc during push/pop
      * and saves data_array field after destruction.
      */
-    struct dynamic_array* d_array =
+    struct dynamic_array* const d_array =
         DynamicArrayConstructor (DYNAMIC_ARRAY_NULL_SIZE, sizeof (int),
                                  DYNAMIC_ARRAY_REALLOC_DISABLED,
                                  DYNAMIC_ARRAY_SAVE);
@@ -61,14 +167,5 @@ HeapSortInitHeap (int* const array,
     d_array->data_array_capacity = elem_number;
     d_array->data_array_size     = elem_number;
 
-    int infinite_value = INT_MAX;
-
-    struct k_heap* const heap =
-        KHeapConstructor (d_array, heap_k_value, sizeof (int),
-                          &infinite_value, int_cmp);
-
-    if (heap == NULL)
-        DynamicArrayDestructor (d_array);
-
-    return heap;
+    return d_array;
 }
@@ -0,0 +1,210 @@
+#include "../include/learned_sort.h"
+
+/* smaller arrays are sorted by quick sort */
+const size_t LEARNED_SORT_MIN_SIZE        = 1 << 12;
+const size_t LEARNED_SORT_MIN_SAMPLE_SIZE = 1 << 10;
+/* sample is 1 / LEARNED_SORT_SAMPLE_RATIO of array */
+const size_t LEARNED_SORT_SAMPLE_RATIO    = 100;
+/* expected number of elements in a bucket */
+const size_t LEARNED_SORT_BUCKET_SIZE     = 32;
+/* buckets up to this size are sorted by insertion sort, bigger by quick sort */
+const size_t LEARNED_SORT_INSERTION_MAX   = 64;
+/* segments of piecewise-linear CDF, knots fit in L1 cache */
+#define LEARNED_SORT_SEGMENT_NUMBER 256
+
+/**
+ * @brief Piecewise-linear CDF: knots[i] is the key with CDF i / segment_number.
+ */
+struct cdf_model
+{
+    int    knots [LEARNED_SORT_SEGMENT_NUMBER + 1];
+    double slopes[LEARNED_SORT_SEGMENT_NUMBER];     ///< buckets per key in segment.
+    size_t bucket_number;
+};
+
+static bool
+CdfModelTrain (struct cdf_model* const model,
+               const int* const        array,
+               const size_t            elem_number,
+               const size_t            bucket_number);
+
+static inline size_t
+CdfModelPredict (const struct cdf_model* const model,
+                 const int                     key);
+
+static void
+LearnedSortBucket (int* const   bucket,
+                   const size_t elem_number);
+
+void
+LearnedSort (int* const   array,
+             const size_t elem_number)
+{
+    if (array == NULL || elem_number <= 1) return;
+
+    if (elem_number < LEARNED_SORT_MIN_SIZE || elem_number > UINT32_MAX)
+    {
+        QuickHoareSort (array, elem_number);
+        return;
+    }
+
+    const size_t bucket_number = elem_number / LEARNED_SORT_BUCKET_SIZE;
+
+    struct cdf_model* const model   = (struct cdf_model*) malloc (sizeof (struct cdf_model));
+    int*      const buffer          = (int*)      malloc (elem_number * sizeof (int));
+    uint32_t* const element_buckets = (uint32_t*) malloc (elem_number * sizeof (uint32_t));
+    size_t*   const bucket_begins   = (size_t*)   calloc (bucket_number + 1, sizeof (size_t));
+
+    if (model == NULL || buffer == NULL || element_buckets == NULL || bucket_begins == NULL ||
+        !CdfModelTrain (model, array, elem_number, bucket_number))
+    {
+        free (model);
+        free (buffer);
+        free (element_buckets);
+        free (bucket_begins);
+        QuickHoareSort (array, elem_number);
+        return;
+    }
+
+    /* predict once, count bucket sizes */
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        const size_t bucket = CdfModelPredict (model, array[i]);
+
+        element_buckets[i] = (uint32_t) bucket;
+        bucket_begins[bucket + 1]++;
+    }
+
+    for (size_t bucket = 0; bucket < bucket_number; ++bucket)
+        bucket_begins[bucket + 1] += bucket_begins[bucket];
+
+    /* scatter, bucket_begins[b] becomes end of bucket b - 1 */
+    for (size_t i = 0; i < elem_number; ++i)
+        buffer[bucket_begins[element_buckets[i]]++] = array[i];
+
+    size_t bucket_begin = 0;
+
+    for (size_t bucket = 0; bucket < bucket_number; ++bucket)
+    {
+        const size_t bucket_end = bucket_begins[bucket];
+
+        LearnedSortBucket (buffer + bucket_begin, bucket_end - bucket_begin);
+        bucket_begin = bucket_end;
+    }
+
+    memcpy (array, buffer, elem_number * sizeof (int));
+
+    free (model);
+    free (buffer);
+    free (element_buckets);
+    free (bucket_begins);
+}
+
+/**
+ * @brief Sorts evenly spaced sample and takes its quantiles as knots.
+ */
+static bool
+CdfModelTrain (struct cdf_model* const model,
+               const int* const        array,
+               const size_t            elem_number,
+               const size_t            bucket_number)
+{
+    assert (model);
+    assert (array);
+    assert (bucket_number > 0);
+
+    size_t sample_size = elem_number / LEARNED_SORT_SAMPLE_RATIO;
+    if (sample_size < LEARNED_SORT_MIN_SAMPLE_SIZE) sample_size = LEARNED_SORT_MIN_SAMPLE_SIZE;
+    if (sample_size > elem_number)                  sample_size = elem_number;
+
+    int* const sample = (int*) malloc (sample_size * sizeof (int));
+    if (sample == NULL) return false;
+
+    const size_t stride = elem_number / sample_size;
+
+    for (size_t i = 0; i < sample_size; ++i)
+        sample[i] = array[i * stride];
+
+    RadixSort (sample, sample_size);
+
+    for (size_t i = 0; i < LEARNED_SORT_SEGMENT_NUMBER; ++i)
+        model->knots[i] = sample[i * sample_size / LEARNED_SORT_SEGMENT_NUMBER];
+
+    model->knots[LEARNED_SORT_SEGMENT_NUMBER] = sample[sample_size - 1];
+
+    model->bucket_number = bucket_number;
+
+    /* segments between equal knots are never used */
+    const double scale = (double) bucket_number / LEARNED_SORT_SEGMENT_NUMBER;
+
+    for (size_t i = 0; i < LEARNED_SORT_SEGMENT_NUMBER; ++i)
+        model->slopes[i] = (model->knots[i + 1] > model->knots[i]) ?
+                           scale / ((double) model->knots[i + 1] - (double) model->knots[i]) : 0;
+
+    free (sample);
+
+    return true;
+}
+
+/**
+ * @brief Bucket of key: segment is found by branchless binary search
+ * over knots, position inside segment is linear interpolation.
+ * @details Non-decreasing in key, so keys of bucket b are not greater than keys of b + 1.
+ */
+static inline size_t
+CdfModelPredict (const struct cdf_model* const model,
+                 const int                     key)
+{
+    assert (model);
+
+    const int* const knots = model->knots;
+
+    if (key <  knots[0])                           return 0;
+    if (key >= knots[LEARNED_SORT_SEGMENT_NUMBER]) return model->bucket_number - 1;
+
+    /* last knot <= key, knots[segment + 1] > key */
+    size_t segment = 0;
+
+    for (size_t step = LEARNED_SORT_SEGMENT_NUMBER / 2; step > 0; step /= 2)
+        segment += (knots[segment + step] <= key) ? step : 0;
+
+    const size_t segment_first_bucket = segment * model->bucket_number / LEARNED_SORT_SEGMENT_NUMBER;
+
+    const size_t bucket = segment_first_bucket +
+        (size_t) (((double) key - (double) knots[segment]) * model->slopes[segment]);
+
+    return (bucket < model->bucket_number) ? bucket : model->bucket_number - 1;
+}
+
+static void
+LearnedSortBucket (int* const   bucket,
+                   const size_t elem_number)
+{
+    assert (bucket || elem_number == 0);
+
+    if (elem_number <= SORT_KERNELS_NETWORK_MAX_SIZE)
+    {
+        sort_kernels.network_sort (bucket, elem_number);
+        return;
+    }
+
+    if (elem_number > LEARNED_SORT_INSERTION_MAX)
+    {
+        QuickHoareSort (bucket, elem_number);
+        return;
+    }
+
+    for (size_t i = 1; i < elem_number; ++i)
+    {
+        const int cur_elem = bucket[i];
+        size_t j = i;
+
+        while (j > 0 && bucket[j - 1] > cur_elem)
+        {
+            bucket[j] = bucket[j - 1];
+            j--;
+        }
+
+        bucket[j] = cur_elem;
+    }
+}
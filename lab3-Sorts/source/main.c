@@ -67,8 +67,169 @@ int main (void)
 //     TestSort ("tests/test_most_dublicates", "output/thick_dub.txt",
 //               0, 1000000, 10000, 1, QuickThickSort);
 
-    TestSort ("tests/big_tests", "output/hoare_less_rec.txt",
-              0, 1000000, 10000, 1, QuickOneRecursionBranchSort);
+//     TestSort ("tests/big_tests", "output/hoare_less_rec.txt",
+//               0, 1000000, 10000, 1, QuickOneRecursionBranchSort);
+
+//     TestSort ("tests/test_most_dublicates", "output/counting_dub.txt",
+//               0, 1000000, 10000, 1, CountingSort);
+
+//     TestSort ("tests/big_tests", "output/bentley_mcilroy.txt",
+//               0, 1000000, 10000, 1, QuickBentleyMcIlroySort);
+//
+//     TestSort ("tests/test_most_dublicates", "output/bentley_mcilroy_dub.txt",
+//               0, 1000000, 10000, 1, QuickBentleyMcIlroySort);
+
+//     PivotSetStrategy (PIVOT_MIDDLE);
+//     TestSort ("tests/big_tests", "output/hoare_middle.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     PivotSetStrategy (PIVOT_MEDIAN_3);
+//     TestSort ("tests/big_tests", "output/hoare_median3.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     PivotSetStrategy (PIVOT_RANDOM_MEDIAN_3);
+//     TestSort ("tests/big_tests", "output/hoare_random_median3.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     PivotSetStrategy (PIVOT_NINTHER);
+//     TestSort ("tests/big_tests", "output/hoare_ninther.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     PivotSetStrategy (PIVOT_SAMPLE_MEDIAN);
+//     TestSort ("tests/big_tests", "output/hoare_sample_median.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     PivotSetStrategy (PIVOT_MIDDLE);
+
+//     TestSort ("tests/worst_sorted", "output/hoare_sorted.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     TestSort ("tests/worst_reversed", "output/hoare_reversed.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     TestSort ("tests/worst_organ_pipe", "output/hoare_organ_pipe.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     TestSort ("tests/worst_antiqsort", "output/hoare_antiqsort.txt",
+//               0, 20000, 500, 1, QuickHoareSort);
+//
+//     TestSort ("tests/worst_antiqsort", "output/mergeit_antiqsort.txt",
+//               0, 20000, 500, 1, MergeIterativeSort);
+
+//     TestStringSort ("output/multikey.txt",
+//                     0, 1000000, 10000, 1, MultikeyQuickSort);
+//
+//     TestStringSort ("output/burstsort.txt",
+//                     0, 1000000, 10000, 1, BurstSort);
+
+//     TestSegmentedSort ("output/segmented_tiny.txt",
+//                        2, 16, 0, 100000, 1000, 1);
+//
+//     TestSegmentedSort ("output/segmented_small.txt",
+//                        10, 500, 0, 10000, 100, 1);
+
+//     TestSortedRuns ("output/sorted_runs_batch_100.txt",
+//                     SORTED_RUNS_DEFAULT_FAN_OUT, 100, 0, 1000000, 10000, 1);
+//
+//     TestSortedRuns ("output/sorted_runs_batch_10000.txt",
+//                     SORTED_RUNS_DEFAULT_FAN_OUT, 10000, 0, 1000000, 10000, 1);
+
+//     TestSortCount ("tests/test_most_dublicates", "output/sort_count_dub.txt",
+//                    0, 1000000, 10000, 1);
+//
+//     TestSortCount ("tests/big_tests", "output/sort_count.txt",
+//                    0, 1000000, 10000, 1);
+
+//     TestStreamSort ("tests/big_tests", "output/stream_sort.txt",
+//                     0, 1000000, 10000, 1);
+
+//     fprintf (stderr, "SIMD kernels: %s\n", CpuDispatchVariantName (CpuDispatchVariant ()));
+//
+//     CpuDispatchForce (CPU_VARIANT_GENERIC);
+//     TestSort ("tests/big_tests", "output/kernel_generic.txt",
+//               0, 1000000, 10000, 1, QuickKernelSort);
+//
+//     CpuDispatchForce (CPU_VARIANT_SSE42);
+//     TestSort ("tests/big_tests", "output/kernel_sse42.txt",
+//               0, 1000000, 10000, 1, QuickKernelSort);
+//
+//     CpuDispatchForce (CPU_VARIANT_AVX2);
+//     TestSort ("tests/big_tests", "output/kernel_avx2.txt",
+//               0, 1000000, 10000, 1, QuickKernelSort);
+//
+//     CpuDispatchForce (CPU_VARIANT_AVX512);
+//     TestSort ("tests/big_tests", "output/kernel_avx512.txt",
+//               0, 1000000, 10000, 1, QuickKernelSort);
+//
+//     CpuDispatchInit ();
+
+//     TestRecordSort ("output/record_sort.txt", true,
+//                     0, 1000000, 10000, 1);
+//
+//     TestRecordSort ("output/record_sort_name_middle.txt", false,
+//                     0, 1000000, 10000, 1);
+
+//     TaskSchedulerResetStats (TaskSchedulerDefault ());
+//     TestSort ("tests/big_tests", "output/parallel_qsort.txt",
+//               0, 1000000, 10000, 1, ParallelQuickSort);
+//     TaskSchedulerDumpStats  (TaskSchedulerDefault (), stderr);
+
+//     TestSort ("tests/big_tests", "output/learned.txt",
+//               0, 1000000, 10000, 1, LearnedSort);
+//
+//     TestSort ("tests/big_tests", "output/radix.txt",
+//               0, 1000000, 10000, 1, RadixSort);
+//
+//     TestSort ("tests/skewed_exponential", "output/learned_exponential.txt",
+//               0, 1000000, 10000, 1, LearnedSort);
+//
+//     TestSort ("tests/skewed_exponential", "output/radix_exponential.txt",
+//               0, 1000000, 10000, 1, RadixSort);
+//
+//     TestSort ("tests/skewed_exponential", "output/hoare_exponential.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+//
+//     TestSort ("tests/skewed_power", "output/learned_power.txt",
+//               0, 1000000, 10000, 1, LearnedSort);
+//
+//     TestSort ("tests/skewed_power", "output/radix_power.txt",
+//               0, 1000000, 10000, 1, RadixSort);
+//
+//     TestSort ("tests/skewed_power", "output/hoare_power.txt",
+//               0, 1000000, 10000, 1, QuickHoareSort);
+
+//     TaskSchedulerResetStats (TaskSchedulerDefault ());
+//     TestSort ("tests/big_tests", "output/parallel_radix.txt",
+//               0, 1000000, 10000, 1, ParallelRadixSort);
+//     TaskSchedulerDumpStats  (TaskSchedulerDefault (), stderr);
+//
+//     TestSort ("tests/big_tests", "output/radix.txt",
+//               0, 1000000, 10000, 1, RadixSort);
+
+//     // make SORT_STATS=1 SORT_CMP_COST=100 to compare on expensive comparisons
+//     TestSort ("tests/medium_tests", "output/weak_heap.txt",
+//               0, 100000, 1000, 1, WeakHeapIntSort);
+//
+//     TestSort ("tests/medium_tests", "output/2heapsort.txt",
+//               0, 100000, 1000, 1, TwoHeapSort);
+//
+//     TestSort ("tests/medium_tests", "output/mergerec_medium.txt",
+//               0, 100000, 1000, 1, MergeRecursiveSort);
+
+//     TestKHeapTyped ("output/k_heap_typed_2.txt", K_2, 0, 100000, 1000, 1);
+//
+//     TestKHeapTyped ("output/k_heap_typed_3.txt", K_3, 0, 100000, 1000, 1);
+//
+//     TestKHeapTyped ("output/k_heap_typed_4.txt", K_4, 0, 100000, 1000, 1);
+
+    TestDynamicArrayPush ("output/push_heap.txt",    DYNAMIC_ARRAY_MEMORY_HEAP,
+                          0, 10000000, 100000, 1);
+
+    TestDynamicArrayPush ("output/push_aligned.txt", DYNAMIC_ARRAY_MEMORY_ALIGNED,
+                          0, 10000000, 100000, 1);
+
+    TestDynamicArrayPush ("output/push_large.txt",   DYNAMIC_ARRAY_MEMORY_LARGE,
+                          0, 10000000, 100000, 1);
 
     return 0;
 }
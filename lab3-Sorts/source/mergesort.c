@@ -61,11 +61,15 @@ MergeSortRecursion (int* const   array,
 
     if (right_index - left_index <= 1) return;
 
+    SORT_STATS_ENTER ();
+
     size_t mid_index = (left_index + right_index) / 2;
 
     MergeSortRecursion (array, temp_array, left_index, mid_index);
     MergeSortRecursion (array, temp_array, mid_index,  right_index);
     MergeParts (array, temp_array, left_index, mid_index, right_index);
+
+    SORT_STATS_LEAVE ();
 }
 
 static void
@@ -79,25 +83,44 @@ MergeParts (int* const   array,
     assert (temp_array);
     assert (left_index <= right_index);
 
-    size_t first_part_i  = left_index;   // [left, mid)  iterator
-    size_t second_part_i = mid_index;    // [mid, right) iterator
-    bool copy_left_part = false;
+    MergeSortedArrays (array + left_index, mid_index   - left_index,
+                       array + mid_index,  right_index - mid_index,
+                       temp_array + left_index);
 
     for (size_t i = left_index; i < right_index; ++i)
+        array[i] = temp_array[i];
+
+    /* every element is copied to temp_array and back */
+    SORT_STATS_MOVE (2 * (right_index - left_index) * sizeof (int));
+}
+
+void
+MergeSortedArrays (const int* const first,
+                   const size_t     first_size,
+                   const int* const second,
+                   const size_t     second_size,
+                   int* const       dest)
+{
+    assert (first_size  == 0 || first);
+    assert (second_size == 0 || second);
+    assert (dest);
+
+    size_t first_part_i  = 0;
+    size_t second_part_i = 0;
+    bool copy_left_part = false;
+
+    for (size_t i = 0; i < first_size + second_size; ++i)
     {
-        copy_left_part = first_part_i  <  mid_index   &&
-                        (second_part_i >= right_index ||
-                         array[first_part_i] < array[second_part_i]);
+        copy_left_part = first_part_i  <  first_size   &&
+                        (second_part_i >= second_size ||
+                         INT_LESS (first[first_part_i], second[second_part_i]));
 
         if (copy_left_part)
-            temp_array[i] = array[first_part_i++];
-        
+            dest[i] = first[first_part_i++];
+
         else
-            temp_array[i] = array[second_part_i++];
+            dest[i] = second[second_part_i++];
     }
-
-    for (size_t i = left_index; i < right_index; ++i)
-        array[i] = temp_array[i];
 }
 
 static size_t
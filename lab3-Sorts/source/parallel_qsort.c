@@ -0,0 +1,76 @@
+#include "../include/parallel_qsort.h"
+
+/* smaller parts are not worth a task */
+const size_t PARALLEL_QSORT_MIN_TASK_SIZE = 1 << 14;
+
+/**
+ * @brief Range [left_index, right_index] sorted by one task.
+ */
+struct parallel_qsort_task
+{
+    int*   array;
+    size_t left_index;
+    size_t right_index;
+};
+
+static void
+ParallelQuickSortTask (void* task_ptr);
+
+void
+ParallelQuickSort (int* const   array,
+                   const size_t elem_number)
+{
+    ParallelQuickSortWithScheduler (TaskSchedulerDefault (), array, elem_number);
+}
+
+void
+ParallelQuickSortWithScheduler (struct task_scheduler* const scheduler,
+                                int* const                   array,
+                                const size_t                 elem_number)
+{
+    if (array == NULL || elem_number == 0) return;
+
+    struct parallel_qsort_task root = {array, 0, elem_number - 1};
+
+    if (scheduler == NULL || elem_number < PARALLEL_QSORT_MIN_TASK_SIZE ||
+        TaskSchedulerRun (scheduler, ParallelQuickSortTask, &root) != TASK_SCHEDULER_SUCCESS)
+        QuickHoareSort (array, elem_number);
+}
+
+static void
+ParallelQuickSortTask (void* task_ptr)
+{
+    assert (task_ptr);
+    struct parallel_qsort_task range = *(struct parallel_qsort_task*) task_ptr;
+
+    /* tasks and their ranges live on this frame until sync */
+    struct task_group          group = {};
+    struct task                tasks      [sizeof (size_t) * 8];
+    struct parallel_qsort_task task_ranges[sizeof (size_t) * 8];
+    size_t                     task_number = 0;
+
+    /* the bigger part is spawned, the range at least halves, so there are
+       at most log2 (n) tasks, and thieves take big pieces of work */
+    while (range.right_index - range.left_index + 1 >= PARALLEL_QSORT_MIN_TASK_SIZE)
+    {
+        const size_t mid_index =
+            HoarePartition (range.array, range.left_index, range.right_index);
+
+        struct parallel_qsort_task left  = {range.array, range.left_index, mid_index};
+        struct parallel_qsort_task right = {range.array, mid_index + 1, range.right_index};
+
+        const bool left_smaller = (mid_index - range.left_index) < (range.right_index - mid_index);
+
+        task_ranges[task_number] = left_smaller ? right : left;
+        range                    = left_smaller ? left  : right;
+
+        TaskSpawn (&group, &tasks[task_number], ParallelQuickSortTask,
+                   &task_ranges[task_number]);
+        task_number++;
+    }
+
+    QuickHoareSort (range.array + range.left_index,
+                    range.right_index - range.left_index + 1);
+
+    TaskSync (&group);
+}
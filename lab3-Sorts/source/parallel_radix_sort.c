@@ -0,0 +1,352 @@
+#include "../include/parallel_radix_sort.h"
+
+#define PARALLEL_RADIX_DIGIT_NUMBER 4
+#define PARALLEL_RADIX_BIN_NUMBER   256
+#define PARALLEL_RADIX_CACHE_LINE   64
+/* elements in one write-combining buffer */
+#define PARALLEL_RADIX_WC_SIZE      (PARALLEL_RADIX_CACHE_LINE / sizeof (int))
+
+/* smaller arrays are sorted by RadixSort() */
+const size_t   PARALLEL_RADIX_MIN_SIZE       = 1 << 16;
+/* blocks are not made smaller than this, so few elements don't use all workers */
+const size_t   PARALLEL_RADIX_MIN_BLOCK_SIZE = 1 << 14;
+const size_t   PARALLEL_RADIX_DIGIT_BITS     = 8;
+const uint32_t PARALLEL_RADIX_SIGN_BIT       = 0x80000000u;
+
+/**
+ * @brief Step of the sort done by every block task.
+ */
+enum parallel_radix_phase
+{
+    PARALLEL_RADIX_COUNT_ALL = 0,   ///< Histograms of all digits, before any scatter.
+    PARALLEL_RADIX_COUNT     = 1,   ///< Histogram of current digit.
+    PARALLEL_RADIX_SCATTER   = 2,   ///< Scatter by current digit from "from" to "to".
+    PARALLEL_RADIX_COPY      = 3    ///< Copy block from "from" to "to".
+};
+
+struct parallel_radix_sort;
+
+/**
+ * @brief Block [begin, end) of the array and scratch of the task sorting it.
+ */
+struct parallel_radix_block
+{
+    _Alignas (PARALLEL_RADIX_CACHE_LINE)
+    int                         wc_buffers[PARALLEL_RADIX_BIN_NUMBER][PARALLEL_RADIX_WC_SIZE];
+    uint32_t                    wc_fill   [PARALLEL_RADIX_BIN_NUMBER];
+    uint32_t                    wc_limit  [PARALLEL_RADIX_BIN_NUMBER];
+
+    size_t                      counts [PARALLEL_RADIX_DIGIT_NUMBER][PARALLEL_RADIX_BIN_NUMBER];
+    size_t                      offsets[PARALLEL_RADIX_BIN_NUMBER];
+
+    struct parallel_radix_sort* sort;
+    size_t                      begin;
+    size_t                      end;
+    struct task                 task;
+};
+
+/**
+ * @brief State of one ParallelRadixSort() call shared by block tasks.
+ */
+struct parallel_radix_sort
+{
+    int*                         array;
+    int*                         buffer;
+    size_t                       elem_number;
+
+    struct parallel_radix_block* blocks;
+    size_t                       block_number;
+
+    enum parallel_radix_phase    phase;
+    size_t                       digit;
+    const int*                   from;
+    int*                         to;
+};
+
+static void
+ParallelRadixSortRoot (void* sort_ptr);
+
+static void
+ParallelRadixRunPhase (struct parallel_radix_sort* const sort,
+                       const enum parallel_radix_phase   phase);
+
+static void
+ParallelRadixBlockTask (void* block_ptr);
+
+static void
+ParallelRadixScatter (struct parallel_radix_block* const block,
+                      const int* const                   from,
+                      int* const                         to,
+                      const size_t                       digit);
+
+static inline uint32_t
+ParallelRadixKey (const int value);
+
+static inline size_t
+ParallelRadixDigit (const uint32_t key,
+                    const size_t   digit);
+
+void
+ParallelRadixSort (int* const   array,
+                   const size_t elem_number)
+{
+    ParallelRadixSortWithScheduler (TaskSchedulerDefault (), array, elem_number);
+}
+
+void
+ParallelRadixSortWithScheduler (struct task_scheduler* const scheduler,
+                                int* const                   array,
+                                const size_t                 elem_number)
+{
+    if (array == NULL || elem_number <= 1) return;
+
+    if (scheduler == NULL || elem_number < PARALLEL_RADIX_MIN_SIZE)
+    {
+        RadixSort (array, elem_number);
+        return;
+    }
+
+    size_t block_number = elem_number / PARALLEL_RADIX_MIN_BLOCK_SIZE;
+    if (block_number > scheduler->worker_number) block_number = scheduler->worker_number;
+    if (block_number == 0)                       block_number = 1;
+
+    /* sizeof of the block is a multiple of its alignment */
+    struct parallel_radix_block* const blocks = (struct parallel_radix_block*)
+        aligned_alloc (PARALLEL_RADIX_CACHE_LINE, block_number * sizeof (struct parallel_radix_block));
+    int* const buffer = (int*) malloc (elem_number * sizeof (int));
+
+    if (blocks == NULL || buffer == NULL)
+    {
+        free (blocks);
+        free (buffer);
+        RadixSort (array, elem_number);
+        return;
+    }
+
+    struct parallel_radix_sort sort =
+    {
+        .array        = array,
+        .buffer       = buffer,
+        .elem_number  = elem_number,
+        .blocks       = blocks,
+        .block_number = block_number
+    };
+
+    for (size_t i = 0; i < block_number; ++i)
+    {
+        blocks[i].sort  = &sort;
+        blocks[i].begin = elem_number *  i      / block_number;
+        blocks[i].end   = elem_number * (i + 1) / block_number;
+    }
+
+    if (TaskSchedulerRun (scheduler, ParallelRadixSortRoot, &sort) != TASK_SCHEDULER_SUCCESS)
+        RadixSort (array, elem_number);
+
+    free (blocks);
+    free (buffer);
+}
+
+/**
+ * @brief Runs phases of the sort, every phase is a fork-join over blocks.
+ */
+static void
+ParallelRadixSortRoot (void* sort_ptr)
+{
+    assert (sort_ptr);
+    struct parallel_radix_sort* const sort = (struct parallel_radix_sort*) sort_ptr;
+
+    sort->from = sort->array;
+    sort->to   = sort->buffer;
+    ParallelRadixRunPhase (sort, PARALLEL_RADIX_COUNT_ALL);
+
+    /* totals don't depend on order of elements, so they are counted once */
+    size_t totals[PARALLEL_RADIX_DIGIT_NUMBER][PARALLEL_RADIX_BIN_NUMBER] = {};
+
+    for (size_t block = 0; block < sort->block_number; ++block)
+        for (size_t digit = 0; digit < PARALLEL_RADIX_DIGIT_NUMBER; ++digit)
+            for (size_t bin = 0; bin < PARALLEL_RADIX_BIN_NUMBER; ++bin)
+                totals[digit][bin] += sort->blocks[block].counts[digit][bin];
+
+    bool scattered = false;
+
+    for (size_t digit = 0; digit < PARALLEL_RADIX_DIGIT_NUMBER; ++digit)
+    {
+        /* all elements have the same digit, pass changes nothing */
+        if (totals[digit][ParallelRadixDigit (ParallelRadixKey (sort->from[0]), digit)] ==
+            sort->elem_number)
+            continue;
+
+        sort->digit = digit;
+
+        /* scatter moved elements between blocks, block histograms are stale */
+        if (scattered)
+            ParallelRadixRunPhase (sort, PARALLEL_RADIX_COUNT);
+
+        /* elements of the same digit go in block order, so the pass is stable */
+        size_t offset = 0;
+
+        for (size_t bin = 0; bin < PARALLEL_RADIX_BIN_NUMBER; ++bin)
+        {
+            for (size_t block = 0; block < sort->block_number; ++block)
+            {
+                sort->blocks[block].offsets[bin] = offset;
+                offset += sort->blocks[block].counts[digit][bin];
+            }
+        }
+
+        ParallelRadixRunPhase (sort, PARALLEL_RADIX_SCATTER);
+        scattered = true;
+
+        int* const temp = (int*) sort->from;
+        sort->from = sort->to;
+        sort->to   = temp;
+    }
+
+    if (sort->from != sort->array)
+    {
+        sort->to = sort->array;
+        ParallelRadixRunPhase (sort, PARALLEL_RADIX_COPY);
+    }
+}
+
+/**
+ * @brief Spawns tasks of all blocks but the first, does the first itself.
+ */
+static void
+ParallelRadixRunPhase (struct parallel_radix_sort* const sort,
+                       const enum parallel_radix_phase   phase)
+{
+    assert (sort);
+
+    sort->phase = phase;
+
+    struct task_group group = {};
+
+    for (size_t block = 1; block < sort->block_number; ++block)
+        TaskSpawn (&group, &sort->blocks[block].task, ParallelRadixBlockTask,
+                   &sort->blocks[block]);
+
+    ParallelRadixBlockTask (&sort->blocks[0]);
+
+    TaskSync (&group);
+}
+
+static void
+ParallelRadixBlockTask (void* block_ptr)
+{
+    assert (block_ptr);
+    struct parallel_radix_block* const block = (struct parallel_radix_block*) block_ptr;
+    const struct parallel_radix_sort* const sort = block->sort;
+
+    const int* const from  = sort->from;
+    const size_t     digit = sort->digit;
+
+    switch (sort->phase)
+    {
+        case PARALLEL_RADIX_COUNT_ALL:
+            memset (block->counts, 0, sizeof (block->counts));
+
+            for (size_t i = block->begin; i < block->end; ++i)
+            {
+                const uint32_t key = ParallelRadixKey (from[i]);
+
+                for (size_t cur_digit = 0; cur_digit < PARALLEL_RADIX_DIGIT_NUMBER; ++cur_digit)
+                    block->counts[cur_digit][ParallelRadixDigit (key, cur_digit)]++;
+            }
+            break;
+
+        case PARALLEL_RADIX_COUNT:
+            memset (block->counts[digit], 0, sizeof (block->counts[digit]));
+
+            for (size_t i = block->begin; i < block->end; ++i)
+                block->counts[digit][ParallelRadixDigit (ParallelRadixKey (from[i]), digit)]++;
+            break;
+
+        case PARALLEL_RADIX_SCATTER:
+            ParallelRadixScatter (block, from, sort->to, digit);
+            break;
+
+        case PARALLEL_RADIX_COPY:
+            memcpy (sort->to + block->begin, from + block->begin,
+                    (block->end - block->begin) * sizeof (int));
+            break;
+
+        default:
+            assert (0);
+    }
+}
+
+/**
+ * @brief Scatters the block through write-combining buffers.
+ * @details Buffer of a digit is written out when it reaches the next cache line
+ * boundary of the destination, the first write of every digit is shorter
+ * to reach it, the next ones are whole aligned cache lines. So scattered
+ * elements of 256 digits cost one cache line write each, not one partial
+ * line per element.
+ */
+static void
+ParallelRadixScatter (struct parallel_radix_block* const block,
+                      const int* const                   from,
+                      int* const                         to,
+                      const size_t                       digit)
+{
+    assert (block);
+    assert (from);
+    assert (to);
+
+    for (size_t bin = 0; bin < PARALLEL_RADIX_BIN_NUMBER; ++bin)
+    {
+        const size_t line_offset =
+            ((uintptr_t) (to + block->offsets[bin]) % PARALLEL_RADIX_CACHE_LINE) / sizeof (int);
+
+        block->wc_fill [bin] = 0;
+        block->wc_limit[bin] = (uint32_t) (PARALLEL_RADIX_WC_SIZE - line_offset);
+    }
+
+    for (size_t i = block->begin; i < block->end; ++i)
+    {
+        const int    value = from[i];
+        const size_t bin   = ParallelRadixDigit (ParallelRadixKey (value), digit);
+
+        block->wc_buffers[bin][block->wc_fill[bin]++] = value;
+
+        if (block->wc_fill[bin] == block->wc_limit[bin])
+        {
+            /* constant size of whole line lets compiler use vector stores */
+            if (block->wc_fill[bin] == PARALLEL_RADIX_WC_SIZE)
+                memcpy (to + block->offsets[bin], block->wc_buffers[bin],
+                        PARALLEL_RADIX_CACHE_LINE);
+            else
+                memcpy (to + block->offsets[bin], block->wc_buffers[bin],
+                        block->wc_fill[bin] * sizeof (int));
+
+            block->offsets[bin] += block->wc_fill[bin];
+            block->wc_fill [bin]  = 0;
+            block->wc_limit[bin]  = PARALLEL_RADIX_WC_SIZE;
+        }
+    }
+
+    for (size_t bin = 0; bin < PARALLEL_RADIX_BIN_NUMBER; ++bin)
+    {
+        memcpy (to + block->offsets[bin], block->wc_buffers[bin],
+                block->wc_fill[bin] * sizeof (int));
+
+        block->offsets[bin] += block->wc_fill[bin];
+    }
+}
+
+/**
+ * @brief Unsigned key with the same order as int values.
+ */
+static inline uint32_t
+ParallelRadixKey (const int value)
+{
+    return (uint32_t) value ^ PARALLEL_RADIX_SIGN_BIT;
+}
+
+static inline size_t
+ParallelRadixDigit (const uint32_t key,
+                    const size_t   digit)
+{
+    return (key >> (digit * PARALLEL_RADIX_DIGIT_BITS)) & (PARALLEL_RADIX_BIN_NUMBER - 1);
+}
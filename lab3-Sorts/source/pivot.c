@@ -0,0 +1,254 @@
+#include "../include/pivot.h"
+
+/* smaller ranges use median of 3 instead of ninther */
+const size_t PIVOT_NINTHER_MIN_SIZE       = 40;
+/* smaller ranges use ninther instead of sample median */
+const size_t PIVOT_SAMPLE_MEDIAN_MIN_SIZE = 1024;
+/* any non-zero value, xorshift state must never be zero */
+const uint64_t PIVOT_RANDOM_SEED          = 0x9E3779B97F4A7C15ULL;
+
+static size_t (*const PIVOT_FUNCTIONS[]) (int* const   array,
+                                          const size_t left_index,
+                                          const size_t right_index) =
+{
+    [PIVOT_MIDDLE]          = PivotMiddle,
+    [PIVOT_MEDIAN_3]        = PivotMedian3,
+    [PIVOT_RANDOM_MEDIAN_3] = PivotRandomMedian3,
+    [PIVOT_NINTHER]         = PivotNinther,
+    [PIVOT_SAMPLE_MEDIAN]   = PivotSampleMedian
+};
+
+static enum pivot_strategy pivot_strategy = PIVOT_MIDDLE;
+
+static _Thread_local uint64_t pivot_random_state = 0;
+
+static size_t
+MedianOfThree (const int* const array,
+               const size_t index_1,
+               const size_t index_2,
+               const size_t index_3);
+
+static size_t
+RandomIndex (const size_t left_index,
+             const size_t right_index);
+
+static void
+SelectKth (int* const   array,
+           const size_t elem_number,
+           const size_t k);
+
+static size_t
+SquareRoot (const size_t value);
+
+void
+PivotSetStrategy (const enum pivot_strategy strategy)
+{
+    assert ((size_t) strategy < sizeof (PIVOT_FUNCTIONS) / sizeof (PIVOT_FUNCTIONS[0]));
+
+    pivot_strategy = strategy;
+}
+
+enum pivot_strategy
+PivotGetStrategy (void)
+{
+    return pivot_strategy;
+}
+
+size_t
+PivotFind (int* const   array,
+           const size_t left_index,
+           const size_t right_index)
+{
+    return PIVOT_FUNCTIONS[pivot_strategy] (array, left_index, right_index);
+}
+
+size_t
+PivotMiddle (int* const   array,
+             const size_t left_index,
+             const size_t right_index)
+{
+    assert (array);
+    assert (left_index < right_index);
+
+    return left_index + (right_index - left_index) / 2;
+}
+
+size_t
+PivotMedian3 (int* const   array,
+              const size_t left_index,
+              const size_t right_index)
+{
+    assert (array);
+    assert (left_index < right_index);
+
+    return MedianOfThree (array, left_index,
+                          PivotMiddle (array, left_index, right_index),
+                          right_index);
+}
+
+size_t
+PivotRandomMedian3 (int* const   array,
+                    const size_t left_index,
+                    const size_t right_index)
+{
+    assert (array);
+    assert (left_index < right_index);
+
+    return MedianOfThree (array, RandomIndex (left_index, right_index),
+                                 RandomIndex (left_index, right_index),
+                                 RandomIndex (left_index, right_index));
+}
+
+size_t
+PivotNinther (int* const   array,
+              const size_t left_index,
+              const size_t right_index)
+{
+    assert (array);
+    assert (left_index < right_index);
+
+    const size_t elem_number = right_index - left_index + 1;
+
+    if (elem_number < PIVOT_NINTHER_MIN_SIZE)
+        return PivotMedian3 (array, left_index, right_index);
+
+    const size_t step      = elem_number / 8;
+    const size_t mid_index = PivotMiddle (array, left_index, right_index);
+
+    const size_t median_1 = MedianOfThree (array, left_index,
+                                                  left_index + step,
+                                                  left_index + 2 * step);
+
+    const size_t median_2 = MedianOfThree (array, mid_index - step,
+                                                  mid_index,
+                                                  mid_index + step);
+
+    const size_t median_3 = MedianOfThree (array, right_index - 2 * step,
+                                                  right_index - step,
+                                                  right_index);
+
+    return MedianOfThree (array, median_1, median_2, median_3);
+}
+
+size_t
+PivotSampleMedian (int* const   array,
+                   const size_t left_index,
+                   const size_t right_index)
+{
+    assert (array);
+    assert (left_index < right_index);
+
+    const size_t elem_number = right_index - left_index + 1;
+
+    if (elem_number < PIVOT_SAMPLE_MEDIAN_MIN_SIZE)
+        return PivotNinther (array, left_index, right_index);
+
+    /* odd sample size, so median is a single element */
+    const size_t sample_size = SquareRoot (elem_number) | 1;
+    const size_t step        = elem_number / sample_size;
+
+    /* gather sample in the beginning of the range, step >= 1 */
+    for (size_t i = 0; i < sample_size; ++i)
+        int_swap (&array[left_index + i], &array[left_index + i * step]);
+
+    SelectKth (array + left_index, sample_size, sample_size / 2);
+
+    return left_index + sample_size / 2;
+}
+
+uint64_t
+PivotRandom (void)
+{
+    /* thread local variable address differs between threads */
+    if (pivot_random_state == 0)
+        pivot_random_state = PIVOT_RANDOM_SEED ^ (uint64_t) (uintptr_t) &pivot_random_state;
+
+    pivot_random_state ^= pivot_random_state >> 12;
+    pivot_random_state ^= pivot_random_state << 25;
+    pivot_random_state ^= pivot_random_state >> 27;
+
+    return pivot_random_state * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t
+MedianOfThree (const int* const array,
+               const size_t index_1,
+               const size_t index_2,
+               const size_t index_3)
+{
+    assert (array);
+
+    if (INT_LESS (array[index_1], array[index_2]))
+    {
+        if (INT_LESS (array[index_2], array[index_3])) return index_2;
+        return INT_LESS (array[index_1], array[index_3]) ? index_3 : index_1;
+    }
+
+    if (INT_LESS (array[index_1], array[index_3])) return index_1;
+    return INT_LESS (array[index_2], array[index_3]) ? index_3 : index_2;
+}
+
+static size_t
+RandomIndex (const size_t left_index,
+             const size_t right_index)
+{
+    assert (left_index <= right_index);
+
+    return left_index + (size_t) (PivotRandom () % (right_index - left_index + 1));
+}
+
+/**
+ * @brief Quickselect: puts k-th smallest element to array[k].
+ */
+static void
+SelectKth (int* const   array,
+           const size_t elem_number,
+           const size_t k)
+{
+    assert (array);
+    assert (k < elem_number);
+
+    size_t left_index  = 0;
+    size_t right_index = elem_number - 1;
+
+    while (left_index < right_index)
+    {
+        /* Hoare partition with pivot in the beginning never returns right_index */
+        int_swap (&array[left_index],
+                  &array[PivotMedian3 (array, left_index, right_index)]);
+
+        const int pivot_elem = array[left_index];
+
+        size_t i = left_index;
+        size_t j = right_index;
+
+        while (true)
+        {
+            while (INT_LESS    (array[i], pivot_elem)) i++;
+            while (INT_GREATER (array[j], pivot_elem)) j--;
+
+            if (i >= j) break;
+
+            int_swap (&array[i++], &array[j--]);
+        }
+
+        /* here [left, j] <= pivot and [j + 1, right] >= pivot */
+        if (k <= j) right_index = j;
+        else        left_index  = j + 1;
+    }
+}
+
+static size_t
+SquareRoot (const size_t value)
+{
+    size_t root = value;
+    size_t next = (root + 1) / 2;
+
+    while (next < root)
+    {
+        root = next;
+        next = (root + value / root) / 2;
+    }
+
+    return root;
+}
@@ -8,31 +8,21 @@ QuickSort (int* const   array,
                                 const size_t left_index,
                                 const size_t right_index));
 
-static size_t
-LomutoPartition (int* const   array,
-                 const size_t left_index,
-                 const size_t right_index);
-
-static size_t
-HoarePartition (int* const   array,
-                const size_t left_index,
-                const size_t right_index);
-
 static void
 QsortRecursionThickPartition (int* const   array,
                               const size_t left_index,
                               const size_t right_index);
 
 static void
-ThickPartition (int* const   array,
-                size_t left_index,
-                size_t right_index,
-                size_t* const equals_from,
-                size_t* const equals_to);
+QsortRecursionBentleyMcIlroy (int* const array,
+                              size_t     left_index,
+                              size_t     right_index);
 
-static size_t
-MiddlePivot (const size_t left_index,
-             const size_t right_index);
+static void
+SwapRanges (int* const   array,
+            const size_t first_index,
+            const size_t second_index,
+            const size_t swap_number);
 
 void
 QuickLomutoSort (int* const   array,
@@ -61,6 +51,15 @@ QuickThickSort (int* const   array,
     QsortRecursionThickPartition (array, 0, elem_number - 1);
 }
 
+void
+QuickBentleyMcIlroySort (int* const   array,
+                         const size_t elem_number)
+{
+    if (array == NULL || elem_number == 0) return;
+
+    QsortRecursionBentleyMcIlroy (array, 0, elem_number - 1);
+}
+
 static void
 QuickSort (int* const   array,
            const size_t left_index,
@@ -73,13 +72,17 @@ QuickSort (int* const   array,
 
     if (left_index >= right_index) return;
 
+    SORT_STATS_ENTER ();
+
     size_t pivot = partition (array, left_index, right_index);
 
     QuickSort (array, left_index, pivot,       partition);
     QuickSort (array, pivot + 1,  right_index, partition);
+
+    SORT_STATS_LEAVE ();
 }
 
-static size_t
+size_t
 LomutoPartition (int* const   array,
                  const size_t left_index,
                  const size_t right_index)
@@ -87,7 +90,7 @@ LomutoPartition (int* const   array,
     assert (array);
     assert (left_index < right_index);
 
-    size_t pivot = MiddlePivot (left_index, right_index);
+    size_t pivot = PivotFind (array, left_index, right_index);
     size_t i = left_index;
 
     int pivot_elem = array[pivot];
@@ -96,7 +99,7 @@ LomutoPartition (int* const   array,
 
     for (size_t j = left_index; j <= right_index; ++j)
     {
-        if (array[j] < pivot_elem)
+        if (INT_LESS (array[j], pivot_elem))
             int_swap (&array[i++], &array[j]);
     }
 
@@ -105,7 +108,7 @@ LomutoPartition (int* const   array,
     return i;
 }
 
-static size_t
+size_t
 HoarePartition (int* const   array,
                 const size_t left_index,
                 const size_t right_index)
@@ -113,16 +116,17 @@ HoarePartition (int* const   array,
     assert (array);
     assert (left_index < right_index);
 
-    size_t pivot = MiddlePivot (left_index, right_index);
-    int pivot_elem = array[pivot];
+    /* Hoare partition with pivot in the beginning never returns right_index */
+    int_swap (&array[left_index], &array[PivotFind (array, left_index, right_index)]);
+    int pivot_elem = array[left_index];
 
     size_t i = left_index;
     size_t j = right_index;
 
     while (i <= j)
     {
-        while (array[i] < pivot_elem) i++;
-        while (array[j] > pivot_elem) j--;
+        while (INT_LESS    (array[i], pivot_elem)) i++;
+        while (INT_GREATER (array[j], pivot_elem)) j--;
 
         if (i >= j) return j;
 
@@ -141,6 +145,8 @@ QsortRecursionThickPartition (int* const   array,
 
     if (left_index >= right_index) return;
 
+    SORT_STATS_ENTER ();
+
     size_t equals_from = 0;
     size_t equals_to   = 0;
 
@@ -148,9 +154,11 @@ QsortRecursionThickPartition (int* const   array,
 
     QsortRecursionThickPartition (array, left_index,    equals_from);
     QsortRecursionThickPartition (array, equals_to + 1, right_index);
+
+    SORT_STATS_LEAVE ();
 }
 
-static void
+void
 ThickPartition (int* const   array,
                 size_t left_index,
                 size_t right_index,
@@ -161,17 +169,17 @@ ThickPartition (int* const   array,
     assert (equals_from);
     assert (equals_to);
 
-    size_t pivot = MiddlePivot (left_index, right_index);
+    size_t pivot = PivotFind (array, left_index, right_index);
     int pivot_elem = array[pivot];
 
     size_t mid_index = left_index;
 
     while (mid_index <= right_index)
     {
-        if (array[mid_index] < pivot_elem)
+        if (INT_LESS (array[mid_index], pivot_elem))
             int_swap (&array[left_index++], &array[mid_index++]);
 
-        else if (array[mid_index] == pivot_elem)
+        else if (INT_EQUAL (array[mid_index], pivot_elem))
             mid_index++;
 
         else
@@ -182,11 +190,125 @@ ThickPartition (int* const   array,
     *equals_to   = right_index;
 }
 
-static size_t
-MiddlePivot (const size_t left_index,
-             const size_t right_index)
+/**
+ * @details Recursion goes to the smaller part, the bigger one
+ * is sorted by the loop, so stack depth is O(log n).
+ */
+static void
+QsortRecursionBentleyMcIlroy (int* const array,
+                              size_t     left_index,
+                              size_t     right_index)
+{
+    assert (array);
+
+    if (left_index >= right_index) return;
+
+    SORT_STATS_ENTER ();
+
+    while (left_index < right_index)
+    {
+        size_t less_end      = 0;
+        size_t greater_begin = 0;
+
+        BentleyMcIlroyPartition (array, left_index, right_index,
+                                 &less_end, &greater_begin);
+
+        /* [left, less_end) < pivot, [greater_begin, right] > pivot */
+        const size_t less_number    = less_end - left_index;
+        const size_t greater_number = right_index + 1 - greater_begin;
+
+        if (less_number < greater_number)
+        {
+            if (less_number > 1)
+                QsortRecursionBentleyMcIlroy (array, left_index, less_end - 1);
+
+            left_index = greater_begin;
+        }
+
+        else
+        {
+            if (greater_number > 1)
+                QsortRecursionBentleyMcIlroy (array, greater_begin, right_index);
+
+            if (less_number == 0) break;
+            right_index = less_end - 1;
+        }
+    }
+
+    SORT_STATS_LEAVE ();
+}
+
+void
+BentleyMcIlroyPartition (int* const   array,
+                         const size_t left_index,
+                         const size_t right_index,
+                         size_t* const less_end,
+                         size_t* const greater_begin)
 {
+    assert (array);
     assert (left_index < right_index);
+    assert (less_end);
+    assert (greater_begin);
+
+    int_swap (&array[left_index], &array[PivotFind (array, left_index, right_index)]);
+    int pivot_elem = array[left_index];
+
+    /**
+     * [left, equal_left)         == pivot
+     * [equal_left, i)            <  pivot
+     * (j, equal_right]           >  pivot
+     * (equal_right, right]       == pivot
+     */
+    size_t equal_left  = left_index + 1;
+    size_t equal_right = right_index;
+    size_t i = left_index + 1;
+    size_t j = right_index;
+
+    while (true)
+    {
+        while (i <= j && INT_LESS_EQUAL (array[i], pivot_elem))
+        {
+            if (INT_EQUAL (array[i], pivot_elem))
+                int_swap (&array[equal_left++], &array[i]);
+            i++;
+        }
+
+        while (i <= j && INT_GREATER_EQUAL (array[j], pivot_elem))
+        {
+            if (INT_EQUAL (array[j], pivot_elem))
+                int_swap (&array[j], &array[equal_right--]);
+            j--;
+        }
+
+        if (i > j) break;
+
+        int_swap (&array[i++], &array[j--]);
+    }
+
+    /* here j == i - 1, move equal parts from the ends to the middle */
+    size_t less_number    = i - equal_left;
+    size_t greater_number = equal_right - j;
+
+    size_t swap_number = equal_left - left_index;
+    if (swap_number > less_number) swap_number = less_number;
+    SwapRanges (array, left_index, i - swap_number, swap_number);
+
+    swap_number = right_index - equal_right;
+    if (swap_number > greater_number) swap_number = greater_number;
+    SwapRanges (array, i, right_index + 1 - swap_number, swap_number);
+
+    *less_end      = left_index  + less_number;
+    *greater_begin = right_index + 1 - greater_number;
+}
+
+static void
+SwapRanges (int* const   array,
+            const size_t first_index,
+            const size_t second_index,
+            const size_t swap_number)
+{
+    assert (array);
 
-    return left_index + (right_index - left_index) / 2;
+    for (size_t i = 0; i < swap_number; ++i)
+        int_swap (&array[first_index + i], &array[second_index + i]);
 }
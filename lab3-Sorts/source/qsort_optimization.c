@@ -16,23 +16,10 @@ HoarePartitionCustomPivot (int* const   array,
                                                  const size_t left_index,
                                                  const size_t right_index));
 
-static size_t
-MiddlePivot (int* const   array,
-             const size_t left_index,
-             const size_t right_index);
-
-static size_t
-Median3Pivot (int* const   array,
-              const size_t left_index,
-              const size_t right_index);
-
-static size_t
-MedianRandom3Pivot (int* const   array,
-                    const size_t left_index,
-                    const size_t right_index);
-
-static int
-ThreeElementsMedian (int elem1, int elem2, int elem3);
+static void
+QuickKernelSortRange (int*   array,
+                      size_t elem_number,
+                      int*   buffer);
 
 void
 QuickOneRecursionBranchSort (int* const   array,
@@ -40,7 +27,7 @@ QuickOneRecursionBranchSort (int* const   array,
 {
     if (array == NULL || elem_number == 0) return;
 
-    QsortLessRecursion (array, 0, elem_number - 1, MiddlePivot);
+    QsortLessRecursion (array, 0, elem_number - 1, PivotFind);
 }
 
 static void
@@ -56,12 +43,14 @@ QsortLessRecursion (int* const array,
     size_t pivot_index = 0;
     size_t mid_index   = 0;
 
+    SORT_STATS_ENTER ();
+
     while (left_index < right_index)
     {
         pivot_index = HoarePartitionCustomPivot (array, left_index,
                                                  right_index, find_pivot);
 
-        mid_index = MiddlePivot (array, left_index, right_index);
+        mid_index = left_index + (right_index - left_index) / 2;
 
         if (pivot_index > mid_index)
         {
@@ -75,6 +64,8 @@ QsortLessRecursion (int* const array,
             left_index = pivot_index + 1;
         }
     }
+
+    SORT_STATS_LEAVE ();
 }
 
 static size_t
@@ -88,16 +79,17 @@ HoarePartitionCustomPivot (int* const   array,
     assert (array);
     assert (left_index < right_index);
 
-    size_t pivot = find_pivot (array, left_index, right_index);
-    int pivot_elem = array[pivot];
+    /* Hoare partition with pivot in the beginning never returns right_index */
+    int_swap (&array[left_index], &array[find_pivot (array, left_index, right_index)]);
+    int pivot_elem = array[left_index];
 
     size_t i = left_index;
     size_t j = right_index;
 
     while (i <= j)
     {
-        while (array[i] < pivot_elem) i++;
-        while (array[j] > pivot_elem) j--;
+        while (INT_LESS    (array[i], pivot_elem)) i++;
+        while (INT_GREATER (array[j], pivot_elem)) j--;
 
         if (i >= j) return j;
 
@@ -107,67 +99,75 @@ HoarePartitionCustomPivot (int* const   array,
     return j;
 }
 
-static size_t
-MiddlePivot (int* const   array,
-             const size_t left_index,
-             const size_t right_index)
+void
+QuickKernelSort (int* const   array,
+                 const size_t elem_number)
 {
-    assert (array);
-    assert (left_index < right_index);
+    if (array == NULL || elem_number <= 1) return;
+
+    int* const buffer = (int*) malloc (elem_number * sizeof (int));
+    if (buffer == NULL)
+    {
+        QuickHoareSort (array, elem_number);
+        return;
+    }
 
-    return left_index + (right_index - left_index) / 2;
+    QuickKernelSortRange (array, elem_number, buffer);
+
+    free (buffer);
 }
 
-static size_t
-Median3Pivot (int* const   array,
-              const size_t left_index,
-              const size_t right_index)
+/**
+ * @details Recursion goes to the smaller part, the bigger one
+ * is sorted by the loop, so stack depth is O(log n).
+ */
+static void
+QuickKernelSortRange (int*   array,
+                      size_t elem_number,
+                      int*   buffer)
 {
     assert (array);
-    assert (left_index < right_index);
-
-    size_t mid_index = MiddlePivot (array, left_index, right_index);
+    assert (buffer);
 
-    int median = ThreeElementsMedian (array[left_index],
-                                      array[mid_index],
-                                      array[right_index]);
+    while (elem_number > SORT_KERNELS_NETWORK_MAX_SIZE)
+    {
+        const int pivot_elem = array[PivotFind (array, 0, elem_number - 1)];
 
-    if (median == array[left_index])  return left_index;
-    if (median == array[right_index]) return right_index;
-    return mid_index;
-}
+        size_t less_number =
+            sort_kernels.partition (array, elem_number, pivot_elem, buffer);
+        memcpy (array, buffer, elem_number * sizeof (int));
 
-static size_t
-RandomPivot (int* const   array,
-             const size_t left_index,
-             const size_t right_index)
-{
-    assert (array);
-    assert (left_index < right_index);
+        if (less_number == 0)
+        {
+            /* pivot is the min, elements equal to it go first and are sorted */
+            if (pivot_elem == INT_MAX) return;
 
-    return left_index + rand() / (RAND_MAX / (right_index - left_index + 1) + 1);
-}
+            less_number =
+                sort_kernels.partition (array, elem_number, pivot_elem + 1, buffer);
+            memcpy (array, buffer, elem_number * sizeof (int));
 
-static size_t
-MedianRandom3Pivot (int* const   array,
-                    const size_t left_index,
-                    const size_t right_index)
-{
-    assert (array);
-    assert (left_index < right_index);
+            array       += less_number;
+            buffer      += less_number;
+            elem_number -= less_number;
+            continue;
+        }
 
-    size_t index_1 = RandomPivot (array, left_index, right_index);
-    size_t index_2 = RandomPivot (array, left_index, right_index);
-    size_t index_3 = RandomPivot (array, left_index, right_index);
+        if (less_number < elem_number - less_number)
+        {
+            QuickKernelSortRange (array, less_number, buffer);
 
-    return ThreeElementsMedian (array[index_1], array[index_2], array[index_3]);
-}
+            array       += less_number;
+            buffer      += less_number;
+            elem_number -= less_number;
+        }
 
-static int
-ThreeElementsMedian (int elem1, int elem2, int elem3)
-{
-    if (elem1 > elem2) int_swap (&elem1, &elem2);
-    if (elem2 > elem3) int_swap (&elem2, &elem3);
+        else
+        {
+            QuickKernelSortRange (array  + less_number, elem_number - less_number,
+                                  buffer + less_number);
+            elem_number = less_number;
+        }
+    }
 
-    return elem2;
+    sort_kernels.network_sort (array, elem_number);
 }
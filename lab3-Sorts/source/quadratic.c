@@ -18,7 +18,7 @@ BubbleSort (int* const   array,
 
         for (size_t j = 1; j < elem_number - i; ++j)
         {
-            if (array[j - 1] > array[j])
+            if (INT_GREATER (array[j - 1], array[j]))
             {
                 int_swap (&array[j - 1], &array[j]);
                 ++num_of_swaps;
@@ -40,7 +40,7 @@ InsertionSort (int* const   array,
         /* reverse loop does j-- before loop body, so j = i, not i - 1 */
         for (size_t j = i; j-- > 0;)
         {
-            if (array[j] > array[j + 1])
+            if (INT_GREATER (array[j], array[j + 1]))
                 int_swap (&array[j], &array[j + 1]);
 
             else break;
@@ -61,7 +61,7 @@ SelectionSort (int* const   array,
 
         for (size_t j = i + 1; j < elem_number; ++j)
         {
-            if (array[j] < array[min_index])
+            if (INT_LESS (array[j], array[min_index]))
                 min_index = j;
         }
 
@@ -94,12 +94,14 @@ ShellSort (int* const   array,
             size_t j = i;
             temp_value = array[i];
 
-            for (; j >= step && array[j - step] > temp_value; j -= step)
+            for (; j >= step && INT_GREATER (array[j - step], temp_value); j -= step)
             {
                 array[j] = array[j - step];
+                SORT_STATS_MOVE (sizeof (int));
             }
 
             array[j] = temp_value;
+            SORT_STATS_MOVE (sizeof (int));
         }
     }
 }
@@ -0,0 +1,99 @@
+#include "../include/radix_sort.h"
+#include "../include/qsort.h"
+
+#define RADIX_SORT_DIGIT_NUMBER 4
+#define RADIX_SORT_BIN_NUMBER   256
+
+const size_t   RADIX_SORT_DIGIT_BITS = 8;
+const uint32_t RADIX_SORT_SIGN_BIT   = 0x80000000u;
+
+static inline uint32_t
+RadixKey (const int value);
+
+static inline size_t
+RadixDigit (const uint32_t key,
+            const size_t   digit);
+
+void
+RadixSort (int* const   array,
+           const size_t elem_number)
+{
+    if (array == NULL || elem_number <= 1) return;
+
+    int* const buffer = (int*) malloc (elem_number * sizeof (int));
+    if (buffer == NULL)
+    {
+        QuickHoareSort (array, elem_number);
+        return;
+    }
+
+    RadixSortWithBuffer (array, elem_number, buffer);
+
+    free (buffer);
+}
+
+void
+RadixSortWithBuffer (int* const   array,
+                     const size_t elem_number,
+                     int* const   buffer)
+{
+    if (array == NULL || elem_number <= 1) return;
+    assert (buffer);
+
+    size_t counts[RADIX_SORT_DIGIT_NUMBER][RADIX_SORT_BIN_NUMBER] = {};
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        const uint32_t key = RadixKey (array[i]);
+
+        for (size_t digit = 0; digit < RADIX_SORT_DIGIT_NUMBER; ++digit)
+            counts[digit][RadixDigit (key, digit)]++;
+    }
+
+    int* from = array;
+    int* to   = buffer;
+
+    for (size_t digit = 0; digit < RADIX_SORT_DIGIT_NUMBER; ++digit)
+    {
+        size_t* const digit_counts = counts[digit];
+
+        /* all elements have the same digit, pass changes nothing */
+        if (digit_counts[RadixDigit (RadixKey (from[0]), digit)] == elem_number)
+            continue;
+
+        size_t offset = 0;
+
+        for (size_t bin = 0; bin < RADIX_SORT_BIN_NUMBER; ++bin)
+        {
+            const size_t bin_size = digit_counts[bin];
+            digit_counts[bin] = offset;
+            offset += bin_size;
+        }
+
+        for (size_t i = 0; i < elem_number; ++i)
+            to[digit_counts[RadixDigit (RadixKey (from[i]), digit)]++] = from[i];
+
+        int* const temp = from;
+        from = to;
+        to   = temp;
+    }
+
+    if (from != array)
+        memcpy (array, from, elem_number * sizeof (int));
+}
+
+/**
+ * @brief Unsigned key with the same order as int values.
+ */
+static inline uint32_t
+RadixKey (const int value)
+{
+    return (uint32_t) value ^ RADIX_SORT_SIGN_BIT;
+}
+
+static inline size_t
+RadixDigit (const uint32_t key,
+            const size_t   digit)
+{
+    return (key >> (digit * RADIX_SORT_DIGIT_BITS)) & (RADIX_SORT_BIN_NUMBER - 1);
+}
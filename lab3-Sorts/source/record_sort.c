@@ -0,0 +1,412 @@
+#include "../include/record_sort.h"
+
+/* buckets up to this size are sorted by insertion sort */
+const size_t RECORD_SORT_INSERTION_MAX_SIZE = 32;
+/* key bytes are 8-bit radix digits */
+#define RECORD_SORT_RADIX 256
+
+/**
+ * @brief Data shared by all steps of one RecordSort() call.
+ */
+struct record_sort_context
+{
+    const char*              records;
+    size_t                   record_size;
+    const struct record_key* keys;
+    size_t                   key_number;
+    size_t                   normalized_key_number;  ///< Columns in normalized key.
+
+    const uint8_t*           normalized;    ///< width bytes for every record.
+    size_t                   width;
+    bool                     need_compare;  ///< Equal normalized keys may differ.
+};
+
+static void
+RecordNormalize (const struct record_sort_context* const context,
+                 const char* const                       record,
+                 uint8_t*                                dest);
+
+static void
+RecordSortRange (const struct record_sort_context* const context,
+                 size_t* const                           index,
+                 size_t* const                           buffer,
+                 const size_t                            elem_number,
+                 size_t                                  depth);
+
+static void
+RecordInsertionSort (const struct record_sort_context* const context,
+                     size_t* const                           index,
+                     const size_t                            elem_number,
+                     const size_t                            depth);
+
+static void
+RecordMergeSortTies (const struct record_sort_context* const context,
+                     size_t* const                           index,
+                     size_t* const                           buffer,
+                     const size_t                            elem_number);
+
+static inline bool
+RecordLess (const struct record_sort_context* const context,
+            const size_t                            first,
+            const size_t                            second,
+            const size_t                            depth);
+
+static inline int
+RecordCompareByIndex (const struct record_sort_context* const context,
+                      const size_t                            first,
+                      const size_t                            second);
+
+record_sort_error_t
+RecordSort (void* const                    records,
+            const size_t                   record_number,
+            const size_t                   record_size,
+            const struct record_key* const keys,
+            const size_t                   key_number)
+{
+    if (records == NULL || keys == NULL || key_number == 0 || record_size == 0)
+        return RECORD_SORT_ERROR;
+
+    if (record_number <= 1) return RECORD_SORT_SUCCESS;
+
+    struct record_sort_context context =
+    {
+        .records     = (const char*) records,
+        .record_size = record_size,
+        .keys        = keys,
+        .key_number  = key_number
+    };
+
+    /* key ends at the first string: after its truncated prefix the later
+       columns must not decide the order, RecordCompare() does on ties */
+    for (size_t i = 0; i < key_number; ++i)
+    {
+        context.normalized_key_number = i + 1;
+
+        if (keys[i].type == RECORD_KEY_INT)
+            context.width += sizeof (uint32_t);
+
+        else
+        {
+            context.width       += keys[i].prefix_len;
+            context.need_compare = true;
+            break;
+        }
+    }
+
+    uint8_t* const normalized = (uint8_t*) malloc (record_number * context.width + 1);
+    size_t*  const index      = (size_t*)  malloc (record_number * sizeof (size_t));
+    size_t*  const buffer     = (size_t*)  malloc (record_number * sizeof (size_t));
+    char*    const permuted   = (char*)    malloc (record_number * record_size);
+
+    if (normalized == NULL || index == NULL || buffer == NULL || permuted == NULL)
+    {
+        free (normalized);
+        free (index);
+        free (buffer);
+        free (permuted);
+        return RECORD_SORT_ERROR;
+    }
+
+    context.normalized = normalized;
+
+    for (size_t i = 0; i < record_number; ++i)
+    {
+        RecordNormalize (&context, context.records + i * record_size,
+                         normalized + i * context.width);
+        index[i] = i;
+    }
+
+    RecordSortRange (&context, index, buffer, record_number, 0);
+
+    for (size_t i = 0; i < record_number; ++i)
+        memcpy (permuted + i * record_size, context.records + index[i] * record_size,
+                record_size);
+
+    memcpy (records, permuted, record_number * record_size);
+
+    free (normalized);
+    free (index);
+    free (buffer);
+    free (permuted);
+
+    return RECORD_SORT_SUCCESS;
+}
+
+int
+RecordCompare (const void* const              first,
+               const void* const              second,
+               const struct record_key* const keys,
+               const size_t                   key_number)
+{
+    assert (first);
+    assert (second);
+    assert (keys);
+
+    for (size_t i = 0; i < key_number; ++i)
+    {
+        int result = 0;
+
+        if (keys[i].type == RECORD_KEY_INT)
+        {
+            int first_value  = 0;
+            int second_value = 0;
+
+            memcpy (&first_value,  (const char*) first  + keys[i].offset, sizeof (int));
+            memcpy (&second_value, (const char*) second + keys[i].offset, sizeof (int));
+
+            result = (first_value > second_value) - (first_value < second_value);
+        }
+
+        else
+        {
+            const char* first_string  = NULL;
+            const char* second_string = NULL;
+
+            memcpy (&first_string,  (const char*) first  + keys[i].offset, sizeof (char*));
+            memcpy (&second_string, (const char*) second + keys[i].offset, sizeof (char*));
+
+            result = strcmp (first_string, second_string);
+            result = (result > 0) - (result < 0);
+        }
+
+        if (result != 0)
+            return (keys[i].order == RECORD_KEY_DESCENDING) ? -result : result;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Writes normalized key of record: memcmp () of two normalized keys
+ * has the sign of RecordCompare() or 0 if the string differs after prefix
+ * or records differ only in columns after the string.
+ */
+static void
+RecordNormalize (const struct record_sort_context* const context,
+                 const char* const                       record,
+                 uint8_t*                                dest)
+{
+    assert (context);
+    assert (record);
+    assert (dest);
+
+    for (size_t i = 0; i < context->normalized_key_number; ++i)
+    {
+        const struct record_key* const key = &context->keys[i];
+        uint8_t* const key_begin = dest;
+
+        if (key->type == RECORD_KEY_INT)
+        {
+            int value = 0;
+            memcpy (&value, record + key->offset, sizeof (int));
+
+            /* flipped sign bit orders negative values before positive as unsigned */
+            const uint32_t unsigned_value = (uint32_t) value ^ ((uint32_t) 1 << 31);
+
+            for (size_t byte = 0; byte < sizeof (uint32_t); ++byte)
+                *dest++ = (uint8_t) (unsigned_value >> (8 * (sizeof (uint32_t) - 1 - byte)));
+        }
+
+        else
+        {
+            const char* string = NULL;
+            memcpy (&string, record + key->offset, sizeof (char*));
+            assert (string);
+
+            size_t byte = 0;
+
+            for (; byte < key->prefix_len && string[byte] != '\0'; ++byte)
+                *dest++ = (uint8_t) string[byte];
+
+            for (; byte < key->prefix_len; ++byte)
+                *dest++ = 0;
+        }
+
+        if (key->order == RECORD_KEY_DESCENDING)
+            for (uint8_t* byte = key_begin; byte < dest; ++byte)
+                *byte = (uint8_t) ~*byte;
+    }
+}
+
+/**
+ * @brief MSD radix sort of indices by byte depth of normalized keys.
+ * @details buffer is the same size as index and is used for scattering.
+ * Ranges with equal normalized keys are left to the full comparator.
+ */
+static void
+RecordSortRange (const struct record_sort_context* const context,
+                 size_t* const                           index,
+                 size_t* const                           buffer,
+                 const size_t                            elem_number,
+                 size_t                                  depth)
+{
+    assert (context);
+    assert (index);
+    assert (buffer);
+
+    const uint8_t* const normalized = context->normalized;
+    const size_t         width      = context->width;
+
+    while (elem_number > 1)
+    {
+        if (depth == width)
+        {
+            if (context->need_compare)
+                RecordMergeSortTies (context, index, buffer, elem_number);
+
+            return;
+        }
+
+        if (elem_number <= RECORD_SORT_INSERTION_MAX_SIZE)
+        {
+            RecordInsertionSort (context, index, elem_number, depth);
+            return;
+        }
+
+        size_t counts[RECORD_SORT_RADIX] = {};
+
+        for (size_t i = 0; i < elem_number; ++i)
+            counts[normalized[index[i] * width + depth]]++;
+
+        /* all keys have the same byte, no need to scatter */
+        if (counts[normalized[index[0] * width + depth]] == elem_number)
+        {
+            depth++;
+            continue;
+        }
+
+        size_t positions[RECORD_SORT_RADIX];
+        size_t position = 0;
+
+        for (size_t digit = 0; digit < RECORD_SORT_RADIX; ++digit)
+        {
+            positions[digit] = position;
+            position        += counts[digit];
+        }
+
+        for (size_t i = 0; i < elem_number; ++i)
+            buffer[positions[normalized[index[i] * width + depth]]++] = index[i];
+
+        memcpy (index, buffer, elem_number * sizeof (size_t));
+
+        size_t bucket_begin = 0;
+
+        for (size_t digit = 0; digit < RECORD_SORT_RADIX; ++digit)
+        {
+            if (counts[digit] > 1)
+                RecordSortRange (context, index + bucket_begin, buffer + bucket_begin,
+                                 counts[digit], depth + 1);
+
+            bucket_begin += counts[digit];
+        }
+
+        return;
+    }
+}
+
+/**
+ * @details Keys are equal before depth, so only the rest is compared.
+ */
+static void
+RecordInsertionSort (const struct record_sort_context* const context,
+                     size_t* const                           index,
+                     const size_t                            elem_number,
+                     const size_t                            depth)
+{
+    assert (context);
+    assert (index);
+
+    for (size_t i = 1; i < elem_number; ++i)
+    {
+        const size_t cur_index = index[i];
+        size_t j = i;
+
+        while (j > 0 && RecordLess (context, cur_index, index[j - 1], depth))
+        {
+            index[j] = index[j - 1];
+            j--;
+        }
+
+        index[j] = cur_index;
+    }
+}
+
+/**
+ * @brief Sorts indices with equal normalized keys by the full comparator.
+ * @details Merge sort, so many strings with a long common prefix
+ * don't make the sort quadratic.
+ */
+static void
+RecordMergeSortTies (const struct record_sort_context* const context,
+                     size_t* const                           index,
+                     size_t* const                           buffer,
+                     const size_t                            elem_number)
+{
+    assert (context);
+    assert (index);
+    assert (buffer);
+
+    if (elem_number <= RECORD_SORT_INSERTION_MAX_SIZE)
+    {
+        RecordInsertionSort (context, index, elem_number, context->width);
+        return;
+    }
+
+    const size_t left_size = elem_number / 2;
+
+    RecordMergeSortTies (context, index,             buffer,             left_size);
+    RecordMergeSortTies (context, index + left_size, buffer + left_size,
+                         elem_number - left_size);
+
+    size_t left  = 0;
+    size_t right = left_size;
+    size_t dest  = 0;
+
+    while (left < left_size && right < elem_number)
+    {
+        if (RecordCompareByIndex (context, index[right], index[left]) < 0)
+            buffer[dest++] = index[right++];
+        else
+            buffer[dest++] = index[left++];
+    }
+
+    while (left  < left_size)   buffer[dest++] = index[left++];
+    while (right < elem_number) buffer[dest++] = index[right++];
+
+    memcpy (index, buffer, elem_number * sizeof (size_t));
+}
+
+/**
+ * @brief Compares normalized keys from depth, full records only on ties.
+ */
+static inline bool
+RecordLess (const struct record_sort_context* const context,
+            const size_t                            first,
+            const size_t                            second,
+            const size_t                            depth)
+{
+    assert (context);
+    assert (depth <= context->width);
+
+    const size_t width = context->width;
+
+    const int result = memcmp (context->normalized + first  * width + depth,
+                               context->normalized + second * width + depth,
+                               width - depth);
+
+    if (result != 0 || !context->need_compare) return result < 0;
+
+    return RecordCompareByIndex (context, first, second) < 0;
+}
+
+static inline int
+RecordCompareByIndex (const struct record_sort_context* const context,
+                      const size_t                            first,
+                      const size_t                            second)
+{
+    assert (context);
+
+    return RecordCompare (context->records + first  * context->record_size,
+                          context->records + second * context->record_size,
+                          context->keys, context->key_number);
+}
@@ -0,0 +1,338 @@
+#include "../include/segmented_sort.h"
+#include <pthread.h>
+
+/* comparators number of Batcher's network for 16 elements is 63 */
+#define SEGMENTED_SORT_NETWORK_MAX_COMPARATORS 64
+/* segments up to this size are sorted by networks and merged, bigger by radix sort */
+#define SEGMENTED_SORT_MERGE_MAX_SIZE 64
+
+/* arrays with less elements are sorted by one thread */
+const size_t SEGMENTED_SORT_PARALLEL_MIN_ELEM = 1 << 16;
+const size_t SEGMENTED_SORT_MAX_THREADS       = 8;
+
+/**
+ * @brief Comparators of sorting network for one size.
+ */
+struct sorting_network
+{
+    size_t  comparator_number;
+    uint8_t first [SEGMENTED_SORT_NETWORK_MAX_COMPARATORS];
+    uint8_t second[SEGMENTED_SORT_NETWORK_MAX_COMPARATORS];
+};
+
+/**
+ * @brief Segments [segment_from, segment_to) sorted by one thread.
+ */
+struct segmented_sort_task
+{
+    int*          array;
+    const size_t* offsets;
+    size_t        segment_from;
+    size_t        segment_to;
+};
+
+static struct sorting_network sorting_networks[SORT_KERNELS_NETWORK_MAX_SIZE + 1] = {};
+static pthread_once_t         sorting_networks_once = PTHREAD_ONCE_INIT;
+
+static void
+SortingNetworksInit (void);
+
+static void
+SortingNetworkBuild (struct sorting_network* const network,
+                     const size_t                  elem_number);
+
+static bool
+SortingNetworkCheck (const struct sorting_network* const network,
+                     const size_t                        elem_number);
+
+static inline void
+SortingNetworkSort (int* const   array,
+                    const size_t elem_number);
+
+static void
+SegmentNetworkMergeSort (int* const   array,
+                         const size_t elem_number);
+
+static void
+SegmentedSortRange (int* const          array,
+                    const size_t* const offsets,
+                    const size_t        segment_from,
+                    const size_t        segment_to);
+
+static void*
+SegmentedSortRoutine (void* task_ptr);
+
+void
+SegmentedSort (int* const          array,
+               const size_t* const offsets,
+               const size_t        segment_number)
+{
+    if (array == NULL || offsets == NULL || segment_number == 0) return;
+
+    const size_t elem_number   = offsets[segment_number] - offsets[0];
+    /* every thread gets at least a half of parallel threshold */
+    const size_t thread_number = SortThreadNumber (SEGMENTED_SORT_MAX_THREADS, elem_number,
+                                                   SEGMENTED_SORT_PARALLEL_MIN_ELEM / 2);
+
+    if (thread_number <= 1 || segment_number < thread_number)
+    {
+        SegmentedSortRange (array, offsets, 0, segment_number);
+        return;
+    }
+
+    struct segmented_sort_task tasks  [SEGMENTED_SORT_MAX_THREADS];
+    pthread_t                  threads[SEGMENTED_SORT_MAX_THREADS];
+    bool                       started[SEGMENTED_SORT_MAX_THREADS];
+
+    /* split by elements, not by segments, segments sizes may differ a lot */
+    size_t segment_index = 0;
+
+    for (size_t i = 0; i < thread_number; ++i)
+    {
+        const size_t elem_bound = offsets[0] + elem_number / thread_number * (i + 1);
+
+        tasks[i].array        = array;
+        tasks[i].offsets      = offsets;
+        tasks[i].segment_from = segment_index;
+
+        while (segment_index < segment_number &&
+               (offsets[segment_index + 1] <= elem_bound || i == thread_number - 1))
+            segment_index++;
+
+        tasks[i].segment_to = segment_index;
+    }
+
+    for (size_t i = 1; i < thread_number; ++i)
+        started[i] = pthread_create (&threads[i], NULL,
+                                     SegmentedSortRoutine, &tasks[i]) == 0;
+
+    SegmentedSortRoutine (&tasks[0]);
+
+    for (size_t i = 1; i < thread_number; ++i)
+    {
+        if (started[i]) pthread_join (threads[i], NULL);
+        else SegmentedSortRoutine (&tasks[i]);
+    }
+}
+
+static void*
+SegmentedSortRoutine (void* task_ptr)
+{
+    assert (task_ptr);
+    struct segmented_sort_task* const task = (struct segmented_sort_task*) task_ptr;
+
+    SegmentedSortRange (task->array, task->offsets,
+                        task->segment_from, task->segment_to);
+
+    return NULL;
+}
+
+static void
+SegmentedSortRange (int* const          array,
+                    const size_t* const offsets,
+                    const size_t        segment_from,
+                    const size_t        segment_to)
+{
+    assert (array);
+    assert (offsets);
+
+    /* one radix buffer for all big segments of the range */
+    size_t max_size = 0;
+
+    for (size_t i = segment_from; i < segment_to; ++i)
+    {
+        assert (offsets[i] <= offsets[i + 1]);
+
+        if (offsets[i + 1] - offsets[i] > max_size)
+            max_size = offsets[i + 1] - offsets[i];
+    }
+
+    int* buffer = NULL;
+
+    if (max_size > SEGMENTED_SORT_MERGE_MAX_SIZE)
+        buffer = (int*) malloc (max_size * sizeof (int));
+
+    for (size_t i = segment_from; i < segment_to; ++i)
+    {
+        int* const   segment      = array + offsets[i];
+        const size_t segment_size = offsets[i + 1] - offsets[i];
+
+        if (segment_size <= SORT_KERNELS_NETWORK_MAX_SIZE)
+            sort_kernels.network_sort (segment, segment_size);
+
+        else if (segment_size <= SEGMENTED_SORT_MERGE_MAX_SIZE)
+            SegmentNetworkMergeSort (segment, segment_size);
+
+        else if (buffer != NULL)
+            RadixSortWithBuffer (segment, segment_size, buffer);
+
+        else
+            RadixSort (segment, segment_size);
+    }
+
+    free (buffer);
+}
+
+//-----------------------------------------------------------------------------
+// Sorting networks
+//-----------------------------------------------------------------------------
+
+void
+NetworkSort (int* const   array,
+             const size_t elem_number)
+{
+    if (array == NULL || elem_number > SORT_KERNELS_NETWORK_MAX_SIZE) return;
+
+    pthread_once (&sorting_networks_once, SortingNetworksInit);
+
+    SortingNetworkSort (array, elem_number);
+}
+
+static inline void
+SortingNetworkSort (int* const   array,
+                    const size_t elem_number)
+{
+    assert (array);
+    assert (elem_number <= SORT_KERNELS_NETWORK_MAX_SIZE);
+
+    const struct sorting_network* const network = &sorting_networks[elem_number];
+
+    for (size_t i = 0; i < network->comparator_number; ++i)
+    {
+        const int first  = array[network->first [i]];
+        const int second = array[network->second[i]];
+
+        /* no branches, compiles to conditional moves */
+        array[network->first [i]] = (first < second) ? first  : second;
+        array[network->second[i]] = (first < second) ? second : first;
+    }
+}
+
+static void
+SortingNetworksInit (void)
+{
+    for (size_t size = 0; size <= SORT_KERNELS_NETWORK_MAX_SIZE; ++size)
+    {
+        SortingNetworkBuild (&sorting_networks[size], size);
+        assert (SortingNetworkCheck (&sorting_networks[size], size));
+    }
+}
+
+/**
+ * @brief Builds Batcher's odd-even merge sort network.
+ * @details Network is built for 16 elements, comparators touching
+ * elements after elem_number are dropped: these elements can be
+ * thought of as +inf, such comparators never swap anything.
+ */
+static void
+SortingNetworkBuild (struct sorting_network* const network,
+                     const size_t                  elem_number)
+{
+    assert (network);
+
+    const size_t network_size = SORT_KERNELS_NETWORK_MAX_SIZE;
+    network->comparator_number = 0;
+
+    for (size_t p = 1; p < network_size; p *= 2)
+    {
+        for (size_t k = p; k >= 1; k /= 2)
+        {
+            for (size_t j = k % p; j + k < network_size; j += 2 * k)
+            {
+                for (size_t i = 0; i < k && i + j + k < network_size; ++i)
+                {
+                    const size_t first  = i + j;
+                    const size_t second = i + j + k;
+
+                    if (first / (2 * p) != second / (2 * p)) continue;
+                    if (second >= elem_number) continue;
+
+                    assert (network->comparator_number < SEGMENTED_SORT_NETWORK_MAX_COMPARATORS);
+
+                    network->first [network->comparator_number] = (uint8_t) first;
+                    network->second[network->comparator_number] = (uint8_t) second;
+                    network->comparator_number++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Checks network by 0-1 principle: it sorts any input
+ * if it sorts all 2^elem_number inputs of zeroes and ones.
+ */
+static bool
+SortingNetworkCheck (const struct sorting_network* const network,
+                     const size_t                        elem_number)
+{
+    assert (network);
+
+    for (uint32_t input = 0; input < (1u << elem_number); ++input)
+    {
+        uint32_t bits = input;
+
+        for (size_t i = 0; i < network->comparator_number; ++i)
+        {
+            const uint32_t first_bit  = 1u << network->first [i];
+            const uint32_t second_bit = 1u << network->second[i];
+
+            /* 1 before 0, swap them */
+            if ((bits & first_bit) && !(bits & second_bit))
+                bits ^= first_bit | second_bit;
+        }
+
+        /* sorted: all ones are in the highest elements */
+        const uint32_t ones   = (uint32_t) __builtin_popcount (bits);
+        const uint32_t sorted = ((1u << ones) - 1) << (elem_number - ones);
+
+        if (bits != sorted) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sorts blocks of 16 elements by networks and merges them.
+ * @details Radix sort passes cost more than the whole segment here,
+ * insertion sort mispredicts a branch on almost every element.
+ */
+static void
+SegmentNetworkMergeSort (int* const   array,
+                         const size_t elem_number)
+{
+    assert (array);
+    assert (elem_number <= SEGMENTED_SORT_MERGE_MAX_SIZE);
+
+    int buffer[SEGMENTED_SORT_MERGE_MAX_SIZE];
+
+    for (size_t i = 0; i < elem_number; i += SORT_KERNELS_NETWORK_MAX_SIZE)
+    {
+        const size_t block_size = (elem_number - i < SORT_KERNELS_NETWORK_MAX_SIZE) ?
+                                  elem_number - i : SORT_KERNELS_NETWORK_MAX_SIZE;
+
+        sort_kernels.network_sort (array + i, block_size);
+    }
+
+    int* from = array;
+    int* to   = buffer;
+
+    for (size_t width = SORT_KERNELS_NETWORK_MAX_SIZE; width < elem_number; width *= 2)
+    {
+        for (size_t left = 0; left < elem_number; left += 2 * width)
+        {
+            const size_t middle = (left + width     < elem_number) ? left + width     : elem_number;
+            const size_t right  = (left + 2 * width < elem_number) ? left + 2 * width : elem_number;
+
+            sort_kernels.merge (from + left,   middle - left,
+                                from + middle, right - middle, to + left);
+        }
+
+        int* const tmp = from;
+        from = to;
+        to   = tmp;
+    }
+
+    if (from != array)
+        memcpy (array, from, elem_number * sizeof (int));
+}
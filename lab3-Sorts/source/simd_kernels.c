@@ -0,0 +1,1056 @@
+#include "../include/simd_kernels.h"
+#include <immintrin.h>
+#include <pthread.h>
+
+/* 32-bit lane counters of count_less are flushed after this many elements */
+const size_t SIMD_KERNELS_COUNT_BLOCK = 1 << 24;
+/* lanes of the widest vector, AVX-512 one */
+#define SIMD_KERNELS_MAX_LANES 16
+
+#define SSE42_TARGET  __attribute__ ((target ("sse4.2")))
+#define AVX2_TARGET   __attribute__ ((target ("avx2")))
+#define AVX512_TARGET __attribute__ ((target ("avx512f")))
+
+/**
+ * Lane permutations for partition kernels, row is the mask of lanes
+ * less than pivot: these lanes go first, the others go after them,
+ * both in their order. Rows of 4-lane masks start with 4-lane permutation.
+ */
+static uint8_t        partition_lanes   [256][8] = {};
+/* the same permutations for 4 lanes as pshufb byte indices */
+static uint8_t        partition_shuffles[16][16] = {};
+static pthread_once_t partition_lanes_once       = PTHREAD_ONCE_INIT;
+
+static void
+PartitionLanesInit (void);
+
+static inline bool
+MergeTakeFirst (const int* const first,
+                const size_t     first_index,
+                const size_t     first_size,
+                const int* const second,
+                const size_t     second_index,
+                const size_t     second_size);
+
+static void
+MergeTail (const int* const last,
+           const size_t     last_size,
+           const int* const first,
+           const size_t     first_size,
+           const int* const second,
+           const size_t     second_size,
+           int* const       dest);
+
+//-----------------------------------------------------------------------------
+// Generic
+//-----------------------------------------------------------------------------
+
+/**
+ * @details Four independent branchless accumulators, so the loop has
+ * no data dependencies between neighbours and can be vectorized.
+ */
+void
+MinMaxGeneric (const int* const array,
+               const size_t     elem_number,
+               int* const       min_value,
+               int* const       max_value)
+{
+    assert (array);
+    assert (elem_number > 0);
+    assert (min_value);
+    assert (max_value);
+
+    int min_values[4] = {array[0], array[0], array[0], array[0]};
+    int max_values[4] = {array[0], array[0], array[0], array[0]};
+
+    size_t i = 0;
+
+    for (; i + 4 <= elem_number; i += 4)
+    {
+        for (size_t j = 0; j < 4; ++j)
+        {
+            min_values[j] = array[i + j] < min_values[j] ? array[i + j] : min_values[j];
+            max_values[j] = array[i + j] > max_values[j] ? array[i + j] : max_values[j];
+        }
+    }
+
+    for (; i < elem_number; ++i)
+    {
+        min_values[0] = array[i] < min_values[0] ? array[i] : min_values[0];
+        max_values[0] = array[i] > max_values[0] ? array[i] : max_values[0];
+    }
+
+    *min_value = min_values[0];
+    *max_value = max_values[0];
+
+    for (size_t j = 1; j < 4; ++j)
+    {
+        if (min_values[j] < *min_value) *min_value = min_values[j];
+        if (max_values[j] > *max_value) *max_value = max_values[j];
+    }
+}
+
+size_t
+CountLessGeneric (const int* const array,
+                  const size_t     elem_number,
+                  const int        value)
+{
+    assert (array || elem_number == 0);
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+        count += (array[i] < value);
+
+    return count;
+}
+
+/**
+ * @details Every element is written to both ends, only one of the indices
+ * moves, so there are no branches. The other write is overwritten later,
+ * the last element is written twice to the same place.
+ */
+size_t
+PartitionGeneric (const int* const src,
+                  const size_t     elem_number,
+                  const int        pivot,
+                  int* const       dest)
+{
+    assert (src  || elem_number == 0);
+    assert (dest || elem_number == 0);
+
+    size_t less_index    = 0;
+    size_t greater_index = elem_number;     ///< dest[greater_index, n) are >= pivot
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        const int    value   = src[i];
+        const size_t is_less = (value < pivot);
+
+        dest[less_index]        = value;
+        dest[greater_index - 1] = value;
+
+        less_index    += is_less;
+        greater_index -= 1 - is_less;
+    }
+
+    assert (less_index == greater_index);
+
+    return less_index;
+}
+
+static void
+PartitionLanesInit (void)
+{
+    for (size_t mask = 0; mask < 256; ++mask)
+    {
+        size_t position = 0;
+
+        for (size_t lane = 0; lane < 8; ++lane)
+            if (mask & (1u << lane)) partition_lanes[mask][position++] = (uint8_t) lane;
+
+        for (size_t lane = 0; lane < 8; ++lane)
+            if (!(mask & (1u << lane))) partition_lanes[mask][position++] = (uint8_t) lane;
+    }
+
+    for (size_t mask = 0; mask < 16; ++mask)
+        for (size_t byte = 0; byte < 16; ++byte)
+            partition_shuffles[mask][byte] =
+                (uint8_t) (partition_lanes[mask][byte / 4] * 4 + byte % 4);
+}
+
+/**
+ * @brief Whether SIMD merge takes the next vector from the first array:
+ * the one with the smaller next element.
+ */
+static inline bool
+MergeTakeFirst (const int* const first,
+                const size_t     first_index,
+                const size_t     first_size,
+                const int* const second,
+                const size_t     second_index,
+                const size_t     second_size)
+{
+    return first_index < first_size &&
+           (second_index >= second_size || first[first_index] <= second[second_index]);
+}
+
+/**
+ * @brief Ends SIMD merge: merges elements left in register with tails of arrays.
+ * @details SIMD merge stops when the array with the smaller next element
+ * has no full vector left, so the shorter tail is shorter than a vector
+ * and is merged with the register elements in a small buffer first.
+ */
+static void
+MergeTail (const int* const last,
+           const size_t     last_size,
+           const int* const first,
+           const size_t     first_size,
+           const int* const second,
+           const size_t     second_size,
+           int* const       dest)
+{
+    assert (last);
+    assert (dest);
+
+    int buffer[2 * SIMD_KERNELS_MAX_LANES];
+
+    const bool         first_shorter = (first_size <= second_size);
+    const int* const   short_array   = first_shorter ? first       : second;
+    const size_t       short_size    = first_shorter ? first_size  : second_size;
+    const int* const   long_array    = first_shorter ? second      : first;
+    const size_t       long_size     = first_shorter ? second_size : first_size;
+
+    assert (last_size + short_size <= 2 * SIMD_KERNELS_MAX_LANES);
+
+    MergeSortedArrays (last,   last_size,              short_array, short_size, buffer);
+    MergeSortedArrays (buffer, last_size + short_size, long_array,  long_size,  dest);
+}
+
+//-----------------------------------------------------------------------------
+// SSE4.2
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Sorts bitonic sequence of 4 lanes: lanes take min or max
+ * of the lane at distance 2, then at distance 1.
+ */
+static inline SSE42_TARGET __m128i
+Sse42SortBitonic (__m128i values)
+{
+    __m128i partners = _mm_shuffle_epi32 (values, 0x4E);
+    values = _mm_blend_epi16 (_mm_min_epi32 (values, partners),
+                              _mm_max_epi32 (values, partners), 0xF0);
+
+    partners = _mm_shuffle_epi32 (values, 0xB1);
+    values   = _mm_blend_epi16 (_mm_min_epi32 (values, partners),
+                                _mm_max_epi32 (values, partners), 0xCC);
+
+    return values;
+}
+
+/**
+ * @brief Sorts 4 lanes: pairs are sorted in opposite directions,
+ * which makes a bitonic sequence.
+ */
+static inline SSE42_TARGET __m128i
+Sse42Sort (const __m128i values)
+{
+    const __m128i partners = _mm_shuffle_epi32 (values, 0xB1);
+
+    return Sse42SortBitonic (_mm_blend_epi16 (_mm_min_epi32 (values, partners),
+                                              _mm_max_epi32 (values, partners), 0x3C));
+}
+
+/**
+ * @brief Merges two sorted vectors: first and reversed second one
+ * make a bitonic sequence, its halves are split by min and max.
+ */
+static inline SSE42_TARGET void
+Sse42MergeVectors (const __m128i  first,
+                   const __m128i  second,
+                   __m128i* const low,
+                   __m128i* const high)
+{
+    const __m128i reversed = _mm_shuffle_epi32 (second, 0x1B);
+
+    *low  = Sse42SortBitonic (_mm_min_epi32 (first, reversed));
+    *high = Sse42SortBitonic (_mm_max_epi32 (first, reversed));
+}
+
+SSE42_TARGET void
+MinMaxSse42 (const int* const array,
+             const size_t     elem_number,
+             int* const       min_value,
+             int* const       max_value)
+{
+    assert (array);
+    assert (elem_number > 0);
+    assert (min_value);
+    assert (max_value);
+
+    __m128i min_vector = _mm_set1_epi32 (array[0]);
+    __m128i max_vector = min_vector;
+
+    size_t i = 0;
+
+    for (; i + 4 <= elem_number; i += 4)
+    {
+        const __m128i values = _mm_loadu_si128 ((const __m128i*) (array + i));
+
+        min_vector = _mm_min_epi32 (min_vector, values);
+        max_vector = _mm_max_epi32 (max_vector, values);
+    }
+
+    int min_values[4] = {};
+    int max_values[4] = {};
+
+    _mm_storeu_si128 ((__m128i*) min_values, min_vector);
+    _mm_storeu_si128 ((__m128i*) max_values, max_vector);
+
+    for (; i < elem_number; ++i)
+    {
+        if (array[i] < min_values[0]) min_values[0] = array[i];
+        if (array[i] > max_values[0]) max_values[0] = array[i];
+    }
+
+    *min_value = min_values[0];
+    *max_value = max_values[0];
+
+    for (size_t j = 1; j < 4; ++j)
+    {
+        if (min_values[j] < *min_value) *min_value = min_values[j];
+        if (max_values[j] > *max_value) *max_value = max_values[j];
+    }
+}
+
+/**
+ * @details Compare gives -1 in lanes with less elements,
+ * so counters are decremented by compare results.
+ */
+SSE42_TARGET size_t
+CountLessSse42 (const int* const array,
+                const size_t     elem_number,
+                const int        value)
+{
+    assert (array || elem_number == 0);
+
+    const __m128i value_vector = _mm_set1_epi32 (value);
+
+    size_t count = 0;
+    size_t i     = 0;
+
+    while (i + 4 <= elem_number)
+    {
+        const size_t block_end =
+            (elem_number - i > SIMD_KERNELS_COUNT_BLOCK) ?
+            i + SIMD_KERNELS_COUNT_BLOCK : elem_number;
+
+        __m128i counters = _mm_setzero_si128 ();
+
+        for (; i + 4 <= block_end; i += 4)
+        {
+            const __m128i values = _mm_loadu_si128 ((const __m128i*) (array + i));
+            counters = _mm_sub_epi32 (counters, _mm_cmplt_epi32 (values, value_vector));
+        }
+
+        uint32_t lane_counts[4] = {};
+        _mm_storeu_si128 ((__m128i*) lane_counts, counters);
+
+        for (size_t j = 0; j < 4; ++j)
+            count += lane_counts[j];
+    }
+
+    return count + CountLessGeneric (array + i, elem_number - i, value);
+}
+
+/**
+ * @details Vector is permuted by lookup table so that less lanes go first,
+ * and it is stored whole to both ends. Lanes past the partitioned ones
+ * land in the unwritten middle, while it has place for both stores.
+ */
+SSE42_TARGET size_t
+PartitionSse42 (const int* const src,
+                const size_t     elem_number,
+                const int        pivot,
+                int* const       dest)
+{
+    assert (src  || elem_number == 0);
+    assert (dest || elem_number == 0);
+
+    pthread_once (&partition_lanes_once, PartitionLanesInit);
+
+    const __m128i pivot_vector = _mm_set1_epi32 (pivot);
+
+    size_t less_index    = 0;
+    size_t greater_index = elem_number;
+
+    size_t i = 0;
+
+    for (; i + 8 <= elem_number; i += 4)
+    {
+        const __m128i values    = _mm_loadu_si128 ((const __m128i*) (src + i));
+        const int     less_mask =
+            _mm_movemask_ps (_mm_castsi128_ps (_mm_cmplt_epi32 (values, pivot_vector)));
+        const size_t  less_size = (size_t) __builtin_popcount (less_mask);
+
+        const __m128i partitioned =
+            _mm_shuffle_epi8 (values, _mm_loadu_si128 ((const __m128i*) partition_shuffles[less_mask]));
+
+        _mm_storeu_si128 ((__m128i*) (dest + less_index),        partitioned);
+        _mm_storeu_si128 ((__m128i*) (dest + greater_index - 4), partitioned);
+
+        less_index    += less_size;
+        greater_index -= 4 - less_size;
+    }
+
+    less_index += PartitionGeneric (src + i, elem_number - i, pivot, dest + less_index);
+
+    return less_index;
+}
+
+/**
+ * @details Register keeps 4 greatest merged elements, the next vector
+ * is taken from the array with the smaller next element.
+ */
+SSE42_TARGET void
+MergeSse42 (const int* const first,
+            const size_t     first_size,
+            const int* const second,
+            const size_t     second_size,
+            int* const       dest)
+{
+    assert (first_size  == 0 || first);
+    assert (second_size == 0 || second);
+    assert (dest);
+
+    if (first_size < 4 || second_size < 4)
+    {
+        MergeSortedArrays (first, first_size, second, second_size, dest);
+        return;
+    }
+
+    __m128i low  = _mm_loadu_si128 ((const __m128i*) first);
+    __m128i high = _mm_loadu_si128 ((const __m128i*) second);
+
+    size_t first_index  = 4;
+    size_t second_index = 4;
+    size_t dest_index   = 0;
+
+    while (true)
+    {
+        Sse42MergeVectors (low, high, &low, &high);
+
+        _mm_storeu_si128 ((__m128i*) (dest + dest_index), low);
+        dest_index += 4;
+
+        const bool take_first = MergeTakeFirst (first,  first_index,  first_size,
+                                                second, second_index, second_size);
+
+        if (take_first && first_index + 4 <= first_size)
+        {
+            low = _mm_loadu_si128 ((const __m128i*) (first + first_index));
+            first_index += 4;
+        }
+
+        else if (!take_first && second_index + 4 <= second_size)
+        {
+            low = _mm_loadu_si128 ((const __m128i*) (second + second_index));
+            second_index += 4;
+        }
+
+        else break;
+    }
+
+    int last[4] = {};
+    _mm_storeu_si128 ((__m128i*) last, high);
+
+    MergeTail (last, 4, first  + first_index,  first_size  - first_index,
+                        second + second_index, second_size - second_index,
+                        dest + dest_index);
+}
+
+/**
+ * @details Missing elements are padded with INT_MAX and stay at the end.
+ * Four sorted vectors are merged pairwise, then two sorted halves
+ * are merged by one more bitonic step on pairs of vectors.
+ */
+SSE42_TARGET void
+NetworkSortSse42 (int* const   array,
+                  const size_t elem_number)
+{
+    assert (array || elem_number == 0);
+    assert (elem_number <= 16);
+
+    if (elem_number <= 1) return;
+
+    int padded[16] = {};
+
+    for (size_t i = 0; i < 16; ++i)
+        padded[i] = (i < elem_number) ? array[i] : INT_MAX;
+
+    __m128i values[4] = {};
+
+    for (size_t i = 0; i < 4; ++i)
+        values[i] = Sse42Sort (_mm_loadu_si128 ((const __m128i*) (padded + 4 * i)));
+
+    Sse42MergeVectors (values[0], values[1], &values[0], &values[1]);
+    Sse42MergeVectors (values[2], values[3], &values[2], &values[3]);
+
+    /* halves of bitonic 16 elements, then halves of both 8 element parts */
+    const __m128i reversed[2] = {_mm_shuffle_epi32 (values[3], 0x1B),
+                                 _mm_shuffle_epi32 (values[2], 0x1B)};
+
+    const __m128i low [2] = {_mm_min_epi32 (values[0], reversed[0]),
+                             _mm_min_epi32 (values[1], reversed[1])};
+    const __m128i high[2] = {_mm_max_epi32 (values[0], reversed[0]),
+                             _mm_max_epi32 (values[1], reversed[1])};
+
+    values[0] = Sse42SortBitonic (_mm_min_epi32 (low [0], low [1]));
+    values[1] = Sse42SortBitonic (_mm_max_epi32 (low [0], low [1]));
+    values[2] = Sse42SortBitonic (_mm_min_epi32 (high[0], high[1]));
+    values[3] = Sse42SortBitonic (_mm_max_epi32 (high[0], high[1]));
+
+    for (size_t i = 0; i < 4; ++i)
+        _mm_storeu_si128 ((__m128i*) (padded + 4 * i), values[i]);
+
+    for (size_t i = 0; i < elem_number; ++i)
+        array[i] = padded[i];
+}
+
+//-----------------------------------------------------------------------------
+// AVX2
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Sorts bitonic sequence of 8 lanes: lanes take min or max
+ * of the lane at distance 4, 2 and 1.
+ */
+static inline AVX2_TARGET __m256i
+Avx2SortBitonic (__m256i values)
+{
+    __m256i partners = _mm256_permute2x128_si256 (values, values, 0x01);
+    values = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                 _mm256_max_epi32 (values, partners), 0xF0);
+
+    partners = _mm256_shuffle_epi32 (values, 0x4E);
+    values   = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                   _mm256_max_epi32 (values, partners), 0xCC);
+
+    partners = _mm256_shuffle_epi32 (values, 0xB1);
+    values   = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                   _mm256_max_epi32 (values, partners), 0xAA);
+
+    return values;
+}
+
+/**
+ * @brief Sorts 8 lanes by bitonic sort, blend masks select lanes taking max:
+ * upper lane of the pair in ascending block, lower one in descending block.
+ */
+static inline AVX2_TARGET __m256i
+Avx2Sort (__m256i values)
+{
+    __m256i partners = _mm256_shuffle_epi32 (values, 0xB1);
+    values = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                 _mm256_max_epi32 (values, partners), 0x66);
+
+    partners = _mm256_shuffle_epi32 (values, 0x4E);
+    values   = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                   _mm256_max_epi32 (values, partners), 0x3C);
+
+    partners = _mm256_shuffle_epi32 (values, 0xB1);
+    values   = _mm256_blend_epi32 (_mm256_min_epi32 (values, partners),
+                                   _mm256_max_epi32 (values, partners), 0x5A);
+
+    return Avx2SortBitonic (values);
+}
+
+static inline AVX2_TARGET void
+Avx2MergeVectors (const __m256i  first,
+                  const __m256i  second,
+                  __m256i* const low,
+                  __m256i* const high)
+{
+    const __m256i reversed =
+        _mm256_permutevar8x32_epi32 (second, _mm256_setr_epi32 (7, 6, 5, 4, 3, 2, 1, 0));
+
+    *low  = Avx2SortBitonic (_mm256_min_epi32 (first, reversed));
+    *high = Avx2SortBitonic (_mm256_max_epi32 (first, reversed));
+}
+
+AVX2_TARGET void
+MinMaxAvx2 (const int* const array,
+            const size_t     elem_number,
+            int* const       min_value,
+            int* const       max_value)
+{
+    assert (array);
+    assert (elem_number > 0);
+    assert (min_value);
+    assert (max_value);
+
+    /* two pairs of accumulators hide min/max latency */
+    __m256i min_vectors[2] = {_mm256_set1_epi32 (array[0]), _mm256_set1_epi32 (array[0])};
+    __m256i max_vectors[2] = {min_vectors[0], min_vectors[0]};
+
+    size_t i = 0;
+
+    for (; i + 16 <= elem_number; i += 16)
+    {
+        for (size_t j = 0; j < 2; ++j)
+        {
+            const __m256i values =
+                _mm256_loadu_si256 ((const __m256i*) (array + i + 8 * j));
+
+            min_vectors[j] = _mm256_min_epi32 (min_vectors[j], values);
+            max_vectors[j] = _mm256_max_epi32 (max_vectors[j], values);
+        }
+    }
+
+    const __m256i min_vector = _mm256_min_epi32 (min_vectors[0], min_vectors[1]);
+    const __m256i max_vector = _mm256_max_epi32 (max_vectors[0], max_vectors[1]);
+
+    int min_values[8] = {};
+    int max_values[8] = {};
+
+    _mm256_storeu_si256 ((__m256i*) min_values, min_vector);
+    _mm256_storeu_si256 ((__m256i*) max_values, max_vector);
+
+    for (; i < elem_number; ++i)
+    {
+        if (array[i] < min_values[0]) min_values[0] = array[i];
+        if (array[i] > max_values[0]) max_values[0] = array[i];
+    }
+
+    *min_value = min_values[0];
+    *max_value = max_values[0];
+
+    for (size_t j = 1; j < 8; ++j)
+    {
+        if (min_values[j] < *min_value) *min_value = min_values[j];
+        if (max_values[j] > *max_value) *max_value = max_values[j];
+    }
+}
+
+AVX2_TARGET size_t
+CountLessAvx2 (const int* const array,
+               const size_t     elem_number,
+               const int        value)
+{
+    assert (array || elem_number == 0);
+
+    const __m256i value_vector = _mm256_set1_epi32 (value);
+
+    size_t count = 0;
+    size_t i     = 0;
+
+    while (i + 8 <= elem_number)
+    {
+        const size_t block_end =
+            (elem_number - i > SIMD_KERNELS_COUNT_BLOCK) ?
+            i + SIMD_KERNELS_COUNT_BLOCK : elem_number;
+
+        __m256i counters = _mm256_setzero_si256 ();
+
+        for (; i + 8 <= block_end; i += 8)
+        {
+            const __m256i values = _mm256_loadu_si256 ((const __m256i*) (array + i));
+            counters = _mm256_sub_epi32 (counters, _mm256_cmpgt_epi32 (value_vector, values));
+        }
+
+        uint32_t lane_counts[8] = {};
+        _mm256_storeu_si256 ((__m256i*) lane_counts, counters);
+
+        for (size_t j = 0; j < 8; ++j)
+            count += lane_counts[j];
+    }
+
+    return count + CountLessGeneric (array + i, elem_number - i, value);
+}
+
+/**
+ * @details The same as PartitionSse42() with 8 lanes, the permutation
+ * is applied by permutevar8x32.
+ */
+AVX2_TARGET size_t
+PartitionAvx2 (const int* const src,
+               const size_t     elem_number,
+               const int        pivot,
+               int* const       dest)
+{
+    assert (src  || elem_number == 0);
+    assert (dest || elem_number == 0);
+
+    pthread_once (&partition_lanes_once, PartitionLanesInit);
+
+    const __m256i pivot_vector = _mm256_set1_epi32 (pivot);
+
+    size_t less_index    = 0;
+    size_t greater_index = elem_number;
+
+    size_t i = 0;
+
+    for (; i + 16 <= elem_number; i += 8)
+    {
+        const __m256i values    = _mm256_loadu_si256 ((const __m256i*) (src + i));
+        const int     less_mask =
+            _mm256_movemask_ps (_mm256_castsi256_ps (_mm256_cmpgt_epi32 (pivot_vector, values)));
+        const size_t  less_size = (size_t) __builtin_popcount (less_mask);
+
+        const __m256i lanes =
+            _mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((const __m128i*) partition_lanes[less_mask]));
+        const __m256i partitioned = _mm256_permutevar8x32_epi32 (values, lanes);
+
+        _mm256_storeu_si256 ((__m256i*) (dest + less_index),        partitioned);
+        _mm256_storeu_si256 ((__m256i*) (dest + greater_index - 8), partitioned);
+
+        less_index    += less_size;
+        greater_index -= 8 - less_size;
+    }
+
+    less_index += PartitionGeneric (src + i, elem_number - i, pivot, dest + less_index);
+
+    return less_index;
+}
+
+AVX2_TARGET void
+MergeAvx2 (const int* const first,
+           const size_t     first_size,
+           const int* const second,
+           const size_t     second_size,
+           int* const       dest)
+{
+    assert (first_size  == 0 || first);
+    assert (second_size == 0 || second);
+    assert (dest);
+
+    if (first_size < 8 || second_size < 8)
+    {
+        MergeSortedArrays (first, first_size, second, second_size, dest);
+        return;
+    }
+
+    __m256i low  = _mm256_loadu_si256 ((const __m256i*) first);
+    __m256i high = _mm256_loadu_si256 ((const __m256i*) second);
+
+    size_t first_index  = 8;
+    size_t second_index = 8;
+    size_t dest_index   = 0;
+
+    while (true)
+    {
+        Avx2MergeVectors (low, high, &low, &high);
+
+        _mm256_storeu_si256 ((__m256i*) (dest + dest_index), low);
+        dest_index += 8;
+
+        const bool take_first = MergeTakeFirst (first,  first_index,  first_size,
+                                                second, second_index, second_size);
+
+        if (take_first && first_index + 8 <= first_size)
+        {
+            low = _mm256_loadu_si256 ((const __m256i*) (first + first_index));
+            first_index += 8;
+        }
+
+        else if (!take_first && second_index + 8 <= second_size)
+        {
+            low = _mm256_loadu_si256 ((const __m256i*) (second + second_index));
+            second_index += 8;
+        }
+
+        else break;
+    }
+
+    int last[8] = {};
+    _mm256_storeu_si256 ((__m256i*) last, high);
+
+    MergeTail (last, 8, first  + first_index,  first_size  - first_index,
+                        second + second_index, second_size - second_index,
+                        dest + dest_index);
+}
+
+/**
+ * @details Two vectors are loaded with masks and padded with INT_MAX,
+ * sorted and merged.
+ */
+AVX2_TARGET void
+NetworkSortAvx2 (int* const   array,
+                 const size_t elem_number)
+{
+    assert (array || elem_number == 0);
+    assert (elem_number <= 16);
+
+    if (elem_number <= 1) return;
+
+    const __m256i lanes      = _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i max_vector = _mm256_set1_epi32 (INT_MAX);
+
+    const __m256i low_mask  = _mm256_cmpgt_epi32 (_mm256_set1_epi32 ((int) elem_number),     lanes);
+    const __m256i high_mask = _mm256_cmpgt_epi32 (_mm256_set1_epi32 ((int) elem_number - 8), lanes);
+
+    __m256i low  = _mm256_blendv_epi8 (max_vector, _mm256_maskload_epi32 (array,     low_mask),
+                                       low_mask);
+    __m256i high = _mm256_blendv_epi8 (max_vector, _mm256_maskload_epi32 (array + 8, high_mask),
+                                       high_mask);
+
+    Avx2MergeVectors (Avx2Sort (low), Avx2Sort (high), &low, &high);
+
+    _mm256_maskstore_epi32 (array,     low_mask,  low);
+    _mm256_maskstore_epi32 (array + 8, high_mask, high);
+}
+
+//-----------------------------------------------------------------------------
+// AVX-512
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Sorts bitonic sequence of 16 lanes, lane takes max
+ * if it is the upper lane of the pair.
+ */
+static inline AVX512_TARGET __m512i
+Avx512SortBitonic (__m512i values)
+{
+    const __m512i lanes = _mm512_setr_epi32 (0, 1, 2,  3,  4,  5,  6,  7,
+                                             8, 9, 10, 11, 12, 13, 14, 15);
+
+    for (int j = 8; j > 0; j /= 2)
+    {
+        const __m512i j_vector = _mm512_set1_epi32 (j);
+        const __m512i partners =
+            _mm512_permutexvar_epi32 (_mm512_xor_si512 (lanes, j_vector), values);
+
+        values = _mm512_mask_blend_epi32 (_mm512_test_epi32_mask (lanes, j_vector),
+                                          _mm512_min_epi32 (values, partners),
+                                          _mm512_max_epi32 (values, partners));
+    }
+
+    return values;
+}
+
+static inline AVX512_TARGET void
+Avx512MergeVectors (const __m512i  first,
+                    const __m512i  second,
+                    __m512i* const low,
+                    __m512i* const high)
+{
+    const __m512i reversed =
+        _mm512_permutexvar_epi32 (_mm512_setr_epi32 (15, 14, 13, 12, 11, 10, 9, 8,
+                                                     7,  6,  5,  4,  3,  2,  1, 0), second);
+
+    *low  = Avx512SortBitonic (_mm512_min_epi32 (first, reversed));
+    *high = Avx512SortBitonic (_mm512_max_epi32 (first, reversed));
+}
+
+/**
+ * @details Tail is read with masked load, masked out lanes keep array[0],
+ * so they don't change the result.
+ */
+AVX512_TARGET void
+MinMaxAvx512 (const int* const array,
+              const size_t     elem_number,
+              int* const       min_value,
+              int* const       max_value)
+{
+    assert (array);
+    assert (elem_number > 0);
+    assert (min_value);
+    assert (max_value);
+
+    const __m512i first_vector = _mm512_set1_epi32 (array[0]);
+
+    __m512i min_vector = first_vector;
+    __m512i max_vector = first_vector;
+
+    size_t i = 0;
+
+    for (; i + 16 <= elem_number; i += 16)
+    {
+        const __m512i values = _mm512_loadu_si512 (array + i);
+
+        min_vector = _mm512_min_epi32 (min_vector, values);
+        max_vector = _mm512_max_epi32 (max_vector, values);
+    }
+
+    if (i < elem_number)
+    {
+        const __mmask16 tail_mask = (__mmask16) ((1u << (elem_number - i)) - 1);
+        const __m512i   values    =
+            _mm512_mask_loadu_epi32 (first_vector, tail_mask, array + i);
+
+        min_vector = _mm512_min_epi32 (min_vector, values);
+        max_vector = _mm512_max_epi32 (max_vector, values);
+    }
+
+    *min_value = _mm512_reduce_min_epi32 (min_vector);
+    *max_value = _mm512_reduce_max_epi32 (max_vector);
+}
+
+AVX512_TARGET size_t
+CountLessAvx512 (const int* const array,
+                 const size_t     elem_number,
+                 const int        value)
+{
+    assert (array || elem_number == 0);
+
+    const __m512i value_vector = _mm512_set1_epi32 (value);
+
+    size_t count = 0;
+    size_t i     = 0;
+
+    for (; i + 16 <= elem_number; i += 16)
+    {
+        const __m512i values = _mm512_loadu_si512 (array + i);
+        count += (size_t) __builtin_popcount (_mm512_cmplt_epi32_mask (values, value_vector));
+    }
+
+    if (i < elem_number)
+    {
+        const __mmask16 tail_mask = (__mmask16) ((1u << (elem_number - i)) - 1);
+        const __m512i   values    = _mm512_maskz_loadu_epi32 (tail_mask, array + i);
+
+        count += (size_t) __builtin_popcount (
+                    _mm512_mask_cmplt_epi32_mask (tail_mask, values, value_vector));
+    }
+
+    return count;
+}
+
+/**
+ * @details Compress store writes lanes selected by compare mask one by one,
+ * so 16 elements are partitioned with two stores and no branches.
+ */
+AVX512_TARGET size_t
+PartitionAvx512 (const int* const src,
+                 const size_t     elem_number,
+                 const int        pivot,
+                 int* const       dest)
+{
+    assert (src  || elem_number == 0);
+    assert (dest || elem_number == 0);
+
+    const __m512i pivot_vector = _mm512_set1_epi32 (pivot);
+
+    size_t less_index    = 0;
+    size_t greater_index = elem_number;
+
+    size_t i = 0;
+
+    for (; i + 16 <= elem_number; i += 16)
+    {
+        const __m512i   values    = _mm512_loadu_si512 (src + i);
+        const __mmask16 less_mask = _mm512_cmplt_epi32_mask (values, pivot_vector);
+        const size_t    less_size = (size_t) __builtin_popcount (less_mask);
+
+        _mm512_mask_compressstoreu_epi32 (dest + less_index, less_mask, values);
+        less_index += less_size;
+
+        greater_index -= 16 - less_size;
+        _mm512_mask_compressstoreu_epi32 (dest + greater_index,
+                                          (__mmask16) ~less_mask, values);
+    }
+
+    if (i < elem_number)
+    {
+        const __mmask16 tail_mask = (__mmask16) ((1u << (elem_number - i)) - 1);
+        const __m512i   values    = _mm512_maskz_loadu_epi32 (tail_mask, src + i);
+        const __mmask16 less_mask =
+            _mm512_mask_cmplt_epi32_mask (tail_mask, values, pivot_vector);
+        const size_t    less_size = (size_t) __builtin_popcount (less_mask);
+
+        _mm512_mask_compressstoreu_epi32 (dest + less_index, less_mask, values);
+        less_index += less_size;
+
+        greater_index -= (elem_number - i) - less_size;
+        _mm512_mask_compressstoreu_epi32 (dest + greater_index,
+                                          (__mmask16) (tail_mask & ~less_mask), values);
+    }
+
+    assert (less_index == greater_index);
+
+    return less_index;
+}
+
+/**
+ * @brief Bitonic sort of 16 elements in one register.
+ * @details Missing elements are padded with INT_MAX and stay at the end.
+ * On every step lane takes min or max of itself and lane ^ j:
+ * max if it is the upper lane of the pair in ascending block of size k,
+ * or the lower lane in descending block.
+ */
+AVX512_TARGET void
+NetworkSortAvx512 (int* const   array,
+                   const size_t elem_number)
+{
+    assert (array || elem_number == 0);
+    assert (elem_number <= 16);
+
+    if (elem_number <= 1) return;
+
+    const __mmask16 load_mask = (__mmask16) ((1u << elem_number) - 1);
+    const __m512i   lanes     = _mm512_setr_epi32 (0, 1, 2,  3,  4,  5,  6,  7,
+                                                   8, 9, 10, 11, 12, 13, 14, 15);
+
+    __m512i values = _mm512_mask_loadu_epi32 (_mm512_set1_epi32 (INT_MAX),
+                                              load_mask, array);
+
+    for (int k = 2; k <= 16; k *= 2)
+    {
+        const __mmask16 descending =
+            _mm512_test_epi32_mask (lanes, _mm512_set1_epi32 (k));
+
+        for (int j = k / 2; j > 0; j /= 2)
+        {
+            const __m512i j_vector = _mm512_set1_epi32 (j);
+            const __m512i partners =
+                _mm512_permutexvar_epi32 (_mm512_xor_si512 (lanes, j_vector), values);
+
+            const __mmask16 take_max =
+                _mm512_test_epi32_mask (lanes, j_vector) ^ descending;
+
+            values = _mm512_mask_blend_epi32 (take_max,
+                                              _mm512_min_epi32 (values, partners),
+                                              _mm512_max_epi32 (values, partners));
+        }
+    }
+
+    _mm512_mask_storeu_epi32 (array, load_mask, values);
+}
+
+AVX512_TARGET void
+MergeAvx512 (const int* const first,
+             const size_t     first_size,
+             const int* const second,
+             const size_t     second_size,
+             int* const       dest)
+{
+    assert (first_size  == 0 || first);
+    assert (second_size == 0 || second);
+    assert (dest);
+
+    if (first_size < 16 || second_size < 16)
+    {
+        MergeSortedArrays (first, first_size, second, second_size, dest);
+        return;
+    }
+
+    __m512i low  = _mm512_loadu_si512 (first);
+    __m512i high = _mm512_loadu_si512 (second);
+
+    size_t first_index  = 16;
+    size_t second_index = 16;
+    size_t dest_index   = 0;
+
+    while (true)
+    {
+        Avx512MergeVectors (low, high, &low, &high);
+
+        _mm512_storeu_si512 (dest + dest_index, low);
+        dest_index += 16;
+
+        const bool take_first = MergeTakeFirst (first,  first_index,  first_size,
+                                                second, second_index, second_size);
+
+        if (take_first && first_index + 16 <= first_size)
+        {
+            low = _mm512_loadu_si512 (first + first_index);
+            first_index += 16;
+        }
+
+        else if (!take_first && second_index + 16 <= second_size)
+        {
+            low = _mm512_loadu_si512 (second + second_index);
+            second_index += 16;
+        }
+
+        else break;
+    }
+
+    int last[16] = {};
+    _mm512_storeu_si512 (last, high);
+
+    MergeTail (last, 16, first  + first_index,  first_size  - first_index,
+                         second + second_index, second_size - second_index,
+                         dest + dest_index);
+}
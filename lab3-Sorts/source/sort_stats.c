@@ -0,0 +1,41 @@
+#include "../include/sort_stats.h"
+#include <assert.h>
+#include <string.h>
+
+struct sort_stats sort_stats_counters = {};
+
+void
+SortStatsReset (void)
+{
+    memset (&sort_stats_counters, 0, sizeof (struct sort_stats));
+}
+
+void
+SortStatsPrint (FILE* const output)
+{
+    assert (output);
+
+#ifdef SORT_STATS
+    fprintf (output, " %zu %zu %zu %zu",
+             sort_stats_counters.comparisons,
+             sort_stats_counters.swaps,
+             sort_stats_counters.bytes_moved,
+             sort_stats_counters.max_depth);
+#else
+    (void) output;
+#endif
+}
+
+#ifdef SORT_CMP_COST
+
+/* volatile, so dummy work is not optimized out */
+static volatile unsigned sort_compare_cost_sink = 0;
+
+void
+SortCompareCost (void)
+{
+    for (unsigned i = 0; i < (unsigned) (SORT_CMP_COST); ++i)
+        sort_compare_cost_sink = sort_compare_cost_sink * 31 + i;
+}
+
+#endif /* SORT_CMP_COST */
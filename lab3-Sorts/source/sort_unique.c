@@ -0,0 +1,278 @@
+#include "../include/sort_unique.h"
+
+/* table is resized when it is half full */
+const size_t   SORT_UNIQUE_MAX_LOAD_FACTOR = 2;
+const size_t   SORT_UNIQUE_INIT_CAPACITY   = 1 << 10;
+/* after this many elements hashing stops if most keys are distinct */
+const size_t   SORT_UNIQUE_SAMPLE_SIZE     = 1 << 16;
+/* keys are mostly distinct if distinct_keys * 4 > elements * 3 */
+const size_t   SORT_UNIQUE_DISTINCT_NUMER  = 4;
+const size_t   SORT_UNIQUE_DISTINCT_DENOM  = 3;
+/* Fibonacci hashing: 2^64 / golden ratio */
+const uint64_t SORT_UNIQUE_HASH_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief Open addressing hash table with linear probing.
+ * Slot is empty if its count is 0.
+ */
+struct count_table
+{
+    struct key_count* slots;
+    size_t            capacity;     ///< Power of 2.
+    size_t            capacity_log;
+    size_t            size;         ///< Number of distinct keys.
+};
+
+static size_t
+SortCountBySort (const int* const         array,
+                 const size_t             elem_number,
+                 struct key_count** const key_counts);
+
+static bool
+CountTableInit (struct count_table* const table,
+                const size_t              capacity_log);
+
+static bool
+CountTableAdd (struct count_table* const table,
+               const int                 key,
+               const size_t              count);
+
+static bool
+CountTableGrow (struct count_table* const table);
+
+static size_t
+CountTableFind (const struct count_table* const table,
+                const int                       key);
+
+static inline size_t
+CountTableHash (const struct count_table* const table,
+                const int                       key);
+
+size_t
+SortCount (const int* const         array,
+           const size_t             elem_number,
+           struct key_count** const key_counts)
+{
+    if (key_counts == NULL) return 0;
+    *key_counts = NULL;
+
+    if (array == NULL || elem_number == 0) return 0;
+
+    size_t capacity_log = 0;
+
+    while (((size_t) 1 << capacity_log) < SORT_UNIQUE_INIT_CAPACITY &&
+           ((size_t) 1 << capacity_log) < elem_number * SORT_UNIQUE_MAX_LOAD_FACTOR)
+        capacity_log++;
+
+    struct count_table table = {};
+    if (!CountTableInit (&table, capacity_log)) return 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        if (!CountTableAdd (&table, array[i], 1))
+        {
+            free (table.slots);
+            return 0;
+        }
+
+        /* hash table only slows down sorting of mostly distinct keys */
+        if (i + 1 == SORT_UNIQUE_SAMPLE_SIZE &&
+            table.size * SORT_UNIQUE_DISTINCT_NUMER >
+            SORT_UNIQUE_SAMPLE_SIZE * SORT_UNIQUE_DISTINCT_DENOM)
+        {
+            free (table.slots);
+            return SortCountBySort (array, elem_number, key_counts);
+        }
+    }
+
+    /* sort only distinct keys, then take their counts from the table */
+    int* const keys = (int*) malloc (table.size * sizeof (int));
+    struct key_count* const result =
+        (struct key_count*) malloc (table.size * sizeof (struct key_count));
+
+    if (keys == NULL || result == NULL)
+    {
+        free (keys);
+        free (result);
+        free (table.slots);
+        return 0;
+    }
+
+    size_t key_index = 0;
+
+    for (size_t i = 0; i < table.capacity; ++i)
+        if (table.slots[i].count != 0)
+            keys[key_index++] = table.slots[i].key;
+
+    RadixSort (keys, table.size);
+
+    for (size_t i = 0; i < table.size; ++i)
+    {
+        result[i].key   = keys[i];
+        result[i].count = table.slots[CountTableFind (&table, keys[i])].count;
+    }
+
+    const size_t key_number = table.size;
+
+    free (keys);
+    free (table.slots);
+
+    *key_counts = result;
+    return key_number;
+}
+
+size_t
+SortUnique (int* const   array,
+            const size_t elem_number)
+{
+    struct key_count* key_counts = NULL;
+
+    const size_t key_number = SortCount (array, elem_number, &key_counts);
+
+    for (size_t i = 0; i < key_number; ++i)
+        array[i] = key_counts[i].key;
+
+    free (key_counts);
+
+    return key_number;
+}
+
+/**
+ * @brief Sorts copy of array and counts equal neighbours.
+ */
+static size_t
+SortCountBySort (const int* const         array,
+                 const size_t             elem_number,
+                 struct key_count** const key_counts)
+{
+    assert (array);
+    assert (key_counts);
+
+    int* const sorted = (int*) malloc (elem_number * sizeof (int));
+    if (sorted == NULL) return 0;
+
+    memcpy (sorted, array, elem_number * sizeof (int));
+    RadixSort (sorted, elem_number);
+
+    size_t key_number = 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+        if (i == 0 || sorted[i] != sorted[i - 1])
+            key_number++;
+
+    struct key_count* const result =
+        (struct key_count*) malloc (key_number * sizeof (struct key_count));
+    if (result == NULL)
+    {
+        free (sorted);
+        return 0;
+    }
+
+    size_t key_index = 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        if (i == 0 || sorted[i] != sorted[i - 1])
+        {
+            result[key_index].key   = sorted[i];
+            result[key_index].count = 0;
+            key_index++;
+        }
+
+        result[key_index - 1].count++;
+    }
+
+    free (sorted);
+
+    *key_counts = result;
+    return key_number;
+}
+
+static bool
+CountTableInit (struct count_table* const table,
+                const size_t              capacity_log)
+{
+    assert (table);
+
+    table->capacity     = (size_t) 1 << capacity_log;
+    table->capacity_log = capacity_log;
+    table->size         = 0;
+    table->slots =
+        (struct key_count*) calloc (table->capacity, sizeof (struct key_count));
+
+    return table->slots != NULL;
+}
+
+static bool
+CountTableAdd (struct count_table* const table,
+               const int                 key,
+               const size_t              count)
+{
+    assert (table);
+    assert (count > 0);
+
+    const size_t slot = CountTableFind (table, key);
+
+    if (table->slots[slot].count != 0)
+    {
+        table->slots[slot].count += count;
+        return true;
+    }
+
+    table->slots[slot].key   = key;
+    table->slots[slot].count = count;
+    table->size++;
+
+    if (table->size * SORT_UNIQUE_MAX_LOAD_FACTOR > table->capacity)
+        return CountTableGrow (table);
+
+    return true;
+}
+
+static bool
+CountTableGrow (struct count_table* const table)
+{
+    assert (table);
+
+    struct count_table new_table = {};
+    if (!CountTableInit (&new_table, table->capacity_log + 1)) return false;
+
+    for (size_t i = 0; i < table->capacity; ++i)
+        if (table->slots[i].count != 0)
+            CountTableAdd (&new_table, table->slots[i].key, table->slots[i].count);
+
+    free (table->slots);
+    *table = new_table;
+
+    return true;
+}
+
+/**
+ * @brief Index of the slot with key or of the empty slot where it should be.
+ */
+static size_t
+CountTableFind (const struct count_table* const table,
+                const int                       key)
+{
+    assert (table);
+
+    const size_t mask = table->capacity - 1;
+    size_t slot = CountTableHash (table, key);
+
+    while (table->slots[slot].count != 0 && table->slots[slot].key != key)
+        slot = (slot + 1) & mask;
+
+    return slot;
+}
+
+static inline size_t
+CountTableHash (const struct count_table* const table,
+                const int                       key)
+{
+    assert (table);
+
+    if (table->capacity_log == 0) return 0;
+
+    return (size_t) (((uint64_t) (uint32_t) key * SORT_UNIQUE_HASH_MULTIPLIER) >>
+                     (64 - table->capacity_log));
+}
@@ -0,0 +1,327 @@
+#include "../include/sorted_runs.h"
+
+const size_t SORTED_RUNS_DEFAULT_FAN_OUT  = 4;
+const size_t SORTED_RUNS_INIT_RUNS_NUMBER = 4;
+/* binary search stops at this range, the rest is counted by SIMD kernel */
+const size_t SORTED_RUNS_SCAN_SIZE        = 64;
+
+static sorted_runs_error_t
+SortedRunsMergeTail (struct sorted_runs* const runs,
+                     const size_t              run_number);
+
+static void
+SortedRunsMergeRound (struct sorted_run* const views,
+                      const size_t             view_number,
+                      int* const               dest);
+
+static size_t
+SortedRunsLevel (size_t       run_size,
+                 const size_t fan_out);
+
+static size_t
+RunLowerBound (const struct sorted_run* const run,
+               const int                      value);
+
+struct sorted_runs*
+SortedRunsConstructor (const size_t fan_out)
+{
+    if (fan_out < 2) return NULL;
+
+    struct sorted_runs* const runs =
+        (struct sorted_runs*) calloc (1, sizeof (struct sorted_runs));
+    if (runs == NULL) return NULL;
+
+    runs->runs = DynamicArrayConstructor (SORTED_RUNS_INIT_RUNS_NUMBER,
+                                          sizeof (struct sorted_run),
+                                          DYNAMIC_ARRAY_REALLOC_ENABLED,
+                                          DYNAMIC_ARRAY_DESTROY);
+    if (runs->runs == NULL)
+    {
+        free (runs);
+        return NULL;
+    }
+
+    runs->fan_out     = fan_out;
+    runs->elem_number = 0;
+
+    return runs;
+}
+
+struct sorted_runs*
+SortedRunsDestructor (struct sorted_runs* const runs)
+{
+    if (runs == NULL) return NULL;
+
+    struct sorted_run* const all_runs = (struct sorted_run*) runs->runs->data_array;
+
+    for (size_t i = 0; i < runs->runs->data_array_size; ++i)
+        free (all_runs[i].array);
+
+    runs->runs        = DynamicArrayDestructor (runs->runs);
+    runs->fan_out     = 0;
+    runs->elem_number = 0;
+
+    free (runs);
+
+    return NULL;
+}
+
+sorted_runs_error_t
+SortedRunsAppend (struct sorted_runs* const runs,
+                  const int* const          batch,
+                  const size_t              batch_size)
+{
+    if (runs == NULL || (batch == NULL && batch_size != 0))
+        return SORTED_RUNS_ERROR;
+
+    if (batch_size == 0) return SORTED_RUNS_SUCCESS;
+
+    struct sorted_run new_run = {};
+
+    new_run.array = (int*) malloc (batch_size * sizeof (int));
+    new_run.size  = batch_size;
+    if (new_run.array == NULL) return SORTED_RUNS_ERROR;
+
+    memcpy (new_run.array, batch, batch_size * sizeof (int));
+    QuickHoareSort (new_run.array, batch_size);
+
+    if (DynamicArrayPush (runs->runs, &new_run) == DYNAMIC_ARRAY_ERROR)
+    {
+        free (new_run.array);
+        return SORTED_RUNS_ERROR;
+    }
+
+    runs->elem_number += batch_size;
+
+    /* merge tail runs while there are fan_out of them with levels <= last one */
+    while (runs->runs->data_array_size >= 2)
+    {
+        const struct sorted_run* const all_runs =
+            (const struct sorted_run*) runs->runs->data_array;
+        const size_t run_number = runs->runs->data_array_size;
+
+        const size_t last_level =
+            SortedRunsLevel (all_runs[run_number - 1].size, runs->fan_out);
+
+        size_t tail_number = 0;
+
+        while (tail_number < run_number &&
+               SortedRunsLevel (all_runs[run_number - 1 - tail_number].size,
+                                runs->fan_out) <= last_level)
+            tail_number++;
+
+        if (tail_number < runs->fan_out) break;
+
+        /* runs are still valid if merge failed, it will be done later */
+        if (SortedRunsMergeTail (runs, tail_number) == SORTED_RUNS_ERROR) break;
+    }
+
+    return SORTED_RUNS_SUCCESS;
+}
+
+const int*
+SortedRunsMaterialize (struct sorted_runs* const runs)
+{
+    if (runs == NULL || runs->runs->data_array_size == 0) return NULL;
+
+    if (runs->runs->data_array_size > 1 &&
+        SortedRunsMergeTail (runs, runs->runs->data_array_size) == SORTED_RUNS_ERROR)
+        return NULL;
+
+    return ((const struct sorted_run*) runs->runs->data_array)[0].array;
+}
+
+size_t
+SortedRunsLowerBound (const struct sorted_runs* const runs,
+                      const int                       value)
+{
+    if (runs == NULL) return 0;
+
+    const struct sorted_run* const all_runs =
+        (const struct sorted_run*) runs->runs->data_array;
+
+    size_t rank = 0;
+
+    for (size_t i = 0; i < runs->runs->data_array_size; ++i)
+        rank += RunLowerBound (&all_runs[i], value);
+
+    return rank;
+}
+
+size_t
+SortedRunsRunNumber (const struct sorted_runs* const runs)
+{
+    if (runs == NULL) return 0;
+
+    return runs->runs->data_array_size;
+}
+
+int*
+SortedRunsMerge (const struct sorted_run* const runs,
+                 const size_t                   run_number)
+{
+    if (runs == NULL || run_number == 0) return NULL;
+
+    size_t total_size = 0;
+
+    for (size_t i = 0; i < run_number; ++i)
+        total_size += runs[i].size;
+
+    struct sorted_run* const views =
+        (struct sorted_run*) malloc (run_number * sizeof (struct sorted_run));
+    int* buffers[2] =
+    {
+        (int*) malloc (total_size * sizeof (int)),
+        (run_number > 2) ? (int*) malloc (total_size * sizeof (int)) : NULL
+    };
+
+    if (views == NULL || buffers[0] == NULL || (run_number > 2 && buffers[1] == NULL))
+    {
+        free (views);
+        free (buffers[0]);
+        free (buffers[1]);
+        return NULL;
+    }
+
+    if (run_number == 1)
+    {
+        memcpy (buffers[0], runs[0].array, total_size * sizeof (int));
+        free (views);
+        return buffers[0];
+    }
+
+    /* first round reads runs themselves */
+    memcpy (views, runs, run_number * sizeof (struct sorted_run));
+
+    size_t view_number = run_number;
+    size_t cur_buffer  = 0;
+
+    while (view_number > 1)
+    {
+        SortedRunsMergeRound (views, view_number, buffers[cur_buffer]);
+
+        view_number = (view_number + 1) / 2;
+        cur_buffer ^= 1;
+    }
+
+    /* result is in the last written buffer */
+    free (buffers[cur_buffer]);
+    free (views);
+
+    return buffers[cur_buffer ^ 1];
+}
+
+/**
+ * @brief Merges last run_number runs into one with SortedRunsMerge().
+ */
+static sorted_runs_error_t
+SortedRunsMergeTail (struct sorted_runs* const runs,
+                     const size_t              run_number)
+{
+    assert (runs);
+    assert (run_number >= 2);
+    assert (run_number <= runs->runs->data_array_size);
+
+    struct sorted_run* const tail_runs =
+        (struct sorted_run*) runs->runs->data_array +
+        runs->runs->data_array_size - run_number;
+
+    size_t total_size = 0;
+
+    for (size_t i = 0; i < run_number; ++i)
+        total_size += tail_runs[i].size;
+
+    int* const merged = SortedRunsMerge (tail_runs, run_number);
+    if (merged == NULL) return SORTED_RUNS_ERROR;
+
+    for (size_t i = 0; i < run_number; ++i)
+        free (tail_runs[i].array);
+
+    tail_runs[0].array = merged;
+    tail_runs[0].size  = total_size;
+
+    /* runs number only decreases, so no realloc is needed */
+    runs->runs->data_array_size -= run_number - 1;
+
+    return SORTED_RUNS_SUCCESS;
+}
+
+/**
+ * @brief Merges views in pairs into dest, odd last view is copied.
+ * @details Views lie one after another, so every merged pair takes
+ * the place of both views in dest. Views are replaced by merged ones.
+ */
+static void
+SortedRunsMergeRound (struct sorted_run* const views,
+                      const size_t             view_number,
+                      int* const               dest)
+{
+    assert (views);
+    assert (dest);
+
+    size_t dest_index = 0;
+
+    for (size_t i = 0; i < view_number; i += 2)
+    {
+        struct sorted_run merged_view = {dest + dest_index, views[i].size};
+
+        if (i + 1 < view_number)
+        {
+            sort_kernels.merge (views[i].array,     views[i].size,
+                                views[i + 1].array, views[i + 1].size,
+                                merged_view.array);
+
+            merged_view.size += views[i + 1].size;
+        }
+
+        else
+            memcpy (merged_view.array, views[i].array, views[i].size * sizeof (int));
+
+        dest_index    += merged_view.size;
+        views[i / 2]   = merged_view;
+    }
+}
+
+static size_t
+SortedRunsLevel (size_t       run_size,
+                 const size_t fan_out)
+{
+    assert (fan_out >= 2);
+
+    size_t level = 0;
+
+    while (run_size >= fan_out)
+    {
+        run_size /= fan_out;
+        level++;
+    }
+
+    return level;
+}
+
+/**
+ * @details Binary search narrows the range to a few cache lines,
+ * then less elements of the range are counted without branches.
+ */
+static size_t
+RunLowerBound (const struct sorted_run* const run,
+               const int                      value)
+{
+    assert (run);
+
+    size_t left_index  = 0;
+    size_t right_index = run->size;
+
+    while (right_index - left_index > SORTED_RUNS_SCAN_SIZE)
+    {
+        const size_t mid_index = left_index + (right_index - left_index) / 2;
+
+        if (INT_LESS (run->array[mid_index], value))
+            left_index  = mid_index + 1;
+        else
+            right_index = mid_index;
+    }
+
+    return left_index + sort_kernels.count_less (run->array + left_index,
+                                                 right_index - left_index, value);
+}
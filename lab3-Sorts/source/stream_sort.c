@@ -0,0 +1,291 @@
+#include "../include/stream_sort.h"
+#include <pthread.h>
+
+/* 1 << 16 ints take 256 KB, chunk is sorted in L2 cache */
+const size_t STREAM_SORT_CHUNK_SIZE       = 1 << 16;
+const size_t STREAM_SORT_READ_BUFFER_SIZE = 1 << 16;
+const size_t STREAM_SORT_INIT_CHUNKS      = 16;
+const size_t STREAM_SORT_MAX_THREADS      = 8;
+
+/**
+ * @brief State shared by the reading thread and workers.
+ * @details All fields are protected by mutex. Chunks [0, sorted_number)
+ * are given to workers, array pointers of chunks never change,
+ * so a worker may sort its chunk without the lock.
+ */
+struct stream_sort_state
+{
+    pthread_mutex_t      mutex;
+    pthread_cond_t       chunk_ready;
+
+    struct sorted_run*   chunks;        ///< Chunks, sorted by one of the workers.
+    size_t               chunk_number;
+    size_t               chunk_capacity;
+    size_t               given_number;  ///< Chunks taken by workers.
+
+    bool                 input_ended;
+};
+
+/**
+ * @brief Parser of ints split between read buffers.
+ */
+struct stream_parser
+{
+    long long value;
+    bool      negative;
+    bool      in_number;
+};
+
+static bool
+StreamSortAddChunk (struct stream_sort_state* const state,
+                    const struct sorted_run         chunk);
+
+static void*
+StreamSortWorker (void* state_ptr);
+
+static size_t
+StreamParse (struct stream_parser* const parser,
+             const char* const           buffer,
+             const size_t                buffer_size,
+             int* const                  dest,
+             const size_t                dest_size,
+             size_t* const               parsed_bytes);
+
+int*
+StreamSort (FILE* const   input,
+            size_t* const elem_number)
+{
+    if (input == NULL || elem_number == NULL) return NULL;
+    *elem_number = 0;
+
+    struct stream_sort_state state = {};
+    pthread_mutex_init (&state.mutex, NULL);
+    pthread_cond_init  (&state.chunk_ready, NULL);
+
+    char* const read_buffer = (char*) malloc (STREAM_SORT_READ_BUFFER_SIZE);
+
+    state.chunk_capacity = STREAM_SORT_INIT_CHUNKS;
+    state.chunks = (struct sorted_run*) calloc (state.chunk_capacity,
+                                                sizeof (struct sorted_run));
+
+    /* one worker at least, so sorting overlaps reading even on one core */
+    const size_t thread_number = SortThreadNumber (STREAM_SORT_MAX_THREADS, 0, 0);
+    pthread_t threads[STREAM_SORT_MAX_THREADS];
+    bool      started[STREAM_SORT_MAX_THREADS];
+
+    for (size_t i = 0; i < thread_number; ++i)
+        started[i] = (read_buffer != NULL && state.chunks != NULL) &&
+                     pthread_create (&threads[i], NULL, StreamSortWorker, &state) == 0;
+
+    struct stream_parser parser = {};
+    struct sorted_run    chunk  = {};
+    bool   success    = (read_buffer != NULL && state.chunks != NULL);
+    size_t total_size = 0;
+
+    while (success)
+    {
+        const size_t read_bytes =
+            fread (read_buffer, sizeof (char), STREAM_SORT_READ_BUFFER_SIZE, input);
+
+        /* one more pass over empty buffer ends the last number */
+        const bool input_ended = (read_bytes == 0);
+        size_t buffer_index = 0;
+
+        do
+        {
+            if (chunk.array == NULL)
+            {
+                chunk.array = (int*) malloc (STREAM_SORT_CHUNK_SIZE * sizeof (int));
+                chunk.size  = 0;
+                if (chunk.array == NULL) { success = false; break; }
+            }
+
+            size_t parsed_bytes = 0;
+
+            chunk.size += StreamParse (&parser, read_buffer + buffer_index,
+                                       read_bytes - buffer_index,
+                                       chunk.array + chunk.size,
+                                       STREAM_SORT_CHUNK_SIZE - chunk.size,
+                                       &parsed_bytes);
+            buffer_index += parsed_bytes;
+
+            if (chunk.size == STREAM_SORT_CHUNK_SIZE ||
+                (input_ended && chunk.size > 0))
+            {
+                total_size += chunk.size;
+                success = StreamSortAddChunk (&state, chunk);
+
+                if (!success) free (chunk.array);
+                chunk.array = NULL;
+            }
+        }
+        while (success && buffer_index < read_bytes);
+
+        if (input_ended) break;
+    }
+
+    free (chunk.array);
+
+    pthread_mutex_lock (&state.mutex);
+    state.input_ended = true;
+    pthread_cond_broadcast (&state.chunk_ready);
+    pthread_mutex_unlock (&state.mutex);
+
+    /* reading thread helps to sort the rest, or sorts everything without workers */
+    StreamSortWorker (&state);
+
+    for (size_t i = 0; i < thread_number; ++i)
+        if (started[i]) pthread_join (threads[i], NULL);
+
+    int* result = NULL;
+
+    if (success && total_size > 0)
+        result = SortedRunsMerge (state.chunks, state.chunk_number);
+
+    if (result != NULL) *elem_number = total_size;
+
+    for (size_t i = 0; i < state.chunk_number; ++i)
+        free (state.chunks[i].array);
+
+    free (state.chunks);
+    free (read_buffer);
+    pthread_mutex_destroy (&state.mutex);
+    pthread_cond_destroy  (&state.chunk_ready);
+
+    return result;
+}
+
+static bool
+StreamSortAddChunk (struct stream_sort_state* const state,
+                    const struct sorted_run         chunk)
+{
+    assert (state);
+
+    pthread_mutex_lock (&state->mutex);
+
+    if (state->chunk_number == state->chunk_capacity)
+    {
+        struct sorted_run* const new_chunks =
+            (struct sorted_run*) realloc (state->chunks, 2 * state->chunk_capacity *
+                                                         sizeof (struct sorted_run));
+        if (new_chunks == NULL)
+        {
+            pthread_mutex_unlock (&state->mutex);
+            return false;
+        }
+
+        state->chunks          = new_chunks;
+        state->chunk_capacity *= 2;
+    }
+
+    state->chunks[state->chunk_number++] = chunk;
+
+    pthread_cond_signal  (&state->chunk_ready);
+    pthread_mutex_unlock (&state->mutex);
+
+    return true;
+}
+
+/**
+ * @brief Takes chunks one by one and sorts them until input ends.
+ */
+static void*
+StreamSortWorker (void* state_ptr)
+{
+    assert (state_ptr);
+    struct stream_sort_state* const state = (struct stream_sort_state*) state_ptr;
+
+    int* const buffer = (int*) malloc (STREAM_SORT_CHUNK_SIZE * sizeof (int));
+
+    while (true)
+    {
+        pthread_mutex_lock (&state->mutex);
+
+        while (state->given_number == state->chunk_number && !state->input_ended)
+            pthread_cond_wait (&state->chunk_ready, &state->mutex);
+
+        if (state->given_number == state->chunk_number)
+        {
+            pthread_mutex_unlock (&state->mutex);
+            break;
+        }
+
+        const struct sorted_run chunk = state->chunks[state->given_number++];
+
+        pthread_mutex_unlock (&state->mutex);
+
+        if (buffer != NULL) RadixSortWithBuffer (chunk.array, chunk.size, buffer);
+        else                RadixSort           (chunk.array, chunk.size);
+    }
+
+    free (buffer);
+
+    return NULL;
+}
+
+/**
+ * @brief Parses ints from buffer to dest until one of them ends.
+ * @details Number at the end of buffer is kept in parser and finished
+ * with the next buffer. Empty buffer means end of input.
+ * @return Number of parsed ints, parsed_bytes is set to number of used bytes.
+ */
+static size_t
+StreamParse (struct stream_parser* const parser,
+             const char* const           buffer,
+             const size_t                buffer_size,
+             int* const                  dest,
+             const size_t                dest_size,
+             size_t* const               parsed_bytes)
+{
+    assert (parser);
+    assert (dest);
+    assert (parsed_bytes);
+
+    size_t dest_index = 0;
+    size_t i = 0;
+
+    if (buffer_size == 0)
+    {
+        if (parser->in_number && dest_size > 0)
+        {
+            dest[dest_index++] = (int) (parser->negative ? -parser->value : parser->value);
+            parser->in_number = false;
+        }
+
+        *parsed_bytes = 0;
+        return dest_index;
+    }
+
+    assert (buffer);
+
+    for (; i < buffer_size && dest_index < dest_size; ++i)
+    {
+        const char cur_char = buffer[i];
+
+        if (cur_char >= '0' && cur_char <= '9')
+        {
+            if (!parser->in_number)
+            {
+                parser->in_number = true;
+                parser->value     = 0;
+            }
+
+            parser->value = parser->value * 10 + (cur_char - '0');
+        }
+
+        else
+        {
+            if (parser->in_number)
+            {
+                dest[dest_index++] = (int) (parser->negative ? -parser->value : parser->value);
+                parser->in_number = false;
+            }
+
+            /* '-' right after digits ends the number and is the sign of the next one */
+            parser->negative = (cur_char == '-');
+        }
+    }
+
+    *parsed_bytes = i;
+    return dest_index;
+}
@@ -0,0 +1,484 @@
+#include "../include/string_sort.h"
+
+/* ranges smaller than this are sorted by insertion sort */
+const size_t STRING_SORT_INSERTION_MAX_NUMBER = 16;
+/* StringSort() uses burstsort for arrays of this size and bigger */
+const size_t STRING_SORT_BURST_MIN_NUMBER     = 1 << 16;
+/* bucket of 8192 refs takes 128 KB */
+const size_t BURST_SORT_BUCKET_MAX_SIZE       = 8192;
+const size_t BURST_SORT_BUCKET_INIT_CAPACITY  = 16;
+/* deeper buckets never burst, so long equal strings don't make a node chain */
+const size_t BURST_SORT_MAX_DEPTH             = 64;
+
+/* one slot for ended strings and one for every byte value */
+#define BURST_SORT_SLOT_NUMBER 257
+
+/**
+ * @brief Trie node of burstsort. Slot is either a bucket or a child node.
+ * @details Slot 0 holds strings that end at the node depth, these
+ * strings are all equal and never burst.
+ */
+struct burst_node
+{
+    struct dynamic_array* buckets[BURST_SORT_SLOT_NUMBER];
+    struct burst_node*    children[BURST_SORT_SLOT_NUMBER];
+};
+
+static inline uint16_t
+StringChar (const struct string_ref* const string,
+            const size_t                   depth);
+
+static void
+MultikeyQuickSortRange (struct string_ref* strings,
+                        uint16_t*          cache,
+                        size_t             string_number,
+                        size_t             depth);
+
+static void
+MultikeyFillCache (const struct string_ref* const strings,
+                   uint16_t* const                cache,
+                   const size_t                   string_number,
+                   const size_t                   depth);
+
+static void
+MultikeySwap (struct string_ref* const strings,
+              uint16_t* const          cache,
+              const size_t             first,
+              const size_t             second);
+
+static uint16_t
+MultikeyPivot (const uint16_t* const cache,
+               const size_t          string_number);
+
+static void
+StringInsertionSort (struct string_ref* const strings,
+                     const size_t             string_number,
+                     const size_t             depth);
+
+static int
+StringCompareFrom (const struct string_ref* const first,
+                   const struct string_ref* const second,
+                   const size_t                   depth);
+
+static bool
+BurstSortInsert (struct burst_node*             node,
+                 const struct string_ref* const string);
+
+static bool
+BurstSortPush (struct burst_node*             node,
+               const size_t                   depth,
+               const struct string_ref* const string);
+
+static bool
+BurstSortBurst (struct burst_node* const node,
+                const size_t             depth,
+                const size_t             slot);
+
+static size_t
+BurstSortTraverse (struct burst_node* const node,
+                   const size_t             depth,
+                   struct string_ref* const strings,
+                   size_t                   write_index,
+                   uint16_t* const          cache);
+
+static struct burst_node*
+BurstNodeDestructor (struct burst_node* const node);
+
+int
+StringRefCompare (const struct string_ref* const first,
+                  const struct string_ref* const second)
+{
+    assert (first);
+    assert (second);
+
+    return StringCompareFrom (first, second, 0);
+}
+
+void
+StringSort (struct string_ref* const strings,
+            const size_t             string_number)
+{
+    if (string_number >= STRING_SORT_BURST_MIN_NUMBER)
+        BurstSort (strings, string_number);
+
+    else
+        MultikeyQuickSort (strings, string_number);
+}
+
+//-----------------------------------------------------------------------------
+// Multikey quick sort
+//-----------------------------------------------------------------------------
+
+void
+MultikeyQuickSort (struct string_ref* const strings,
+                   const size_t             string_number)
+{
+    if (strings == NULL || string_number <= 1) return;
+
+    uint16_t* const cache =
+        (uint16_t*) calloc (string_number, sizeof (uint16_t));
+
+    if (cache == NULL)
+    {
+        StringInsertionSort (strings, string_number, 0);
+        return;
+    }
+
+    MultikeyFillCache (strings, cache, string_number, 0);
+    MultikeyQuickSortRange (strings, cache, string_number, 0);
+
+    free (cache);
+}
+
+/**
+ * @brief Character of string at depth plus one, 0 if string has ended.
+ * @details So ended strings go before all the others.
+ */
+static inline uint16_t
+StringChar (const struct string_ref* const string,
+            const size_t                   depth)
+{
+    assert (string);
+
+    return (depth < string->len) ?
+           (uint16_t) ((unsigned char) string->str[depth] + 1) : 0;
+}
+
+/**
+ * @brief Sorts strings with equal first depth characters.
+ * @warning cache must hold characters of the strings at depth.
+ */
+static void
+MultikeyQuickSortRange (struct string_ref* strings,
+                        uint16_t*          cache,
+                        size_t             string_number,
+                        size_t             depth)
+{
+    assert (strings);
+    assert (cache);
+
+    /* = part goes to the next depth in the loop, < and > parts recursively */
+    while (string_number > 1)
+    {
+        if (string_number < STRING_SORT_INSERTION_MAX_NUMBER)
+        {
+            StringInsertionSort (strings, string_number, depth);
+            return;
+        }
+
+        const uint16_t pivot = MultikeyPivot (cache, string_number);
+
+        size_t less_end      = 0;
+        size_t cur_index     = 0;
+        size_t greater_begin = string_number;
+
+        while (cur_index < greater_begin)
+        {
+            if      (cache[cur_index] < pivot)
+                MultikeySwap (strings, cache, less_end++, cur_index++);
+
+            else if (cache[cur_index] > pivot)
+                MultikeySwap (strings, cache, cur_index, --greater_begin);
+
+            else
+                cur_index++;
+        }
+
+        /* cache is still valid for < and > parts, they have the same depth */
+        MultikeyQuickSortRange (strings, cache, less_end, depth);
+        MultikeyQuickSortRange (strings + greater_begin, cache + greater_begin,
+                                string_number - greater_begin, depth);
+
+        /* all strings of = part have ended, so they are equal */
+        if (pivot == 0) return;
+
+        strings       += less_end;
+        cache         += less_end;
+        string_number  = greater_begin - less_end;
+        depth++;
+
+        MultikeyFillCache (strings, cache, string_number, depth);
+    }
+}
+
+static void
+MultikeyFillCache (const struct string_ref* const strings,
+                   uint16_t* const                cache,
+                   const size_t                   string_number,
+                   const size_t                   depth)
+{
+    assert (strings);
+    assert (cache);
+
+    for (size_t i = 0; i < string_number; ++i)
+        cache[i] = StringChar (&strings[i], depth);
+}
+
+static void
+MultikeySwap (struct string_ref* const strings,
+              uint16_t* const          cache,
+              const size_t             first,
+              const size_t             second)
+{
+    assert (strings);
+    assert (cache);
+
+    const struct string_ref temp_string = strings[first];
+    strings[first]  = strings[second];
+    strings[second] = temp_string;
+
+    const uint16_t temp_char = cache[first];
+    cache[first]  = cache[second];
+    cache[second] = temp_char;
+}
+
+/**
+ * @brief Median of first, middle and last cached characters.
+ */
+static uint16_t
+MultikeyPivot (const uint16_t* const cache,
+               const size_t          string_number)
+{
+    assert (cache);
+    assert (string_number > 0);
+
+    const uint16_t first  = cache[0];
+    const uint16_t middle = cache[string_number / 2];
+    const uint16_t last   = cache[string_number - 1];
+
+    if (first < middle)
+    {
+        if (middle < last) return middle;
+        return (first < last) ? last : first;
+    }
+
+    if (first < last) return first;
+    return (middle < last) ? last : middle;
+}
+
+static void
+StringInsertionSort (struct string_ref* const strings,
+                     const size_t             string_number,
+                     const size_t             depth)
+{
+    assert (strings);
+
+    for (size_t i = 1; i < string_number; ++i)
+    {
+        const struct string_ref cur_string = strings[i];
+        size_t j = i;
+
+        while (j > 0 && StringCompareFrom (&strings[j - 1], &cur_string, depth) > 0)
+        {
+            strings[j] = strings[j - 1];
+            j--;
+        }
+
+        strings[j] = cur_string;
+    }
+}
+
+/**
+ * @brief Compares strings which are known to be equal before depth.
+ */
+static int
+StringCompareFrom (const struct string_ref* const first,
+                   const struct string_ref* const second,
+                   const size_t                   depth)
+{
+    assert (first);
+    assert (second);
+
+    const size_t min_len = (first->len < second->len) ? first->len : second->len;
+
+    if (depth < min_len)
+    {
+        const int result = memcmp (first->str + depth, second->str + depth,
+                                   min_len - depth);
+        if (result != 0) return result;
+    }
+
+    return (first->len > second->len) - (first->len < second->len);
+}
+
+//-----------------------------------------------------------------------------
+// Burstsort
+//-----------------------------------------------------------------------------
+
+void
+BurstSort (struct string_ref* const strings,
+           const size_t             string_number)
+{
+    if (strings == NULL || string_number <= 1) return;
+
+    struct burst_node* const root =
+        (struct burst_node*) calloc (1, sizeof (struct burst_node));
+
+    /* one cache for all buckets, none of them is bigger than input */
+    uint16_t* const cache =
+        (uint16_t*) calloc (string_number, sizeof (uint16_t));
+
+    bool inserted = (root != NULL && cache != NULL);
+
+    for (size_t i = 0; inserted && i < string_number; ++i)
+        inserted = BurstSortInsert (root, &strings[i]);
+
+    if (inserted)
+        BurstSortTraverse (root, 0, strings, 0, cache);
+
+    BurstNodeDestructor (root);
+    free (cache);
+
+    /* refs are copied to buckets, input is untouched until traverse */
+    if (!inserted)
+        MultikeyQuickSort (strings, string_number);
+}
+
+static bool
+BurstSortInsert (struct burst_node*             node,
+                 const struct string_ref* const string)
+{
+    assert (node);
+    assert (string);
+
+    size_t depth = 0;
+    uint16_t slot = StringChar (string, depth);
+
+    while (node->children[slot] != NULL)
+    {
+        node = node->children[slot];
+        depth++;
+        slot = StringChar (string, depth);
+    }
+
+    return BurstSortPush (node, depth, string);
+}
+
+/**
+ * @brief Pushes string to the bucket of node, bursts the bucket if it is full.
+ */
+static bool
+BurstSortPush (struct burst_node*             node,
+               const size_t                   depth,
+               const struct string_ref* const string)
+{
+    assert (node);
+    assert (string);
+
+    const uint16_t slot = StringChar (string, depth);
+
+    if (node->buckets[slot] == NULL)
+    {
+        node->buckets[slot] =
+            DynamicArrayConstructor (BURST_SORT_BUCKET_INIT_CAPACITY,
+                                     sizeof (struct string_ref),
+                                     DYNAMIC_ARRAY_REALLOC_ENABLED,
+                                     DYNAMIC_ARRAY_DESTROY);
+        if (node->buckets[slot] == NULL) return false;
+    }
+
+    if (DynamicArrayPush (node->buckets[slot], string) == DYNAMIC_ARRAY_ERROR)
+        return false;
+
+    if (slot != 0 && depth < BURST_SORT_MAX_DEPTH &&
+        node->buckets[slot]->data_array_size > BURST_SORT_BUCKET_MAX_SIZE)
+        return BurstSortBurst (node, depth, slot);
+
+    return true;
+}
+
+/**
+ * @brief Replaces bucket in slot with a new node and moves its strings there.
+ * @details Strings of the bucket have equal characters up to depth
+ * inclusive, new node distributes them by the character at depth + 1.
+ */
+static bool
+BurstSortBurst (struct burst_node* const node,
+                const size_t             depth,
+                const size_t             slot)
+{
+    assert (node);
+    assert (slot != 0);
+
+    struct burst_node* const child =
+        (struct burst_node*) calloc (1, sizeof (struct burst_node));
+    if (child == NULL) return false;
+
+    struct dynamic_array* bucket = node->buckets[slot];
+    const struct string_ref* const bucket_strings =
+        (const struct string_ref*) bucket->data_array;
+
+    node->children[slot] = child;
+    node->buckets[slot]  = NULL;
+
+    bool pushed = true;
+
+    for (size_t i = 0; pushed && i < bucket->data_array_size; ++i)
+        pushed = BurstSortPush (child, depth + 1, &bucket_strings[i]);
+
+    bucket = DynamicArrayDestructor (bucket);
+
+    return pushed;
+}
+
+/**
+ * @brief Sorts buckets and writes strings back to array in trie order.
+ * @return Index after the last written string.
+ */
+static size_t
+BurstSortTraverse (struct burst_node* const node,
+                   const size_t             depth,
+                   struct string_ref* const strings,
+                   size_t                   write_index,
+                   uint16_t* const          cache)
+{
+    assert (node);
+    assert (strings);
+    assert (cache);
+
+    for (size_t slot = 0; slot < BURST_SORT_SLOT_NUMBER; ++slot)
+    {
+        if (node->children[slot] != NULL)
+        {
+            write_index = BurstSortTraverse (node->children[slot], depth + 1,
+                                             strings, write_index, cache);
+            continue;
+        }
+
+        const struct dynamic_array* const bucket = node->buckets[slot];
+        if (bucket == NULL) continue;
+
+        struct string_ref* const bucket_strings = strings + write_index;
+
+        memcpy (bucket_strings, bucket->data_array,
+                bucket->data_array_size * sizeof (struct string_ref));
+
+        /* slot 0 strings are equal, others share depth + 1 characters */
+        if (slot != 0)
+        {
+            MultikeyFillCache (bucket_strings, cache, bucket->data_array_size, depth + 1);
+            MultikeyQuickSortRange (bucket_strings, cache,
+                                    bucket->data_array_size, depth + 1);
+        }
+
+        write_index += bucket->data_array_size;
+    }
+
+    return write_index;
+}
+
+static struct burst_node*
+BurstNodeDestructor (struct burst_node* const node)
+{
+    if (node == NULL) return NULL;
+
+    for (size_t slot = 0; slot < BURST_SORT_SLOT_NUMBER; ++slot)
+    {
+        DynamicArrayDestructor (node->buckets[slot]);
+        BurstNodeDestructor    (node->children[slot]);
+    }
+
+    free (node);
+
+    return NULL;
+}
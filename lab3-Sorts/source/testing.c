@@ -3,6 +3,135 @@
 const size_t TEST_FILE_NAME_MAX_LEN = 0x10;
 const size_t NUMBER_MAX_LEN_IN_CHAR = 0x10;
 
+const size_t TEST_STRING_PREFIX_NUMBER  = 16;
+const size_t TEST_STRING_SUFFIX_MAX_LEN = 16;
+const size_t TEST_STRING_MAX_LEN        = 0x20;
+
+const size_t TEST_RECORD_GROUP_NUMBER   = 16;
+const size_t TEST_RECORD_SCORE_RANGE    = 1000;
+/* longer than common "brand_NN/" part of generated names */
+const size_t TEST_RECORD_NAME_PREFIX    = 12;
+
+/* push benchmark starts small, capacity below 4 is shrunk by DynamicArrayReallocCheck() */
+const size_t DYNAMIC_ARRAY_TEST_INIT_CAPACITY = 16;
+
+/* volatile, so sums of random reads are not optimized out */
+static volatile long long read_sum_sink = 0;
+
+/**
+ * @brief Record of TestRecordSort().
+ */
+struct test_record
+{
+    int         group;
+    int         score;
+    const char* name;
+};
+
+/**
+ * @brief Operations done on a typed heap by TestKHeapTyped(), checked after the run.
+ */
+struct test_k_heap_log
+{
+    int*   inserted;
+    size_t inserted_number;
+    int*   removed;             ///< Deleted keys and old values of changed keys.
+    size_t removed_number;
+    int*   extracted;           ///< Roots in extraction order.
+    size_t extracted_number;
+};
+
+/**
+ * Defines name##TestRun (): inserts cur_size random keys, then cur_size / 2
+ * random DeleteKey(), key changes fixed by SiftUp() or SiftDown() and
+ * inserts, checks heap order and extracts all roots, logging every key.
+ */
+#define TEST_K_HEAP_TYPED_RUN_DEFINE(name, arity)                               \
+                                                                                \
+static void                                                                     \
+name##TestRun (struct test_k_heap_log* const log,                               \
+               const size_t                  cur_size)                          \
+{                                                                               \
+    assert (log);                                                               \
+                                                                                \
+    struct name* heap = name##Constructor (NULL);                               \
+    assert (heap);                                                              \
+                                                                                \
+    k_heap_error_t error = K_HEAP_SUCCESS;                                      \
+                                                                                \
+    for (size_t i = 0; i < cur_size; ++i)                                       \
+    {                                                                           \
+        const int value = rand ();                                              \
+        error |= name##Insert (heap, &value);                                   \
+        log->inserted[log->inserted_number++] = value;                          \
+    }                                                                           \
+                                                                                \
+    for (size_t i = 0; i < cur_size / 2; ++i)                                   \
+    {                                                                           \
+        const size_t size = heap->d_array->data_array_size;                     \
+        int* const   data = (int*) heap->d_array->data_array;                   \
+        if (size == 0) break;                                                   \
+                                                                                \
+        const size_t index = (size_t) rand () % size;                           \
+        const int    value = rand ();                                           \
+                                                                                \
+        switch (rand () % 3)                                                    \
+        {                                                                       \
+            case 0:                                                             \
+                log->removed[log->removed_number++] = data[index];              \
+                error |= name##DeleteKey (heap, index);                         \
+                break;                                                          \
+                                                                                \
+            case 1:                                                             \
+                log->removed [log->removed_number++]  = data[index];            \
+                log->inserted[log->inserted_number++] = value;                  \
+                                                                                \
+                /* key moving to the root goes up, other keys go down */        \
+                if (name##Before (value, data[index]))                          \
+                {                                                               \
+                    data[index] = value;                                        \
+                    error |= name##SiftUp   (heap, index);                      \
+                    break;                                                      \
+                }                                                               \
+                                                                                \
+                data[index] = value;                                            \
+                error |= name##SiftDown (heap, index);                          \
+                break;                                                          \
+                                                                                \
+            default:                                                            \
+                error |= name##Insert (heap, &value);                           \
+                log->inserted[log->inserted_number++] = value;                  \
+                break;                                                          \
+        }                                                                       \
+    }                                                                           \
+                                                                                \
+    const int* const data = (const int*) heap->d_array->data_array;             \
+                                                                                \
+    for (size_t i = 1; i < heap->d_array->data_array_size; ++i)                 \
+        assert (!name##Before (data[i], data[(i - 1) / (arity)]));              \
+                                                                                \
+    while (heap->d_array->data_array_size > 0)                                  \
+        error |= name##ExtractRoot (heap,                                       \
+                                    &log->extracted[log->extracted_number++]);  \
+                                                                                \
+    assert (error == K_HEAP_SUCCESS);                                           \
+    assert (name##ExtractRoot (heap, NULL) == K_HEAP_ERROR);                    \
+                                                                                \
+    for (size_t i = 1; i < log->extracted_number; ++i)                          \
+        assert (!name##Before (log->extracted[i], log->extracted[i - 1]));      \
+                                                                                \
+    heap = name##Destructor (heap);                                             \
+}
+
+/* max-heaps like the ones of HeapSort() and a min-heap of odd arity */
+K_HEAP_TYPED_DEFINE (TestMaxHeap2, int, 2, (a) > (b))
+K_HEAP_TYPED_DEFINE (TestMinHeap3, int, 3, (a) < (b))
+K_HEAP_TYPED_DEFINE (TestMaxHeap4, int, 4, (a) > (b))
+
+TEST_K_HEAP_TYPED_RUN_DEFINE (TestMaxHeap2, 2)
+TEST_K_HEAP_TYPED_RUN_DEFINE (TestMinHeap3, 3)
+TEST_K_HEAP_TYPED_RUN_DEFINE (TestMaxHeap4, 4)
+
 static void
 ReadTestFile (struct file_names*     const names,
               struct file_input_str* const file_input,
@@ -37,6 +166,38 @@ SetTestNames (struct file_names* const names,
 static void
 EndCurrentTest (struct file_input_str* const file_input);
 
+static double
+GetWallTime (void);
+
+static void
+GenerateStrings (struct string_ref* const strings,
+                 char* const              buffer,
+                 const size_t             string_number);
+
+static int
+StringRefQsortCompare (const void* first,
+                       const void* second);
+
+static int
+IntQsortCompare (const void* first,
+                 const void* second);
+
+static int
+TestRecordQsortCompare (const void* first,
+                        const void* second);
+
+static int
+TestRecordNameMiddleQsortCompare (const void* first,
+                                  const void* second);
+
+static void
+CheckKHeapTypedLog (struct test_k_heap_log* const log,
+                    const size_t                  cur_test,
+                    const size_t                  cur_size);
+
+static void
+CheckStreamSortSigns (void);
+
 void
 TestSort (const char*  const test_folder,
           const char*  const output_file_name,
@@ -69,9 +230,12 @@ TestSort (const char*  const test_folder,
         (char* const) malloc (to * NUMBER_MAX_LEN_IN_CHAR);
     assert (buffer);
 
+    /* measured once before the first run, not between timed runs */
+    MemoryBandwidth ();
+
     size_t elem_number = 0;
-    clock_t sort_begin = 0;
-    clock_t sort_end   = 0;
+    double sort_begin  = 0;
+    double sort_end    = 0;
 
     // const size_t total_test_number = (to - from + 1) / step * size_tests_num;
     // size_t cur_test_cnt = 0;
@@ -84,15 +248,20 @@ TestSort (const char*  const test_folder,
             ReadTestFile  (names, file_input, buffer);
             FillArray (array, buffer, &elem_number);
 
-            sort_begin = clock ();
+            SortStatsReset ();
+
+            sort_begin = GetWallTime ();
             sort (array, elem_number);
-            sort_end   = clock ();
+            sort_end   = GetWallTime ();
 
             ReadAnswerFile (names, file_input, buffer);
             CheckArray (array, cur_test, cur_size, file_input, elem_number);
 
-            fprintf (output, "%zd %lg\n", cur_size,
-                     (double) (sort_end - sort_begin) / CLOCKS_PER_SEC);
+            fprintf (output, "%zd %lg", cur_size, sort_end - sort_begin);
+            SortStatsPrint (output);
+            fprintf (output, " %s", CpuDispatchVariantName (CpuDispatchVariant ()));
+            RooflinePrint (output, elem_number, sizeof (int), sort_end - sort_begin);
+            fprintf (output, "\n");
             // fprintf (stderr, "Test %zd of %zd\n", cur_test_cnt++, total_test_number);
 
             EndCurrentTest (file_input);
@@ -106,6 +275,790 @@ TestSort (const char*  const test_folder,
     free   (buffer);
 }
 
+void
+TestStringSort (const char*  const output_file_name,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num,
+                void (*sort) (struct string_ref* const, const size_t))
+{
+    assert (output_file_name);
+    assert (sort);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    struct string_ref* const strings =
+        (struct string_ref*) calloc (to + 1, sizeof (struct string_ref));
+    struct string_ref* const answer =
+        (struct string_ref*) calloc (to + 1, sizeof (struct string_ref));
+    char* const buffer =
+        (char*) calloc (to + 1, TEST_STRING_MAX_LEN);
+    assert (strings);
+    assert (answer);
+    assert (buffer);
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            GenerateStrings (strings, buffer, cur_size);
+
+            memcpy (answer, strings, cur_size * sizeof (struct string_ref));
+            qsort  (answer, cur_size, sizeof (struct string_ref), StringRefQsortCompare);
+
+            const double sort_begin = GetWallTime ();
+            sort (strings, cur_size);
+            const double sort_end   = GetWallTime ();
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                if (StringRefCompare (&strings[i], &answer[i]) != 0)
+                {
+                    fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                             cur_test, cur_size);
+                    fprintf (stderr, "awaited %.*s, recieved %.*s\n",
+                             (int) answer[i].len,  answer[i].str,
+                             (int) strings[i].len, strings[i].str);
+                    assert (0);
+                }
+            }
+
+            fprintf (output, "%zd %lg\n", cur_size, sort_end - sort_begin);
+        }
+    }
+
+    fclose (output);
+    free   (strings);
+    free   (answer);
+    free   (buffer);
+}
+
+static void
+GenerateStrings (struct string_ref* const strings,
+                 char* const              buffer,
+                 const size_t             string_number)
+{
+    assert (strings);
+    assert (buffer);
+
+    for (size_t i = 0; i < string_number; ++i)
+    {
+        char* const cur_string = buffer + i * TEST_STRING_MAX_LEN;
+
+        int len = sprintf (cur_string, "brand_%02d/",
+                           rand () % (int) TEST_STRING_PREFIX_NUMBER);
+
+        const int suffix_len = 1 + rand () % (int) TEST_STRING_SUFFIX_MAX_LEN;
+
+        for (int j = 0; j < suffix_len; ++j)
+            cur_string[len++] = (char) ('a' + rand () % 26);
+
+        strings[i].str = cur_string;
+        strings[i].len = (size_t) len;
+    }
+}
+
+static int
+StringRefQsortCompare (const void* first,
+                       const void* second)
+{
+    return StringRefCompare ((const struct string_ref*) first,
+                             (const struct string_ref*) second);
+}
+
+void
+TestSegmentedSort (const char*  const output_file_name,
+                   const size_t segment_min_size,
+                   const size_t segment_max_size,
+                   const size_t from,
+                   const size_t   to,
+                   const size_t step,
+                   const size_t size_tests_num)
+{
+    assert (output_file_name);
+    assert (segment_min_size <= segment_max_size);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    const size_t max_elem_number = to * segment_max_size;
+
+    int* const array =
+        (int*) calloc (max_elem_number + 1, sizeof (int));
+    int* const answer =
+        (int*) calloc (max_elem_number + 1, sizeof (int));
+    size_t* const offsets =
+        (size_t*) calloc (to + 1, sizeof (size_t));
+    assert (array);
+    assert (answer);
+    assert (offsets);
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            for (size_t i = 0; i < cur_size; ++i)
+                offsets[i + 1] = offsets[i] + segment_min_size +
+                                 (size_t) rand () % (segment_max_size - segment_min_size + 1);
+
+            const size_t elem_number = offsets[cur_size];
+
+            for (size_t i = 0; i < elem_number; ++i)
+                array[i] = rand () - RAND_MAX / 2;
+
+            memcpy (answer, array, elem_number * sizeof (int));
+
+            for (size_t i = 0; i < cur_size; ++i)
+                qsort (answer + offsets[i], offsets[i + 1] - offsets[i],
+                       sizeof (int), IntQsortCompare);
+
+            const double sort_begin = GetWallTime ();
+            SegmentedSort (array, offsets, cur_size);
+            const double sort_end   = GetWallTime ();
+
+            for (size_t i = 0; i < elem_number; ++i)
+            {
+                if (array[i] != answer[i])
+                {
+                    fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                             cur_test, cur_size);
+                    fprintf (stderr, "awaited %d, recieved %d\n",
+                             answer[i], array[i]);
+                    assert (0);
+                }
+            }
+
+            const double sort_time = sort_end - sort_begin;
+
+            fprintf (output, "%zd %lg %lg\n", cur_size, sort_time,
+                     (sort_time > 0) ? (double) cur_size / sort_time : 0);
+        }
+    }
+
+    fclose (output);
+    free   (array);
+    free   (answer);
+    free   (offsets);
+}
+
+static int
+IntQsortCompare (const void* first,
+                 const void* second)
+{
+    const int first_value  = *(const int*) first;
+    const int second_value = *(const int*) second;
+
+    return (first_value > second_value) - (first_value < second_value);
+}
+
+void
+TestSortedRuns (const char*  const output_file_name,
+                const size_t fan_out,
+                const size_t batch_size,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num)
+{
+    assert (output_file_name);
+    assert (batch_size > 0);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    int* const array  = (int*) calloc (to + batch_size, sizeof (int));
+    int* const answer = (int*) calloc (to + batch_size, sizeof (int));
+    assert (array);
+    assert (answer);
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            for (size_t i = 0; i < cur_size; ++i)
+                array[i] = rand ();
+
+            struct sorted_runs* runs = SortedRunsConstructor (fan_out);
+            assert (runs);
+
+            const double sort_begin = GetWallTime ();
+
+            for (size_t i = 0; i < cur_size; i += batch_size)
+            {
+                const size_t cur_batch_size =
+                    (cur_size - i < batch_size) ? cur_size - i : batch_size;
+
+                SortedRunsAppend (runs, array + i, cur_batch_size);
+            }
+
+            const double sort_end = GetWallTime ();
+
+            const size_t runs_number = SortedRunsRunNumber (runs);
+            const int    probe       = rand ();
+            const size_t probe_rank  = SortedRunsLowerBound (runs, probe);
+
+            memcpy (answer, array, cur_size * sizeof (int));
+            qsort  (answer, cur_size, sizeof (int), IntQsortCompare);
+
+            const int* const sorted = SortedRunsMaterialize (runs);
+            assert (cur_size == 0 || sorted);
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                if (sorted[i] != answer[i])
+                {
+                    fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                             cur_test, cur_size);
+                    fprintf (stderr, "awaited %d, recieved %d\n",
+                             answer[i], sorted[i]);
+                    assert (0);
+                }
+            }
+
+            assert (probe_rank == cur_size || answer[probe_rank] >= probe);
+            assert (probe_rank == 0        || answer[probe_rank - 1] < probe);
+
+            fprintf (output, "%zd %lg %zd\n", cur_size, sort_end - sort_begin, runs_number);
+
+            runs = SortedRunsDestructor (runs);
+        }
+    }
+
+    fclose (output);
+    free   (array);
+    free   (answer);
+}
+
+void
+TestSortCount (const char*  const test_folder,
+               const char*  const output_file_name,
+               const size_t from,
+               const size_t   to,
+               const size_t step,
+               const size_t size_tests_num)
+{
+    assert (test_folder);
+    assert (output_file_name);
+
+    struct file_names* names =
+        FileNamesConstructor (test_folder);
+    assert (names);
+
+    struct file_input_str* file_input =
+        FileInputConstructor ();
+    assert (file_input);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    int* const array =
+        (int* const) malloc ((to + 1) * sizeof (int));
+    assert (array);
+
+    char* const buffer =
+        (char* const) malloc ((to + 1) * NUMBER_MAX_LEN_IN_CHAR);
+    assert (buffer);
+
+    size_t elem_number = 0;
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            SetTestNames  (names, cur_size, cur_test);
+            ReadTestFile  (names, file_input, buffer);
+            FillArray (array, buffer, &elem_number);
+
+            struct key_count* key_counts = NULL;
+
+            const double count_begin = GetWallTime ();
+            const size_t key_number  = SortCount (array, elem_number, &key_counts);
+            const double count_end   = GetWallTime ();
+
+            assert (elem_number == 0 || key_counts);
+
+            /* baseline: sort everything and count equal neighbours */
+            const double scan_begin = GetWallTime ();
+            QuickHoareSort (array, elem_number);
+
+            size_t scan_key_number = 0;
+            for (size_t i = 0; i < elem_number; ++i)
+                if (i == 0 || array[i] != array[i - 1])
+                    scan_key_number++;
+            const double scan_end   = GetWallTime ();
+
+            assert (scan_key_number == key_number);
+
+            ReadAnswerFile (names, file_input, buffer);
+
+            size_t answer_index = 0;
+
+            for (size_t i = 0; i < key_number; ++i)
+            {
+                for (size_t j = 0; j < key_counts[i].count; ++j)
+                {
+                    const int check_elem =
+                        strtol (file_input->answer, &file_input->answer, 10);
+
+                    if (check_elem != key_counts[i].key)
+                    {
+                        fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                                 cur_test, cur_size);
+                        fprintf (stderr, "awaited %d, recieved %d\n",
+                                 check_elem, key_counts[i].key);
+                        assert (0);
+                    }
+
+                    answer_index++;
+                }
+            }
+
+            assert (answer_index == elem_number);
+
+            fprintf (output, "%zd %lg %lg %zd\n", cur_size,
+                     count_end - count_begin, scan_end - scan_begin, key_number);
+
+            free (key_counts);
+            EndCurrentTest (file_input);
+        }
+    }
+
+    names      = FileNamesDestructor    (names);
+    file_input = FileInputDestructor    (file_input);
+    fclose (output);
+    free   (array);
+    free   (buffer);
+}
+
+void
+TestStreamSort (const char*  const test_folder,
+                const char*  const output_file_name,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num)
+{
+    assert (test_folder);
+    assert (output_file_name);
+
+    CheckStreamSortSigns ();
+
+    struct file_names* names =
+        FileNamesConstructor (test_folder);
+    assert (names);
+
+    struct file_input_str* file_input =
+        FileInputConstructor ();
+    assert (file_input);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    int* const array =
+        (int* const) malloc ((to + 1) * sizeof (int));
+    assert (array);
+
+    char* const buffer =
+        (char* const) malloc ((to + 1) * NUMBER_MAX_LEN_IN_CHAR);
+    assert (buffer);
+
+    size_t elem_number = 0;
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            SetTestNames (names, cur_size, cur_test);
+
+            const double stream_begin = GetWallTime ();
+
+            FILE* test = fopen (names->test, "rb");
+            assert (test);
+
+            /* read is not inside assert (), StreamSort () starts after the header */
+            size_t header_size = 0;
+            if (fscanf (test, "%zd", &header_size) != 1)
+            {
+                fprintf (stderr, "cur_test = %zd, cur_size = %zd: no header in %s\n",
+                         cur_test, cur_size, names->test);
+                fclose (test);
+                assert (0);
+                continue;
+            }
+
+            size_t sorted_number = 0;
+            int* const sorted = StreamSort (test, &sorted_number);
+
+            fclose (test);
+
+            const double stream_end = GetWallTime ();
+
+            assert (sorted_number == header_size);
+
+            /* baseline: read everything, parse, then sort */
+            const double baseline_begin = GetWallTime ();
+
+            ReadTestFile (names, file_input, buffer);
+            FillArray (array, buffer, &elem_number);
+            RadixSort (array, elem_number);
+
+            const double baseline_end = GetWallTime ();
+
+            ReadAnswerFile (names, file_input, buffer);
+            CheckArray (array, cur_test, cur_size, file_input, elem_number);
+
+            for (size_t i = 0; i < sorted_number; ++i)
+            {
+                if (sorted[i] != array[i])
+                {
+                    fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                             cur_test, cur_size);
+                    fprintf (stderr, "awaited %d, recieved %d\n",
+                             array[i], sorted[i]);
+                    assert (0);
+                }
+            }
+
+            fprintf (output, "%zd %lg %lg\n", cur_size,
+                     stream_end - stream_begin, baseline_end - baseline_begin);
+
+            free (sorted);
+            EndCurrentTest (file_input);
+        }
+    }
+
+    names      = FileNamesDestructor    (names);
+    file_input = FileInputDestructor    (file_input);
+    fclose (output);
+    free   (array);
+    free   (buffer);
+}
+
+void
+TestRecordSort (const char*  const output_file_name,
+                const bool         name_key_last,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num)
+{
+    assert (output_file_name);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    struct test_record* const records =
+        (struct test_record*) calloc (to + 1, sizeof (struct test_record));
+    struct test_record* const answer =
+        (struct test_record*) calloc (to + 1, sizeof (struct test_record));
+    struct string_ref* const names =
+        (struct string_ref*) calloc (to + 1, sizeof (struct string_ref));
+    char* const buffer =
+        (char*) calloc (to + 1, TEST_STRING_MAX_LEN);
+    assert (records);
+    assert (answer);
+    assert (names);
+    assert (buffer);
+
+    const struct record_key name_last_keys[] =
+    {
+        {RECORD_KEY_INT,    RECORD_KEY_ASCENDING,  offsetof (struct test_record, group), 0},
+        {RECORD_KEY_INT,    RECORD_KEY_DESCENDING, offsetof (struct test_record, score), 0},
+        {RECORD_KEY_STRING, RECORD_KEY_ASCENDING,  offsetof (struct test_record, name),
+         TEST_RECORD_NAME_PREFIX}
+    };
+
+    /* names often share the prefix, then score decides the order */
+    const struct record_key name_middle_keys[] =
+    {
+        {RECORD_KEY_INT,    RECORD_KEY_ASCENDING,  offsetof (struct test_record, group), 0},
+        {RECORD_KEY_STRING, RECORD_KEY_ASCENDING,  offsetof (struct test_record, name),
+         TEST_RECORD_NAME_PREFIX},
+        {RECORD_KEY_INT,    RECORD_KEY_DESCENDING, offsetof (struct test_record, score), 0}
+    };
+
+    const struct record_key* const keys =
+        name_key_last ? name_last_keys : name_middle_keys;
+    const size_t key_number = name_key_last ?
+        sizeof (name_last_keys)   / sizeof (name_last_keys[0]) :
+        sizeof (name_middle_keys) / sizeof (name_middle_keys[0]);
+
+    int (*const compare) (const void*, const void*) =
+        name_key_last ? TestRecordQsortCompare : TestRecordNameMiddleQsortCompare;
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            GenerateStrings (names, buffer, cur_size);
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                /* string_ref is not null-terminated, buffer slots are reused */
+                buffer[i * TEST_STRING_MAX_LEN + names[i].len] = '\0';
+
+                records[i].group = rand () % (int) TEST_RECORD_GROUP_NUMBER;
+                records[i].score = rand () % (int) TEST_RECORD_SCORE_RANGE -
+                                   (int) TEST_RECORD_SCORE_RANGE / 2;
+                records[i].name  = names[i].str;
+            }
+
+            memcpy (answer, records, cur_size * sizeof (struct test_record));
+
+            const double qsort_begin = GetWallTime ();
+            qsort (answer, cur_size, sizeof (struct test_record), compare);
+            const double qsort_end   = GetWallTime ();
+
+            const double sort_begin = GetWallTime ();
+            const record_sort_error_t error =
+                RecordSort (records, cur_size, sizeof (struct test_record),
+                            keys, key_number);
+            const double sort_end   = GetWallTime ();
+
+            assert (error == RECORD_SORT_SUCCESS);
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                if (compare (&records[i], &answer[i]) != 0)
+                {
+                    fprintf (stderr, "cur_test = %zd, cur_size = %zd\n",
+                             cur_test, cur_size);
+                    fprintf (stderr, "awaited (%d, %d, %s), recieved (%d, %d, %s)\n",
+                             answer[i].group,  answer[i].score,  answer[i].name,
+                             records[i].group, records[i].score, records[i].name);
+                    assert (0);
+                }
+            }
+
+            fprintf (output, "%zd %lg %lg\n", cur_size,
+                     sort_end - sort_begin, qsort_end - qsort_begin);
+        }
+    }
+
+    fclose (output);
+    free   (records);
+    free   (answer);
+    free   (names);
+    free   (buffer);
+}
+
+/**
+ * @brief Hand-written multi-field comparator, baseline of TestRecordSort().
+ */
+static int
+TestRecordQsortCompare (const void* first,
+                        const void* second)
+{
+    assert (first);
+    assert (second);
+
+    const struct test_record* const first_record  = (const struct test_record*) first;
+    const struct test_record* const second_record = (const struct test_record*) second;
+
+    if (first_record->group != second_record->group)
+        return (first_record->group < second_record->group) ? -1 : 1;
+
+    if (first_record->score != second_record->score)
+        return (first_record->score > second_record->score) ? -1 : 1;
+
+    return strcmp (first_record->name, second_record->name);
+}
+
+/**
+ * @brief Comparator of TestRecordSort() with name between group and score.
+ */
+static int
+TestRecordNameMiddleQsortCompare (const void* first,
+                                  const void* second)
+{
+    assert (first);
+    assert (second);
+
+    const struct test_record* const first_record  = (const struct test_record*) first;
+    const struct test_record* const second_record = (const struct test_record*) second;
+
+    if (first_record->group != second_record->group)
+        return (first_record->group < second_record->group) ? -1 : 1;
+
+    const int name_result = strcmp (first_record->name, second_record->name);
+    if (name_result != 0) return name_result;
+
+    if (first_record->score != second_record->score)
+        return (first_record->score > second_record->score) ? -1 : 1;
+
+    return 0;
+}
+
+void
+TestDynamicArrayPush (const char*  const                  output_file_name,
+                      const enum dynamic_array_memory_mode memory_mode,
+                      const size_t                         from,
+                      const size_t                         to,
+                      const size_t                         step,
+                      const size_t                         size_tests_num)
+{
+    assert (output_file_name);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            struct dynamic_array* d_array =
+                DynamicArrayConstructorMode (DYNAMIC_ARRAY_TEST_INIT_CAPACITY, sizeof (int),
+                                             DYNAMIC_ARRAY_REALLOC_ENABLED,
+                                             DYNAMIC_ARRAY_DESTROY, memory_mode);
+            assert (d_array);
+
+            const double push_begin = GetWallTime ();
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                const int value = (int) i;
+                DynamicArrayPush (d_array, &value);
+            }
+
+            const double push_end = GetWallTime ();
+
+            assert (d_array->data_array_size == cur_size);
+
+            /* random reads cross pages, huge pages save TLB misses here */
+            const int* const data = (const int*) d_array->data_array;
+            size_t index    = 0;
+            long long sum   = 0;
+
+            const double read_begin = GetWallTime ();
+
+            for (size_t i = 0; i < cur_size; ++i)
+            {
+                index = (index * 6364136223846793005ULL + 1442695040888963407ULL) % cur_size;
+                sum  += data[index];
+            }
+
+            const double read_end = GetWallTime ();
+
+            for (size_t i = 0; i < cur_size; i += step / 16 + 1)
+                assert (data[i] == (int) i);
+
+            fprintf (output, "%zd %lg %lg %d\n", cur_size, push_end - push_begin,
+                     read_end - read_begin, (int) memory_mode);
+
+            read_sum_sink = sum;
+
+            d_array = DynamicArrayDestructor (d_array);
+        }
+    }
+
+    fclose (output);
+}
+
+void
+TestKHeapTyped (const char*  const output_file_name,
+                const size_t arity,
+                const size_t from,
+                const size_t   to,
+                const size_t step,
+                const size_t size_tests_num)
+{
+    assert (output_file_name);
+
+    FILE* output = fopen (output_file_name, "wb");
+    assert (output);
+
+    /* every mixed operation logs at most one inserted and one removed key */
+    const size_t max_inserted = to + to / 2;
+
+    struct test_k_heap_log log =
+    {
+        .inserted  = (int*) calloc (max_inserted + 1, sizeof (int)),
+        .removed   = (int*) calloc (to / 2 + 1,       sizeof (int)),
+        .extracted = (int*) calloc (max_inserted + 1, sizeof (int))
+    };
+    assert (log.inserted);
+    assert (log.removed);
+    assert (log.extracted);
+
+    for (size_t cur_size = from; cur_size <= to; cur_size += step)
+    {
+        for (size_t cur_test = 0; cur_test < size_tests_num; ++cur_test)
+        {
+            log.inserted_number  = 0;
+            log.removed_number   = 0;
+            log.extracted_number = 0;
+
+            const double run_begin = GetWallTime ();
+
+            switch (arity)
+            {
+                case K_2: TestMaxHeap2TestRun (&log, cur_size); break;
+                case K_3: TestMinHeap3TestRun (&log, cur_size); break;
+                case K_4: TestMaxHeap4TestRun (&log, cur_size); break;
+
+                default:
+                    assert (0);
+            }
+
+            const double run_end = GetWallTime ();
+
+            CheckKHeapTypedLog (&log, cur_test, cur_size);
+
+            fprintf (output, "%zd %lg\n", cur_size, run_end - run_begin);
+        }
+    }
+
+    fclose (output);
+    free   (log.inserted);
+    free   (log.removed);
+    free   (log.extracted);
+}
+
+/**
+ * @brief Checks that extracted keys are inserted keys without removed ones.
+ */
+static void
+CheckKHeapTypedLog (struct test_k_heap_log* const log,
+                    const size_t                  cur_test,
+                    const size_t                  cur_size)
+{
+    assert (log);
+
+    qsort (log->inserted,  log->inserted_number,  sizeof (int), IntQsortCompare);
+    qsort (log->removed,   log->removed_number,   sizeof (int), IntQsortCompare);
+    qsort (log->extracted, log->extracted_number, sizeof (int), IntQsortCompare);
+
+    size_t removed_index   = 0;
+    size_t extracted_index = 0;
+
+    for (size_t i = 0; i < log->inserted_number; ++i)
+    {
+        if (removed_index < log->removed_number &&
+            log->removed[removed_index] == log->inserted[i])
+        {
+            removed_index++;
+            continue;
+        }
+
+        if (extracted_index >= log->extracted_number ||
+            log->extracted[extracted_index] != log->inserted[i])
+        {
+            fprintf (stderr, "cur_test = %zd, cur_size = %zd\n", cur_test, cur_size);
+            fprintf (stderr, "awaited %d, recieved %d\n", log->inserted[i],
+                     (extracted_index < log->extracted_number) ?
+                     log->extracted[extracted_index] : -1);
+            assert (0);
+        }
+
+        extracted_index++;
+    }
+
+    assert (removed_index   == log->removed_number);
+    assert (extracted_index == log->extracted_number);
+}
+
 struct file_names*
 FileNamesConstructor (const char* const test_folder)
 {
@@ -261,6 +1214,20 @@ EndCurrentTest (struct file_input_str* const file_input)
     file_input->answer = NULL;
 }
 
+/**
+ * @brief Wall clock time in seconds.
+ * @details clock() sums CPU time of all threads, so multithreaded sorts
+ * would look slower than they are.
+ */
+static double
+GetWallTime (void)
+{
+    struct timespec time_value = {};
+    clock_gettime (CLOCK_MONOTONIC, &time_value);
+
+    return (double) time_value.tv_sec + (double) time_value.tv_nsec * 1e-9;
+}
+
 struct file_names*
 FileNamesDestructor (struct file_names* const names)
 {
@@ -293,3 +1260,42 @@ FileInputDestructor (struct file_input_str* const file_input)
 
     return NULL;
 }
+
+/**
+ * @brief Checks StreamSort() on minus signs right after digits and doubled
+ * minuses, test files have only space separated numbers.
+ */
+static void
+CheckStreamSortSigns (void)
+{
+    const char* const input_str = "5-3 -2--1\n7 10-20 -0 4";
+    const int         awaited[] = {-20, -3, -2, -1, 0, 4, 5, 7, 10};
+
+    const size_t awaited_number = sizeof (awaited) / sizeof (awaited[0]);
+
+    FILE* const input = tmpfile ();
+    assert (input);
+
+    fputs  (input_str, input);
+    rewind (input);
+
+    size_t sorted_number = 0;
+    int* const sorted = StreamSort (input, &sorted_number);
+
+    fclose (input);
+
+    assert (sorted);
+    assert (sorted_number == awaited_number);
+
+    for (size_t i = 0; i < awaited_number; ++i)
+    {
+        if (sorted[i] != awaited[i])
+        {
+            fprintf (stderr, "stream sort signs: awaited %d, recieved %d\n",
+                     awaited[i], sorted[i]);
+            assert (0);
+        }
+    }
+
+    free (sorted);
+}
@@ -0,0 +1,213 @@
+#include "../include/weak_heap_sort.h"
+
+/* elements are swapped through stack buffer of this size */
+#define WEAK_HEAP_SWAP_CHUNK_SIZE 64
+
+/**
+ * @brief Data shared by all steps of one WeakHeapSort() call.
+ */
+struct weak_heap
+{
+    char*               base;
+    size_t              elem_size;
+    weak_heap_compare_t compare;
+    uint8_t*            reverse;    ///< Reverse bit of every node, 0 or 1.
+};
+
+static inline size_t
+WeakHeapDistinguishedAncestor (const struct weak_heap* const heap,
+                               size_t                        index);
+
+static inline void
+WeakHeapJoin (const struct weak_heap* const heap,
+              const size_t                  ancestor_index,
+              const size_t                  index);
+
+static inline void
+WeakHeapSwap (const struct weak_heap* const heap,
+              const size_t                  first_index,
+              const size_t                  second_index);
+
+static void
+WeakHeapFallbackSort (const struct weak_heap* const heap,
+                      const size_t                  elem_number);
+
+static inline void
+WeakHeapFallbackSiftDown (const struct weak_heap* const heap,
+                          size_t                        index,
+                          const size_t                  heap_size);
+
+static int
+WeakHeapIntCompare (const void* first,
+                    const void* second);
+
+void
+WeakHeapSort (void* const               base,
+              const size_t              elem_number,
+              const size_t              elem_size,
+              const weak_heap_compare_t compare)
+{
+    if (base == NULL || compare == NULL || elem_size == 0 || elem_number <= 1) return;
+
+    struct weak_heap heap =
+    {
+        .base      = (char*) base,
+        .elem_size = elem_size,
+        .compare   = compare,
+        .reverse   = (uint8_t*) calloc (elem_number, sizeof (uint8_t))
+    };
+
+    /* the array is still sorted, by binary heap which needs no memory */
+    if (heap.reverse == NULL)
+    {
+        WeakHeapFallbackSort (&heap, elem_number);
+        return;
+    }
+
+    /* every node is joined with its distinguished ancestor, from the bottom */
+    for (size_t index = elem_number - 1; index > 0; --index)
+        WeakHeapJoin (&heap, WeakHeapDistinguishedAncestor (&heap, index), index);
+
+    for (size_t last = elem_number - 1; last > 1; --last)
+    {
+        WeakHeapSwap (&heap, 0, last);
+
+        /* the root's new value goes down the leftmost path of the right subtree */
+        size_t index = 1;
+        size_t child = 0;
+
+        while ((child = 2 * index + heap.reverse[index]) < last)
+            index = child;
+
+        for (; index > 0; index /= 2)
+            WeakHeapJoin (&heap, 0, index);
+    }
+
+    WeakHeapSwap (&heap, 0, 1);
+
+    free (heap.reverse);
+}
+
+void
+WeakHeapIntSort (int* const   array,
+                 const size_t elem_number)
+{
+    WeakHeapSort (array, elem_number, sizeof (int), WeakHeapIntCompare);
+}
+
+/**
+ * @brief Parent of the first right child on the path from index to the root.
+ * @details Node is the left child if its parity equals reverse bit of parent.
+ */
+static inline size_t
+WeakHeapDistinguishedAncestor (const struct weak_heap* const heap,
+                               size_t                        index)
+{
+    assert (heap);
+    assert (index > 0);
+
+    while ((index & 1) == heap->reverse[index / 2])
+        index /= 2;
+
+    return index / 2;
+}
+
+/**
+ * @brief Joins weak heaps rooted at ancestor_index and index,
+ * bigger root goes up, subtrees of index swap if it went down.
+ */
+static inline void
+WeakHeapJoin (const struct weak_heap* const heap,
+              const size_t                  ancestor_index,
+              const size_t                  index)
+{
+    assert (heap);
+
+    if (heap->compare (heap->base + ancestor_index * heap->elem_size,
+                       heap->base + index          * heap->elem_size) < 0)
+    {
+        WeakHeapSwap (heap, ancestor_index, index);
+        heap->reverse[index] ^= 1;
+    }
+}
+
+static inline void
+WeakHeapSwap (const struct weak_heap* const heap,
+              const size_t                  first_index,
+              const size_t                  second_index)
+{
+    assert (heap);
+
+    char* first  = heap->base + first_index  * heap->elem_size;
+    char* second = heap->base + second_index * heap->elem_size;
+
+    SORT_STATS_SWAP (2 * heap->elem_size);
+
+    char buffer[WEAK_HEAP_SWAP_CHUNK_SIZE];
+
+    for (size_t left = heap->elem_size; left > 0;)
+    {
+        const size_t chunk_size = (left < WEAK_HEAP_SWAP_CHUNK_SIZE) ?
+                                   left : WEAK_HEAP_SWAP_CHUNK_SIZE;
+
+        memcpy (buffer, first,  chunk_size);
+        memcpy (first,  second, chunk_size);
+        memcpy (second, buffer, chunk_size);
+
+        first  += chunk_size;
+        second += chunk_size;
+        left   -= chunk_size;
+    }
+}
+
+/**
+ * @brief Binary heap sort with the same comparator and swaps,
+ * for the case reverse bits can't be allocated.
+ */
+static void
+WeakHeapFallbackSort (const struct weak_heap* const heap,
+                      const size_t                  elem_number)
+{
+    assert (heap);
+
+    for (size_t index = elem_number / 2; index > 0; --index)
+        WeakHeapFallbackSiftDown (heap, index - 1, elem_number);
+
+    for (size_t last = elem_number - 1; last > 0; --last)
+    {
+        WeakHeapSwap (heap, 0, last);
+        WeakHeapFallbackSiftDown (heap, 0, last);
+    }
+}
+
+static inline void
+WeakHeapFallbackSiftDown (const struct weak_heap* const heap,
+                          size_t                        index,
+                          const size_t                  heap_size)
+{
+    assert (heap);
+
+    size_t child = 0;
+
+    while ((child = 2 * index + 1) < heap_size)
+    {
+        if (child + 1 < heap_size &&
+            heap->compare (heap->base + child       * heap->elem_size,
+                           heap->base + (child + 1) * heap->elem_size) < 0)
+            child++;
+
+        if (heap->compare (heap->base + index * heap->elem_size,
+                           heap->base + child * heap->elem_size) >= 0)
+            break;
+
+        WeakHeapSwap (heap, index, child);
+        index = child;
+    }
+}
+
+static int
+WeakHeapIntCompare (const void* first,
+                    const void* second)
+{
+    return int_cmp ((void*) first, (void*) second);
+}
@@ -4,19 +4,54 @@
 #include <stdlib.h>
 #include <assert.h>
 
+#include "slab.h"
+
 
 
 typedef
 struct binomial_heap_node
 {
     int key;
-    struct binomial_heap_node* parent;
-    struct binomial_heap_node* child;
-    struct binomial_heap_node* sibling;
+    struct binomial_heap_node*   parent;
+    struct binomial_heap_node*   child;
+    struct binomial_heap_node*   sibling;
+    struct binomial_heap_handle* handle;
     size_t degree;
 }
 binomial_heap_node;
 
+/**
+ * @brief Stable reference to a key of the heap
+ *
+ * Keys move between nodes when they are sifted up, the handle is moved
+ * with its key, so it stays valid until the key is extracted or deleted.
+ */
+typedef
+struct binomial_heap_handle
+{
+    binomial_heap_node* node;
+}
+binomial_heap_handle;
+
+/**
+ * @brief Min-heap of int keys
+ *
+ * Roots are kept in increasing order of degree, min is the cached root
+ * with the smallest key. Nodes and handles are taken from slabs, not
+ * allocated one by one.
+ */
+typedef
+struct binomial_heap
+{
+    binomial_heap_node* head;
+    binomial_heap_node* min;
+    size_t              size;
+
+    slab_t*             node_slab;
+    slab_t*             handle_slab;
+}
+binomial_heap;
+
 enum binomial_heap_error_status
 {
     BINOMIAL_HEAP_SUCCESS = 0,
@@ -27,23 +62,67 @@ typedef size_t binomial_heap_error_t;
 
 
 
-binomial_heap_node*
-BinomialHeapDestructor (binomial_heap_node* const heap);
-
-binomial_heap_node*
-BinomialHeapMerge (binomial_heap_node* const heap1,
-                   binomial_heap_node* const heap2);
-
-binomial_heap_node*
-BinomialHeapInsert (binomial_heap_node* const heap,
+binomial_heap*
+BinomialHeapConstructor (void);
+
+/**
+ * @brief Frees the heap with all its nodes and handles
+ *
+ * Nodes are freed by blocks of the slabs, the trees are not walked.
+ */
+binomial_heap*
+BinomialHeapDestructor (binomial_heap* const heap);
+
+/**
+ * @brief Moves all keys of heap2 to heap1
+ *
+ * Handles of heap2 keys stay valid and are used with heap1 from now on,
+ * heap2 is left empty and still has to be destructed.
+ */
+binomial_heap_error_t
+BinomialHeapMerge (binomial_heap* const heap1,
+                   binomial_heap* const heap2);
+
+/**
+ * @return handle of the inserted key, NULL on error
+ */
+binomial_heap_handle*
+BinomialHeapInsert (binomial_heap* const heap,
                     const int key);
 
-binomial_heap_node*
-BinomialHeapNodeConstructor (const int key);
-
-binomial_heap_node*
-BinomialHeapNodeDestructor (binomial_heap_node* const node);
-
-
-
-#endif /* BINOMIAL_HEAP_H */
\ No newline at end of file
+/**
+ * @return root with the smallest key, NULL if heap is empty, O(1)
+ */
+const binomial_heap_node*
+BinomialHeapFindMin (const binomial_heap* const heap);
+
+/**
+ * @brief Removes the smallest key, its handle becomes invalid
+ *
+ * @param key gets the removed key if not NULL
+ */
+binomial_heap_error_t
+BinomialHeapExtractMin (binomial_heap* const heap,
+                        int* const key);
+
+/**
+ * @brief Sets key of handle to new_key, error if new_key is greater
+ */
+binomial_heap_error_t
+BinomialHeapDecreaseKey (binomial_heap* const heap,
+                         binomial_heap_handle* const handle,
+                         const int new_key);
+
+/**
+ * @brief Removes key of handle, the handle becomes invalid
+ */
+binomial_heap_error_t
+BinomialHeapDelete (binomial_heap* const heap,
+                    binomial_heap_handle* const handle);
+
+size_t
+BinomialHeapSize (const binomial_heap* const heap);
+
+
+
+#endif /* BINOMIAL_HEAP_H */
@@ -3,6 +3,7 @@
 
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -11,8 +12,37 @@
 //-----------------------------------------------------------------------------
 // Dynamic array struct
 //-----------------------------------------------------------------------------
+/**
+ * @brief Where array->data memory comes from
+ */
+typedef enum d_array_memory_mode
+{
+    DYNAMIC_ARRAY_MEMORY_HEAP    = 0,   ///< realloc(), the default
+    DYNAMIC_ARRAY_MEMORY_ALIGNED = 1,   ///< aligned_alloc() by cache line, growth copies
+
+    /**
+     * Heap while data is smaller than DYNAMIC_ARRAY_MMAP_THRESHOLD,
+     * then anonymous mmap() grown by mremap() with MREMAP_MAYMOVE,
+     * so pages are remapped instead of copied. From DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD
+     * the mapping is madvise()-d with MADV_HUGEPAGE to use less TLB entries.
+     */
+    DYNAMIC_ARRAY_MEMORY_LARGE   = 2
+}
+d_array_memory_mode_t;
+
+/**
+ * @brief Bytes of data stored inside the structure itself
+ *
+ * While capacity * element_size fits, array->data points to array->inline_buffer
+ * and pushes don't call the allocator. 32 bytes hold a typical token or
+ * 4 pointers, the structure stays within two cache lines.
+ */
+#define DYNAMIC_ARRAY_INLINE_SIZE 32
+
 /**
  * @brief Dynamic array structure
+ *
+ * Must not be copied by value: array->data may point inside the structure.
  */
 typedef struct dynamic_array
 {
@@ -20,9 +50,22 @@ typedef struct dynamic_array
     size_t size;            ///< Current nuumber of elements in the array
     size_t capacity;        ///< Current capacity of the array
     size_t element_size;    ///< Size of each element in the array in bytes
+    size_t reserved;        ///< Capacity kept by pushes and pops, see DynamicArrayReserve()
+
+    d_array_memory_mode_t memory_mode;
+    size_t allocated_bytes; ///< Bytes of data allocation, page-rounded if mapped
+    bool   mapped;          ///< data is mmap()-ed
+    bool   inlined;         ///< data is inline_buffer
+
+    _Alignas (max_align_t)
+    unsigned char inline_buffer[DYNAMIC_ARRAY_INLINE_SIZE]; ///< Small buffer, not used in aligned mode
 }
 d_array_t;
 
+extern const size_t DYNAMIC_ARRAY_CACHE_LINE_SIZE;
+extern const size_t DYNAMIC_ARRAY_MMAP_THRESHOLD;
+extern const size_t DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD;
+
 /**
  * @brief Dynamic array error statuses
  */
@@ -51,11 +94,27 @@ typedef size_t d_array_error_t;
  * @return pointer to the structure if success, NULL if error
  * 
  * Allocates memory for the dynamic array structure, initializes and returns it.
- * array->data field is NULL at this point.
+ * array->data field is NULL at this point. The first push takes
+ * DYNAMIC_ARRAY_INLINE_SIZE / element_size elements of capacity in
+ * array->inline_buffer, data moves to the heap only when it doesn't fit.
  */
 d_array_t*
 DynamicArrayConstructor       (const size_t element_size);
 
+/**
+ * @brief Constructor for dynamic array structure with given memory mode
+ * 
+ * @param element_size size of each element in bytes
+ * @param memory_mode where array->data memory comes from
+ * 
+ * @return pointer to the structure if success, NULL if error
+ * 
+ * Same as DynamicArrayConstructor(), which uses DYNAMIC_ARRAY_MEMORY_HEAP.
+ */
+d_array_t*
+DynamicArrayConstructorWithMode (const size_t                element_size,
+                                 const d_array_memory_mode_t memory_mode);
+
 /**
  * @brief Destructor for dynamic array structure
  * 
@@ -142,6 +201,79 @@ DynamicArrayPopNoRealloc      (d_array_t* const array);
 void*
 DynamicArrayGetElemPtrByIndex (d_array_t* const array,
                                const size_t index);
+
+/**
+ * @brief Reserves place for at least capacity elements
+ * 
+ * @param array pointer to dynamic array structure
+ * @param capacity number of elements to reserve place for
+ * 
+ * @return DYNAMIC_ARRAY_SUCCESS on success, DYNAMIC_ARRAY_ERROR on error
+ * 
+ * Reallocates once if array->capacity is smaller. Pushes and pops don't shrink
+ * the array below reserved capacity until DynamicArrayShrinkToFit() is called.
+ */
+d_array_error_t
+DynamicArrayReserve           (d_array_t* const array,
+                               const size_t     capacity);
+
+/**
+ * @brief Pushes element_number elements from elements buffer
+ * 
+ * @param array pointer to dynamic array structure
+ * @param elements pointer to buffer of element_number elements
+ * @param element_number number of elements to push
+ * 
+ * @return DYNAMIC_ARRAY_SUCCESS on success, DYNAMIC_ARRAY_ERROR on error
+ * 
+ * Reallocates at most once, to doubled capacity or to exactly fit new elements
+ * if it is not enough, then copies all elements with one memcpy().
+ */
+d_array_error_t
+DynamicArrayPushN             (d_array_t*  const array,
+                               const void* const elements,
+                               const size_t      element_number);
+
+/**
+ * @brief Adds one element to the end of array and returns pointer to it
+ * 
+ * @param array pointer to dynamic array structure
+ * 
+ * @return pointer to the new element on success, NULL on error
+ * 
+ * The element is not initialized, caller writes it through the pointer,
+ * so there is no copying from a buffer. Capacity only grows, so the
+ * check is cheaper than the one of DynamicArrayPush().
+ */
+void*
+DynamicArrayEmplace           (d_array_t* const array);
+
+/**
+ * @brief Sets number of elements in the array
+ * 
+ * @param array pointer to dynamic array structure
+ * @param size new number of elements
+ * 
+ * @return DYNAMIC_ARRAY_SUCCESS on success, DYNAMIC_ARRAY_ERROR on error
+ * 
+ * New elements are filled with zero bytes. Capacity only grows.
+ */
+d_array_error_t
+DynamicArrayResize            (d_array_t* const array,
+                               const size_t     size);
+
+/**
+ * @brief Reallocates array->data to exactly array->size elements
+ * 
+ * @param array pointer to dynamic array structure
+ * 
+ * @return DYNAMIC_ARRAY_SUCCESS on success, DYNAMIC_ARRAY_ERROR on error
+ * 
+ * Frees array->data if the array is empty, moves data back to
+ * array->inline_buffer if it fits. Drops reserved capacity.
+ */
+d_array_error_t
+DynamicArrayShrinkToFit       (d_array_t* const array);
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
\ No newline at end of file
@@ -18,8 +18,12 @@ k_heap_key;
 
 typedef struct k_heap
 {
-    d_array_t*  array;
+    d_array_t*  array;      ///< Elements, offset empty slots before the root
     size_t      k;
+    size_t      offset;     ///< k - 1 if k children fit a cache line evenly, else 0
+    size_t      key_size;   ///< 0: elements are k_heap_key*, else keys of key_size bytes inline
+    void*       hole;       ///< One element, sifted element is kept here
+    k_heap_key  root_view;  ///< KHeapGetRoot() result in inline mode
     k_heap_key* infinity_key;
 
     int (*key_cmp) (const k_heap_key* const,
@@ -57,6 +61,28 @@ KHeapConstructor (const size_t k,
                   int (*key_cmp)   (const k_heap_key* const,
                                     const k_heap_key* const));
 
+/**
+ * @brief Constructor of k-heap with keys stored in the heap array
+ *
+ * @param key_size bytes of every key with its payload, key_cmp gets views
+ * of key_size bytes over the array and compares the key part
+ *
+ * @return pointer to the heap on success, NULL on error
+ *
+ * Keys are not allocated one by one: KHeapInsert() copies key->key bytes
+ * into the array (zero-padded to key_size, longer keys are rejected with
+ * K_HEAP_ERROR), sifts move key bytes instead of pointers and comparisons
+ * don't chase pointers. KHeapGetRoot() returns
+ * a view valid until the next change of the heap. KHeapSetArray() takes
+ * arrays of key_size elements.
+ */
+k_heap_t*
+KHeapConstructorInline (const size_t k,
+                        const size_t key_size,
+                        const k_heap_key* const infinity_key,
+                        int (*key_cmp)   (const k_heap_key* const,
+                                          const k_heap_key* const));
+
 k_heap_t*
 KHeapDestructor  (k_heap_t* const heap);
 //-------------------------------------
@@ -80,6 +106,28 @@ KHeapExtractRoot (k_heap_t* const heap);
 k_heap_error_t
 KHeapSiftDown    (k_heap_t* const heap,
                   const size_t index);
+
+/**
+ * @brief Replaces keys of the heap with keys of array
+ *
+ * @param heap pointer to heap structure
+ * @param array dynamic array of elements of the heap (k_heap_key* or inline
+ * keys) in any order, the heap owns it and its keys after success
+ *
+ * @return K_HEAP_SUCCESS on success, K_HEAP_ERROR on error
+ *
+ * Keys are copied to the cache-line aligned heap layout, the heap is not
+ * ordered, call KHeapSiftDown() from the last parent to the root.
+ */
+k_heap_error_t
+KHeapSetArray    (k_heap_t*  const heap,
+                  d_array_t* const array);
+
+/**
+ * @brief Number of keys in the heap
+ */
+size_t
+KHeapSize        (const k_heap_t* const heap);
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -0,0 +1,126 @@
+#pragma once
+
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+//-----------------------------------------------------------------------------
+// Slab allocator struct
+//-----------------------------------------------------------------------------
+/**
+ * @brief Header of a block of elements, elements follow it
+ */
+typedef struct slab_block
+{
+    struct slab_block* next;
+    size_t             capacity;    ///< Number of elements in the block
+}
+slab_block_t;
+
+/**
+ * @brief Pool of fixed-size elements
+ *
+ * Elements are cut from blocks of growing capacity, freed elements are kept
+ * in a free list threaded through them and reused first. Memory of the blocks
+ * is returned to the system only by SlabDestructor(), so all elements are
+ * freed at once without visiting them.
+ */
+typedef struct slab
+{
+    size_t        element_size;     ///< Rounded up to alignment of pointers
+    size_t        block_capacity;   ///< Capacity of the next block
+
+    slab_block_t* blocks;
+    slab_block_t* blocks_tail;
+
+    void*         free_list;        ///< Freed elements, LIFO
+    void*         free_tail;        ///< The first freed element, end of the list
+
+    char*         bump;             ///< Not yet used elements of the newest block
+    size_t        bump_left;
+
+    size_t        allocated;        ///< Number of live elements
+}
+slab_t;
+
+extern const size_t SLAB_INITIAL_BLOCK_CAPACITY;
+extern const size_t SLAB_MAX_BLOCK_CAPACITY;
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+
+//-----------------------------------------------------------------------------
+// Slab allocator functions prototypes
+//-----------------------------------------------------------------------------
+//-------------------------------------
+// Constructor and destructor
+/**
+ * @brief Constructor for slab allocator
+ *
+ * @param element_size size of every element in bytes
+ *
+ * @return pointer to the slab if success, NULL if error
+ *
+ * No block is allocated until the first SlabAlloc().
+ */
+slab_t*
+SlabConstructor (const size_t element_size);
+
+/**
+ * @brief Destructor for slab allocator
+ *
+ * @param slab pointer to slab
+ *
+ * @return NULL
+ *
+ * Frees all blocks, so all elements, live or not.
+ */
+slab_t*
+SlabDestructor  (slab_t* const slab);
+//-------------------------------------
+
+//-------------------------------------
+// Interface
+/**
+ * @brief Takes one element
+ *
+ * @param slab pointer to slab
+ *
+ * @return pointer to uninitialized element, NULL on error
+ *
+ * Pops the free list, else cuts the element from the newest block,
+ * else allocates a block twice bigger than the previous one.
+ */
+void*
+SlabAlloc       (slab_t* const slab);
+
+/**
+ * @brief Returns element to the slab
+ *
+ * @param slab pointer to slab the element was taken from
+ * @param element pointer to element, NULL is ignored
+ */
+void
+SlabFree        (slab_t* const slab,
+                 void*   const element);
+
+/**
+ * @brief Moves all blocks of source to destination
+ *
+ * @param destination pointer to slab, gets blocks and free elements of source
+ * @param source pointer to slab of the same element_size, empty after the call
+ *
+ * Elements of source stay valid and are freed to destination from now on.
+ * O(1): block and free lists are spliced by their tails.
+ */
+void
+SlabMerge       (slab_t* const destination,
+                 slab_t* const source);
+//-------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
@@ -4,6 +4,8 @@
 #include <limits.h>
 
 
+// default arity, "binary_linear_test k [inline] < input" sets another one,
+// "inline" stores int keys in the heap array instead of k_heap_key pointers
 const size_t K_HEAP_K_VALUE = 2;
 const int HEAP_INFINITY_VALUE = INT_MAX;
 
@@ -24,7 +26,9 @@ CompareKHeapKeys (const k_heap_key* const a,
 }
 
 clock_t
-KHeapLinear (d_array_t* const d_array)
+KHeapLinear (d_array_t* const d_array,
+             const size_t     k,
+             const bool       inline_keys)
 {
     assert (d_array);
 
@@ -35,13 +39,16 @@ KHeapLinear (d_array_t* const d_array)
         KHeapKeyConstructor (&HEAP_INFINITY_VALUE, sizeof (int));
     assert (inf_key);
 
-    k_heap_t* heap =
-        KHeapConstructor (K_HEAP_K_VALUE, inf_key, CompareKHeapKeys);
+    k_heap_t* heap = inline_keys ?
+        KHeapConstructorInline (k, sizeof (int), inf_key, CompareKHeapKeys) :
+        KHeapConstructor       (k,               inf_key, CompareKHeapKeys);
     assert (heap);
 
-    heap->array = DynamicArrayDestructor (heap->array);
-    heap->array = d_array;
-    const size_t begin_index = heap->array->size / heap->k;
+    // d_array is owned by the heap from here
+    const k_heap_error_t set_status = KHeapSetArray (heap, d_array);
+    assert (set_status == K_HEAP_SUCCESS);
+
+    const size_t begin_index = KHeapSize (heap) / heap->k;
 
     begin = clock ();
     
@@ -52,7 +59,7 @@ KHeapLinear (d_array_t* const d_array)
 
     assert (heap);
 
-    // d_array is freed here
+    // keys of d_array are freed here
     inf_key = KHeapKeyDestructor (inf_key);
     heap    = KHeapDestructor    (heap);
 
@@ -62,43 +69,65 @@ KHeapLinear (d_array_t* const d_array)
 
 
 d_array_t*
-ReadDynamicArray (const size_t elem_number)
+ReadDynamicArray (const size_t elem_number,
+                  const bool   inline_keys)
 {
-    d_array_t* const d_array = DynamicArrayConstructor (sizeof (k_heap_key*));
+    d_array_t* const d_array =
+        DynamicArrayConstructor (inline_keys ? sizeof (int) : sizeof (k_heap_key*));
     assert (d_array);
 
+    // one allocation instead of log2 (elem_number) reallocs
+    if (DynamicArrayReserve (d_array, elem_number) == DYNAMIC_ARRAY_ERROR)
+        return DynamicArrayDestructor (d_array);
+
     int input = 0;
-    k_heap_key* key = NULL;
 
     for (size_t i = 0; i < elem_number; ++i)
     {
         if (scanf ("%d", &input) != 1)
         {
-            for (size_t j = 0; j < d_array->size; ++j)
-                KHeapKeyDestructor (DynamicArrayGetElemPtrByIndex (d_array, j));
+            for (size_t j = 0; j < d_array->size && !inline_keys; ++j)
+                KHeapKeyDestructor (*(k_heap_key**) DynamicArrayGetElemPtrByIndex (d_array, j));
 
             return DynamicArrayDestructor (d_array);
         }
 
-        key = KHeapKeyConstructor (&input, sizeof (int));
-        DynamicArrayPush (d_array, &key);
+        // inline keys are the ints themselves, no allocation per key
+        if (inline_keys)
+        {
+            int* const slot = (int*) DynamicArrayEmplace (d_array);
+            assert (slot);
+
+            *slot = input;
+            continue;
+        }
+
+        k_heap_key** const slot = (k_heap_key**) DynamicArrayEmplace (d_array);
+        assert (slot);
+
+        *slot = KHeapKeyConstructor (&input, sizeof (int));
     }
     return d_array;
 }
 
 
 
-int main (void)
+int main (int argc, char* argv[])
 {
+    const size_t k = (argc > 1) ? strtoull (argv[1], NULL, 10) : K_HEAP_K_VALUE;
+    if (k < 2) return 1;
+
+    const bool inline_keys = (argc > 2 && strcmp (argv[2], "inline") == 0);
+
     size_t elem_number = 0;
     if (scanf ("%zd", &elem_number) != 1) return 1;
 
     printf ("%zu ", elem_number);
 
-    d_array_t* const d_array = ReadDynamicArray (elem_number);
+    d_array_t* const d_array = ReadDynamicArray (elem_number, inline_keys);
     assert (d_array);
 
-    printf ("%ld\n", KHeapLinear (d_array));
+    printf ("%ld\n", KHeapLinear (d_array, k, inline_keys));
     // d_array is freed during KHeapLinear ()
 
     return 0;
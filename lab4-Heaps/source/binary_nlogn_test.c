@@ -4,6 +4,8 @@
 
 
 
+// default arity, "binary_nlogn_test k [inline] < input" sets another one,
+// "inline" stores int keys in the heap array instead of k_heap_key pointers
 const size_t HEAP_K_VALUE = 2;
 const int HEAP_INFINITY_VALUE = INT_MAX;
 
@@ -24,25 +26,29 @@ CompareKHeapKeys (const k_heap_key* const a,
 }
 
 clock_t
-KHeapRegularInserts(d_array_t* const d_array)
+KHeapRegularInserts(d_array_t* const d_array,
+                    const size_t     k,
+                    const bool       inline_keys)
 {
     assert (d_array);
 
     k_heap_key* inf_key =
         KHeapKeyConstructor (&HEAP_INFINITY_VALUE, sizeof (int));
 
-    k_heap_t* heap =
-        KHeapConstructor (HEAP_K_VALUE, inf_key, CompareKHeapKeys);
+    k_heap_t* heap = inline_keys ?
+        KHeapConstructorInline (k, sizeof (int), inf_key, CompareKHeapKeys) :
+        KHeapConstructor       (k,               inf_key, CompareKHeapKeys);
     assert (heap);
 
     k_heap_key** key_ptr = NULL;
     k_heap_key*  key     = NULL;
 
-    heap->array = DynamicArrayDestructor (heap->array);
-    heap->array = d_array;
-
     const size_t elem_number = d_array->size;
-    d_array->size = 0;
+
+    // inserts don't realloc, empty slots before the root are reserved too
+    const d_array_error_t reserve_status =
+        DynamicArrayReserve (heap->array, heap->offset + elem_number);
+    assert (reserve_status == DYNAMIC_ARRAY_SUCCESS);
 
     clock_t begin = 0;
     clock_t end   = 0;
@@ -51,6 +57,15 @@ KHeapRegularInserts(d_array_t* const d_array)
 
     for (size_t i = 0; i < elem_number; ++i)
     {
+        if (inline_keys)
+        {
+            // view of the int, the heap copies its bytes
+            k_heap_key view = {DynamicArrayGetElemPtrByIndex (d_array, i), sizeof (int)};
+
+            KHeapInsertNoRealloc (heap, &view);
+            continue;
+        }
+
         key_ptr = DynamicArrayGetElemPtrByIndex (d_array, i);
         key = *key_ptr;
 
@@ -60,6 +75,10 @@ KHeapRegularInserts(d_array_t* const d_array)
 
     end = clock();
 
+    // keys of d_array are freed by the loop
+    d_array->size = 0;
+    DynamicArrayDestructor (d_array);
+
     inf_key = KHeapKeyDestructor (inf_key);
     heap    = KHeapDestructor    (heap);
 
@@ -67,41 +86,63 @@ KHeapRegularInserts(d_array_t* const d_array)
 }
 
 d_array_t*
-ReadDynamicArray (const size_t elem_number)
+ReadDynamicArray (const size_t elem_number,
+                  const bool   inline_keys)
 {
-    d_array_t* const d_array = DynamicArrayConstructor (sizeof (k_heap_key*));
+    d_array_t* const d_array =
+        DynamicArrayConstructor (inline_keys ? sizeof (int) : sizeof (k_heap_key*));
     assert (d_array);
 
+    // one allocation instead of log2 (elem_number) reallocs
+    if (DynamicArrayReserve (d_array, elem_number) == DYNAMIC_ARRAY_ERROR)
+        return DynamicArrayDestructor (d_array);
+
     int input = 0;
-    k_heap_key* key = NULL;
 
     for (size_t i = 0; i < elem_number; ++i)
     {
         if (scanf ("%d", &input) != 1)
         {
-            for (size_t j = 0; j < d_array->size; ++j)
-                KHeapKeyDestructor (DynamicArrayGetElemPtrByIndex (d_array, j));
+            for (size_t j = 0; j < d_array->size && !inline_keys; ++j)
+                KHeapKeyDestructor (*(k_heap_key**) DynamicArrayGetElemPtrByIndex (d_array, j));
 
             return DynamicArrayDestructor (d_array);
         }
 
-        key = KHeapKeyConstructor (&input, sizeof (int));
-        DynamicArrayPush (d_array, &key);
+        // inline keys are the ints themselves, no allocation per key
+        if (inline_keys)
+        {
+            int* const slot = (int*) DynamicArrayEmplace (d_array);
+            assert (slot);
+
+            *slot = input;
+            continue;
+        }
+
+        k_heap_key** const slot = (k_heap_key**) DynamicArrayEmplace (d_array);
+        assert (slot);
+
+        *slot = KHeapKeyConstructor (&input, sizeof (int));
     }
     return d_array;
 }
 
-int main (void)
+int main (int argc, char* argv[])
 {
+    const size_t k = (argc > 1) ? strtoull (argv[1], NULL, 10) : HEAP_K_VALUE;
+    if (k < 2) return 1;
+
+    const bool inline_keys = (argc > 2 && strcmp (argv[2], "inline") == 0);
+
     size_t elem_number = 0;
     assert (scanf ("%zd", &elem_number) == 1);
 
     printf ("%zu ", elem_number);
     
-    d_array_t* const d_array = ReadDynamicArray (elem_number);
+    d_array_t* const d_array = ReadDynamicArray (elem_number, inline_keys);
     assert (d_array);
 
-    printf ("%ld\n", KHeapRegularInserts (d_array));
+    printf ("%ld\n", KHeapRegularInserts (d_array, k, inline_keys));
 
     return 0;
 }
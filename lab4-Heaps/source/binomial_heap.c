@@ -3,36 +3,208 @@
 
 
 static binomial_heap_node*
-BinomialHeapMergeRoots (binomial_heap_node* const list1,
-                        binomial_heap_node* const list2);
+BinomialHeapUnion (binomial_heap_node* const list1,
+                   binomial_heap_node* const list2);
+
+static binomial_heap_node*
+BinomialHeapMergeRoots (binomial_heap_node* list1,
+                        binomial_heap_node* list2);
 
 static binomial_heap_node*
 BinomialHeapLinkTrees (binomial_heap_node* const tree1,
                        binomial_heap_node* const tree2);
 
+static binomial_heap_node*
+BinomialHeapSiftUp (binomial_heap_node* node,
+                    const bool unconditional);
+
+static void
+BinomialHeapRemoveRoot (binomial_heap* const heap,
+                        binomial_heap_node* const root);
+
+static binomial_heap_node*
+BinomialHeapFindMinRoot (binomial_heap_node* const head);
+
+static binomial_heap_node*
+BinomialHeapNodeConstructor (binomial_heap* const heap,
+                             const int key);
+
+static binomial_heap_node*
+BinomialHeapNodeDestructor (binomial_heap* const heap,
+                            binomial_heap_node* const node);
+
 
 
-binomial_heap_node*
-BinomialHeapDestructor (binomial_heap_node* const heap)
+binomial_heap*
+BinomialHeapConstructor (void)
 {
+    binomial_heap* const heap =
+        (binomial_heap*) calloc (1, sizeof (binomial_heap));
     if (heap == NULL) return NULL;
 
-    heap->sibling = BinomialHeapDestructor (heap->sibling);
-    heap->child   = BinomialHeapDestructor (heap->child);
+    heap->node_slab   = SlabConstructor (sizeof (binomial_heap_node));
+    heap->handle_slab = SlabConstructor (sizeof (binomial_heap_handle));
 
-    return BinomialHeapNodeDestructor (heap);
+    if (heap->node_slab == NULL || heap->handle_slab == NULL)
+        return BinomialHeapDestructor (heap);
+
+    return heap;
 }
 
-binomial_heap_node*
-BinomialHeapMerge (binomial_heap_node* const heap1,
-                   binomial_heap_node* const heap2)
+binomial_heap*
+BinomialHeapDestructor (binomial_heap* const heap)
 {
-    if (heap1 == NULL) return heap2;
-    if (heap2 == NULL) return heap1;
+    if (heap == NULL) return NULL;
+
+    heap->node_slab   = SlabDestructor (heap->node_slab);
+    heap->handle_slab = SlabDestructor (heap->handle_slab);
+
+    free (heap);
+    return NULL;
+}
+
+binomial_heap_error_t
+BinomialHeapMerge (binomial_heap* const heap1,
+                   binomial_heap* const heap2)
+{
+    if (heap1 == NULL || heap2 == NULL || heap1 == heap2)
+        return BINOMINAL_HEAP_ERROR;
+
+    binomial_heap_node* min = heap1->min;
+    if (min == NULL || (heap2->min != NULL && heap2->min->key < min->key))
+        min = heap2->min;
+
+    heap1->head  = BinomialHeapUnion (heap1->head, heap2->head);
+    heap1->size += heap2->size;
+
+    // min may be linked under a root with the same key
+    while (min != NULL && min->parent != NULL)
+        min = min->parent;
+
+    heap1->min = min;
+
+    SlabMerge (heap1->node_slab,   heap2->node_slab);
+    SlabMerge (heap1->handle_slab, heap2->handle_slab);
+
+    heap2->head = NULL;
+    heap2->min  = NULL;
+    heap2->size = 0;
+
+    return BINOMIAL_HEAP_SUCCESS;
+}
+
+binomial_heap_handle*
+BinomialHeapInsert (binomial_heap* const heap,
+                    const int key)
+{
+    if (heap == NULL) return NULL;
+
+    binomial_heap_node* const new_node =
+        BinomialHeapNodeConstructor (heap, key);
+    if (new_node == NULL) return NULL;
+
+    // binary increment: link with roots of the same degree while they carry
+    binomial_heap_node* tree = new_node;
+
+    while (heap->head != NULL && heap->head->degree == tree->degree)
+    {
+        binomial_heap_node* const next = heap->head->sibling;
+
+        if (heap->head->key <= tree->key)
+            tree = BinomialHeapLinkTrees (tree, heap->head);
+        else
+            tree = BinomialHeapLinkTrees (heap->head, tree);
+
+        heap->head = next;
+    }
+
+    tree->sibling = heap->head;
+    heap->head    = tree;
+    heap->size++;
+
+    binomial_heap_node* min = heap->min;
+    if (min == NULL || key < min->key) min = new_node;
+
+    while (min->parent != NULL)
+        min = min->parent;
+
+    heap->min = min;
+
+    return new_node->handle;
+}
+
+const binomial_heap_node*
+BinomialHeapFindMin (const binomial_heap* const heap)
+{
+    if (heap == NULL) return NULL;
+
+    return heap->min;
+}
+
+binomial_heap_error_t
+BinomialHeapExtractMin (binomial_heap* const heap,
+                        int* const key)
+{
+    if (heap == NULL || heap->min == NULL) return BINOMINAL_HEAP_ERROR;
+
+    if (key != NULL) *key = heap->min->key;
+
+    BinomialHeapRemoveRoot (heap, heap->min);
+
+    return BINOMIAL_HEAP_SUCCESS;
+}
+
+binomial_heap_error_t
+BinomialHeapDecreaseKey (binomial_heap* const heap,
+                         binomial_heap_handle* const handle,
+                         const int new_key)
+{
+    if (heap == NULL || handle == NULL || handle->node == NULL ||
+        new_key > handle->node->key)
+        return BINOMINAL_HEAP_ERROR;
+
+    handle->node->key = new_key;
+
+    binomial_heap_node* const node = BinomialHeapSiftUp (handle->node, false);
+
+    if (node->parent == NULL && node->key < heap->min->key)
+        heap->min = node;
+
+    return BINOMIAL_HEAP_SUCCESS;
+}
+
+binomial_heap_error_t
+BinomialHeapDelete (binomial_heap* const heap,
+                    binomial_heap_handle* const handle)
+{
+    if (heap == NULL || handle == NULL || handle->node == NULL)
+        return BINOMINAL_HEAP_ERROR;
+
+    // same as decreasing the key to minus infinity, but without comparisons
+    BinomialHeapRemoveRoot (heap, BinomialHeapSiftUp (handle->node, true));
+
+    return BINOMIAL_HEAP_SUCCESS;
+}
+
+size_t
+BinomialHeapSize (const binomial_heap* const heap)
+{
+    if (heap == NULL) return 0;
+
+    return heap->size;
+}
+
+
+
+static binomial_heap_node*
+BinomialHeapUnion (binomial_heap_node* const list1,
+                   binomial_heap_node* const list2)
+{
+    if (list1 == NULL) return list2;
+    if (list2 == NULL) return list1;
 
     binomial_heap_node* const head =
-        BinomialHeapMergeRoots (heap1, heap2);
-    if (head == NULL) return NULL;
+        BinomialHeapMergeRoots (list1, list2);
 
     binomial_heap_node* prev = NULL;
     binomial_heap_node* cur  = head;
@@ -42,14 +214,15 @@ BinomialHeapMerge (binomial_heap_node* const heap1,
 
     while (next != NULL)
     {
+        // of three roots of the same degree the first one is left as it is
         if (cur->degree != next->degree ||
-            next->sibling != NULL && next->sibling->degree == cur->degree)
+            (next->sibling != NULL && next->sibling->degree == cur->degree))
         {
             prev = cur;
             cur = next;
         }
 
-        else if (cur->key < next->key)
+        else if (cur->key <= next->key)
         {
             cur->sibling = next->sibling;
             BinomialHeapLinkTrees (next, cur);
@@ -70,92 +243,177 @@ BinomialHeapMerge (binomial_heap_node* const heap1,
     return merge_result;
 }
 
-binomial_heap_node*
-BinomialHeapInsert (binomial_heap_node* const heap,
-                    const int key)
+static binomial_heap_node*
+BinomialHeapMergeRoots (binomial_heap_node* list1,
+                        binomial_heap_node* list2)
 {
-    binomial_heap_node* const new_node =
-        BinomialHeapNodeConstructor (key);
-    if (new_node == NULL) return NULL;
+    binomial_heap_node*  head = NULL;
+    binomial_heap_node** tail = &head;
 
-    if (heap == NULL) return new_node;
+    while (list1 != NULL && list2 != NULL)
+    {
+        if (list1->degree <= list2->degree)
+        {
+            *tail = list1;
+            list1 = list1->sibling;
+        }
 
-    return BinomialHeapMerge (heap, new_node);
+        else
+        {
+            *tail = list2;
+            list2 = list2->sibling;
+        }
+
+        tail = &(*tail)->sibling;
+    }
+
+    *tail = (list1 != NULL) ? list1 : list2;
+
+    return head;
 }
 
-binomial_heap_node*
-BinomialHeapNodeConstructor (const int key)
+static binomial_heap_node*
+BinomialHeapLinkTrees (binomial_heap_node* const tree1,
+                       binomial_heap_node* const tree2)
 {
-    binomial_heap_node* const node =
-        (binomial_heap_node*) calloc (1, sizeof (binomial_heap_node));
-    if (node == NULL) return NULL;
+    if (tree1 == NULL) return tree2;
+    if (tree2 == NULL) return tree1;
 
-    node->key     = key;
-    node->parent  = NULL;
-    node->child   = NULL;
-    node->sibling = NULL;
-    node->degree  = 0;
+    if (tree1->degree != tree2->degree) return NULL;
+
+    tree1->parent  = tree2;
+    tree1->sibling = tree2->child;
+    tree2->child   = tree1;
+    tree2->degree++;
+
+    return tree2;
+}
+
+/**
+ * @brief Moves key of node up while it is less than key of parent,
+ * or up to the root if unconditional
+ *
+ * @return node the key ends in
+ *
+ * Keys and handles are swapped, nodes stay in their places.
+ */
+static binomial_heap_node*
+BinomialHeapSiftUp (binomial_heap_node* node,
+                    const bool unconditional)
+{
+    assert (node);
+
+    const int                   key    = node->key;
+    binomial_heap_handle* const handle = node->handle;
+
+    // the sifted key is written once, parents move down into the hole
+    while (node->parent != NULL && (unconditional || key < node->parent->key))
+    {
+        binomial_heap_node* const parent = node->parent;
+
+        node->key          = parent->key;
+        node->handle       = parent->handle;
+        node->handle->node = node;
+
+        node = parent;
+    }
+
+    node->key    = key;
+    node->handle = handle;
+    handle->node = node;
 
     return node;
 }
 
-binomial_heap_node*
-BinomialHeapNodeDestructor (binomial_heap_node* const node)
+/**
+ * @brief Removes root from the root list, its children go back to the heap
+ */
+static void
+BinomialHeapRemoveRoot (binomial_heap* const heap,
+                        binomial_heap_node* const root)
 {
-    if (node == NULL) return NULL;
+    assert (heap);
+    assert (root);
+    assert (root->parent == NULL);
 
-    free (node);
-    return NULL;
+    binomial_heap_node** link = &heap->head;
+    while (*link != root)
+        link = &(*link)->sibling;
+
+    *link = root->sibling;
+
+    // children are in decreasing order of degree, roots need increasing
+    binomial_heap_node* children = NULL;
+    binomial_heap_node* child    = root->child;
+
+    while (child != NULL)
+    {
+        binomial_heap_node* const next = child->sibling;
+
+        child->parent  = NULL;
+        child->sibling = children;
+        children       = child;
+
+        child = next;
+    }
+
+    heap->head = BinomialHeapUnion (heap->head, children);
+    heap->min  = BinomialHeapFindMinRoot (heap->head);
+    heap->size--;
+
+    BinomialHeapNodeDestructor (heap, root);
 }
 
 static binomial_heap_node*
-BinomialHeapMergeRoots (binomial_heap_node* const list1,
-                        binomial_heap_node* const list2)
+BinomialHeapFindMinRoot (binomial_heap_node* const head)
 {
-    if (list1 == NULL) return list2;
-    if (list2 == NULL) return list1;
+    binomial_heap_node* min = head;
 
-    binomial_heap_node* head = list1->degree <= list2->degree ? list1 : list2;
+    for (binomial_heap_node* root = head; root != NULL; root = root->sibling)
+        if (root->key < min->key)
+            min = root;
 
-    binomial_heap_node* cur1  = NULL;
-    binomial_heap_node* cur2  = NULL;
-    binomial_heap_node* next1 = list1;
-    binomial_heap_node* next2 = list2;
+    return min;
+}
 
-    while (next1 != NULL && next2 != NULL)
-    {
-        cur1 = next1;
-        cur2 = next2;
+static binomial_heap_node*
+BinomialHeapNodeConstructor (binomial_heap* const heap,
+                             const int key)
+{
+    assert (heap);
 
-        if (cur1->degree <= cur2->degree)
-        {
-            next1 = cur1->sibling;
-            cur1->sibling = cur2;
-        }
+    binomial_heap_node*   const node   = (binomial_heap_node*)   SlabAlloc (heap->node_slab);
+    binomial_heap_handle* const handle = (binomial_heap_handle*) SlabAlloc (heap->handle_slab);
 
-        else
-        {
-            next2 = cur2->sibling;
-            cur2->sibling = cur1;
-        }
+    if (node == NULL || handle == NULL)
+    {
+        SlabFree (heap->node_slab,   node);
+        SlabFree (heap->handle_slab, handle);
+        return NULL;
     }
 
-    return head;
+    node->key     = key;
+    node->parent  = NULL;
+    node->child   = NULL;
+    node->sibling = NULL;
+    node->handle  = handle;
+    node->degree  = 0;
+
+    handle->node = node;
+
+    return node;
 }
 
 static binomial_heap_node*
-BinomialHeapLinkTrees (binomial_heap_node* const tree1,
-                       binomial_heap_node* const tree2)
+BinomialHeapNodeDestructor (binomial_heap* const heap,
+                            binomial_heap_node* const node)
 {
-    if (tree1 == NULL) return tree2;
-    if (tree2 == NULL) return tree1;
+    assert (heap);
 
-    if (tree1->degree != tree2->degree) return NULL;
+    if (node == NULL) return NULL;
 
-    tree1->parent  = tree2;
-    tree1->sibling = tree2->child;
-    tree2->child   = tree1;
-    tree2->degree++;
+    SlabFree (heap->handle_slab, node->handle);
+    SlabFree (heap->node_slab,   node);
 
-    return tree2;
+    return NULL;
 }
@@ -9,17 +9,20 @@ BinomialHeapTest (const int* const array,
 {
     assert (array);
 
-    binomial_heap_node* root = NULL;
+    binomial_heap* heap = BinomialHeapConstructor ();
+    assert (heap);
 
     clock_t begin = 0;
     clock_t end   = 0;
 
     begin = clock ();
     for (size_t i = 0; i < elem_number; i++)
-        root = BinomialHeapInsert (root, array[i]);
+        BinomialHeapInsert (heap, array[i]);
     end = clock ();
 
-    root = BinomialHeapDestructor (root);
+    assert (BinomialHeapSize (heap) == elem_number);
+
+    heap = BinomialHeapDestructor (heap);
 
     return end - begin;
 }
@@ -1,8 +1,14 @@
+#define _GNU_SOURCE
 #include "../include/d_array.h"
+#include <sys/mman.h>
+#include <unistd.h>
 
 
 
-const size_t DYNAMIC_ARRAY_RESIZE_MULTIPLIER = 2;
+const size_t DYNAMIC_ARRAY_RESIZE_MULTIPLIER   = 2;
+const size_t DYNAMIC_ARRAY_CACHE_LINE_SIZE     = 64;
+const size_t DYNAMIC_ARRAY_MMAP_THRESHOLD      = 1 << 20;
+const size_t DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD = 1 << 21;
 
 typedef bool d_array_realloc_status_t;
 
@@ -21,6 +27,38 @@ DynamicArrayCheckRealloc (d_array_t* const array);
 
 static d_array_error_t
 DynamicArrayExecuteRealloc (d_array_t* const array);
+
+static d_array_error_t
+DynamicArraySetCapacity (d_array_t* const array,
+                         const size_t     capacity);
+
+static d_array_error_t
+DynamicArrayGrow (d_array_t* const array,
+                  const size_t     min_capacity);
+
+static size_t
+DynamicArrayInitialCapacity (const d_array_t* const array);
+
+static d_array_error_t
+DynamicArrayMoveInline (d_array_t* const array);
+
+static d_array_error_t
+DynamicArraySpillInline (d_array_t* const array);
+
+static d_array_error_t
+DynamicArrayReallocAligned (d_array_t* const array,
+                            const size_t     num_of_bytes);
+
+static d_array_error_t
+DynamicArrayReallocLarge (d_array_t* const array,
+                          const size_t     num_of_bytes);
+
+static void
+DynamicArrayFreeData (d_array_t* const array);
+
+static size_t
+DynamicArrayRoundUp (const size_t value,
+                     const size_t alignment);
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -34,6 +72,13 @@ DynamicArrayExecuteRealloc (d_array_t* const array);
 // Constructor and destructor
 d_array_t*
 DynamicArrayConstructor (const size_t element_size)
+{
+    return DynamicArrayConstructorWithMode (element_size, DYNAMIC_ARRAY_MEMORY_HEAP);
+}
+
+d_array_t*
+DynamicArrayConstructorWithMode (const size_t                element_size,
+                                 const d_array_memory_mode_t memory_mode)
 {
     d_array_t* const array = (d_array_t*) calloc(1, sizeof(d_array_t));
     if (array == NULL)
@@ -42,6 +87,7 @@ DynamicArrayConstructor (const size_t element_size)
     array->element_size = element_size;
     array->size         = 0;
     array->capacity     = 0;
+    array->memory_mode  = memory_mode;
 
     return array;
 }
@@ -52,7 +98,7 @@ DynamicArrayDestructor (d_array_t* const array)
     if (array == NULL)
         return NULL;
 
-    free(array->data);
+    DynamicArrayFreeData (array);
     free(array);
 
     return NULL;
@@ -130,6 +176,99 @@ DynamicArrayGetElemPtrByIndex (d_array_t* const array,
 
     return (char*)array->data + (index * array->element_size);
 }
+
+d_array_error_t
+DynamicArrayReserve (d_array_t* const array,
+                     const size_t     capacity)
+{
+    if (array == NULL)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (capacity > array->reserved)
+        array->reserved = capacity;
+
+    if (capacity <= array->capacity)
+        return DYNAMIC_ARRAY_SUCCESS;
+
+    return DynamicArraySetCapacity (array, capacity);
+}
+
+d_array_error_t
+DynamicArrayPushN (d_array_t*  const array,
+                   const void* const elements,
+                   const size_t      element_number)
+{
+    if (array == NULL ||
+        (elements == NULL && element_number != 0))
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (element_number == 0)
+        return DYNAMIC_ARRAY_SUCCESS;
+
+    if (array->size + element_number > array->capacity &&
+        DynamicArrayGrow (array, array->size + element_number) == DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    memcpy ((char*)array->data + array->size * array->element_size,
+            elements, element_number * array->element_size);
+    array->size += element_number;
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+void*
+DynamicArrayEmplace (d_array_t* const array)
+{
+    if (array == NULL)
+        return NULL;
+
+    if (array->size == array->capacity &&
+        DynamicArrayGrow (array, array->size + 1) == DYNAMIC_ARRAY_ERROR)
+        return NULL;
+
+    return (char*)array->data + (array->size++ * array->element_size);
+}
+
+d_array_error_t
+DynamicArrayResize (d_array_t* const array,
+                    const size_t     size)
+{
+    if (array == NULL)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (size > array->capacity &&
+        DynamicArrayGrow (array, size) == DYNAMIC_ARRAY_ERROR)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (size > array->size)
+        memset ((char*)array->data + array->size * array->element_size, 0,
+                (size - array->size) * array->element_size);
+
+    array->size = size;
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+d_array_error_t
+DynamicArrayShrinkToFit (d_array_t* const array)
+{
+    if (array == NULL)
+        return DYNAMIC_ARRAY_ERROR;
+
+    array->reserved = 0;
+
+    if (array->size == 0)
+    {
+        DynamicArrayFreeData (array);
+        array->capacity = 0;
+        return DYNAMIC_ARRAY_SUCCESS;
+    }
+
+    if (array->size == array->capacity)
+        return DYNAMIC_ARRAY_SUCCESS;
+
+    return DynamicArraySetCapacity (array, array->size);
+}
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -158,7 +297,7 @@ DynamicArrayCheckRealloc (d_array_t* const array)
 
     if (capacity == 0)
     {
-        array->capacity = 1;
+        array->capacity = DynamicArrayInitialCapacity (array);
         return true;
     }
 
@@ -168,8 +307,12 @@ DynamicArrayCheckRealloc (d_array_t* const array)
         return true;
     }
 
+    // reserved capacity is kept until DynamicArrayShrinkToFit(),
+    // inline buffer costs nothing, so it is never shrunk
     else if (size < capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER / 
-                               DYNAMIC_ARRAY_RESIZE_MULTIPLIER)
+                               DYNAMIC_ARRAY_RESIZE_MULTIPLIER &&
+             capacity / DYNAMIC_ARRAY_RESIZE_MULTIPLIER >= array->reserved &&
+             !array->inlined)
     {
         array->capacity /= DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
         return true;
@@ -185,13 +328,202 @@ DynamicArrayExecuteRealloc (d_array_t* const array)
 
     const size_t num_of_bytes = array->capacity * array->element_size;
 
+    if (array->memory_mode != DYNAMIC_ARRAY_MEMORY_ALIGNED &&
+        num_of_bytes <= DYNAMIC_ARRAY_INLINE_SIZE)
+        return DynamicArrayMoveInline (array);
+
+    if (array->inlined)
+        return DynamicArraySpillInline (array);
+
+    if (array->memory_mode == DYNAMIC_ARRAY_MEMORY_ALIGNED)
+        return DynamicArrayReallocAligned (array, num_of_bytes);
+
+    if (array->memory_mode == DYNAMIC_ARRAY_MEMORY_LARGE &&
+        (array->mapped || num_of_bytes >= DYNAMIC_ARRAY_MMAP_THRESHOLD))
+        return DynamicArrayReallocLarge (array, num_of_bytes);
+
     void* const new_ptr = realloc (array->data, num_of_bytes);
     if (new_ptr == NULL)
         return DYNAMIC_ARRAY_ERROR;
 
-    array->data = new_ptr;
+    array->data            = new_ptr;
+    array->allocated_bytes = num_of_bytes;
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static d_array_error_t
+DynamicArraySetCapacity (d_array_t* const array,
+                         const size_t     capacity)
+{
+    const size_t old_capacity = array->capacity;
+
+    array->capacity = capacity;
+
+    if (DynamicArrayExecuteRealloc (array) == DYNAMIC_ARRAY_ERROR)
+    {
+        array->capacity = old_capacity;
+        return DYNAMIC_ARRAY_ERROR;
+    }
+
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static d_array_error_t
+DynamicArrayGrow (d_array_t* const array,
+                  const size_t     min_capacity)
+{
+    size_t capacity = array->capacity * DYNAMIC_ARRAY_RESIZE_MULTIPLIER;
+
+    if (capacity < min_capacity) capacity = min_capacity;
+    if (capacity == 0)           capacity = DynamicArrayInitialCapacity (array);
+
+    return DynamicArraySetCapacity (array, capacity);
+}
+
+static size_t
+DynamicArrayInitialCapacity (const d_array_t* const array)
+{
+    // the whole inline buffer is free, so the first push takes all of it
+    if (array->memory_mode  != DYNAMIC_ARRAY_MEMORY_ALIGNED &&
+        array->element_size != 0 &&
+        array->element_size <= DYNAMIC_ARRAY_INLINE_SIZE)
+        return DYNAMIC_ARRAY_INLINE_SIZE / array->element_size;
+
+    return 1;
+}
+
+static d_array_error_t
+DynamicArrayMoveInline (d_array_t* const array)
+{
+    if (array->inlined)
+        return DYNAMIC_ARRAY_SUCCESS;
+
+    if (array->data != NULL)
+    {
+        memcpy (array->inline_buffer, array->data, array->size * array->element_size);
+        DynamicArrayFreeData (array);
+    }
+
+    array->data            = array->inline_buffer;
+    array->allocated_bytes = DYNAMIC_ARRAY_INLINE_SIZE;
+    array->inlined         = true;
     return DYNAMIC_ARRAY_SUCCESS;
 }
+
+static d_array_error_t
+DynamicArraySpillInline (d_array_t* const array)
+{
+    // allocated like the first allocation of the mode, then filled from the buffer
+    array->data            = NULL;
+    array->allocated_bytes = 0;
+    array->inlined         = false;
+
+    if (DynamicArrayExecuteRealloc (array) == DYNAMIC_ARRAY_ERROR)
+    {
+        array->data            = array->inline_buffer;
+        array->allocated_bytes = DYNAMIC_ARRAY_INLINE_SIZE;
+        array->inlined         = true;
+        return DYNAMIC_ARRAY_ERROR;
+    }
+
+    memcpy (array->data, array->inline_buffer, array->size * array->element_size);
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static d_array_error_t
+DynamicArrayReallocAligned (d_array_t* const array,
+                            const size_t     num_of_bytes)
+{
+    const size_t aligned_bytes =
+        DynamicArrayRoundUp (num_of_bytes, DYNAMIC_ARRAY_CACHE_LINE_SIZE);
+
+    // realloc() doesn't keep alignment, so data is copied
+    void* const new_ptr = aligned_alloc (DYNAMIC_ARRAY_CACHE_LINE_SIZE, aligned_bytes);
+    if (new_ptr == NULL)
+        return DYNAMIC_ARRAY_ERROR;
+
+    if (array->data != NULL)
+    {
+        memcpy (new_ptr, array->data, (array->allocated_bytes < aligned_bytes) ?
+                                       array->allocated_bytes : aligned_bytes);
+        free (array->data);
+    }
+
+    array->data            = new_ptr;
+    array->allocated_bytes = aligned_bytes;
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static d_array_error_t
+DynamicArrayReallocLarge (d_array_t* const array,
+                          const size_t     num_of_bytes)
+{
+    const long   page_size    = sysconf (_SC_PAGESIZE);
+    const size_t mapped_bytes =
+        DynamicArrayRoundUp (num_of_bytes, (page_size > 0) ? (size_t) page_size : 4096);
+
+    void* new_ptr = NULL;
+
+    if (array->mapped)
+    {
+        // pages are moved by page tables, not copied
+        new_ptr = mremap (array->data, array->allocated_bytes,
+                          mapped_bytes, MREMAP_MAYMOVE);
+        if (new_ptr == MAP_FAILED)
+            return DYNAMIC_ARRAY_ERROR;
+    }
+
+    else
+    {
+        new_ptr = mmap (NULL, mapped_bytes, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (new_ptr == MAP_FAILED)
+            return DYNAMIC_ARRAY_ERROR;
+
+        // the last copy, from now on growth is mremap()
+        if (array->data != NULL)
+        {
+            memcpy (new_ptr, array->data, (array->allocated_bytes < mapped_bytes) ?
+                                           array->allocated_bytes : mapped_bytes);
+            free (array->data);
+        }
+
+        array->mapped = true;
+    }
+
+    // only a hint, the array works without huge pages too
+    if (mapped_bytes >= DYNAMIC_ARRAY_HUGE_PAGE_THRESHOLD)
+        madvise (new_ptr, mapped_bytes, MADV_HUGEPAGE);
+
+    array->data            = new_ptr;
+    array->allocated_bytes = mapped_bytes;
+    return DYNAMIC_ARRAY_SUCCESS;
+}
+
+static void
+DynamicArrayFreeData (d_array_t* const array)
+{
+    // inline buffer is a part of the structure, nothing to free
+    if (array->mapped)
+        munmap (array->data, array->allocated_bytes);
+    else if (!array->inlined)
+        free (array->data);
+
+    array->data            = NULL;
+    array->allocated_bytes = 0;
+    array->mapped          = false;
+    array->inlined         = false;
+}
+
+static size_t
+DynamicArrayRoundUp (const size_t value,
+                     const size_t alignment)
+{
+    // empty allocation still has a valid pointer
+    if (value == 0) return alignment;
+
+    return (value + alignment - 1) / alignment * alignment;
+}
 //-------------------------------------
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
\ No newline at end of file
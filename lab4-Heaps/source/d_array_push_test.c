@@ -0,0 +1,85 @@
+#include "../include/d_array.h"
+#include "common.h"
+
+#include <string.h>
+
+
+
+static const char* const MEMORY_MODE_NAMES[] =
+{
+    "heap",
+    "aligned",
+    "large"
+};
+
+static const size_t MEMORY_MODE_NUMBER =
+    sizeof (MEMORY_MODE_NAMES) / sizeof (MEMORY_MODE_NAMES[0]);
+
+// random reads per element after pushes
+static const size_t READ_ROUNDS = 4;
+
+// volatile, so sums of random reads are not optimized out
+static volatile long long read_sum_sink = 0;
+
+
+
+/**
+ * @brief Pushes all elements to empty d_array_t, then reads it at random
+ * indices, where huge pages save TLB misses.
+ * 
+ * Usage: d_array_push_test heap|aligned|large < input
+ * Prints "elem_number push_clocks read_clocks".
+ */
+int main (int argc, char* argv[])
+{
+    if (argc < 2) return 1;
+
+    size_t memory_mode = 0;
+    while (memory_mode < MEMORY_MODE_NUMBER &&
+           strcmp (argv[1], MEMORY_MODE_NAMES[memory_mode]) != 0)
+        ++memory_mode;
+
+    if (memory_mode == MEMORY_MODE_NUMBER) return 1;
+
+    size_t elem_number = 0;
+    if (scanf ("%zd", &elem_number) != 1) return 1;
+
+    int* const input = ReadIntArray (elem_number);
+
+    d_array_t* d_array =
+        DynamicArrayConstructorWithMode (sizeof (int), (d_array_memory_mode_t) memory_mode);
+    assert (d_array);
+
+    clock_t begin = clock ();
+
+    for (size_t i = 0; i < elem_number; ++i)
+        DynamicArrayPush (d_array, &input[i]);
+
+    const clock_t push_clocks = clock () - begin;
+
+    const int* const data  = (const int*) d_array->data;
+    size_t           index = 0;
+    long long        sum   = 0;
+
+    begin = clock ();
+
+    for (size_t i = 0; i < READ_ROUNDS * elem_number; ++i)
+    {
+        index = (index * 6364136223846793005ULL + 1442695040888963407ULL) % elem_number;
+        sum  += data[index];
+    }
+
+    const clock_t read_clocks = clock () - begin;
+
+    for (size_t i = 0; i < elem_number; ++i)
+        assert (data[i] == input[i]);
+
+    printf ("%zu %ld %ld\n", elem_number, push_clocks, read_clocks);
+
+    read_sum_sink = sum;
+
+    d_array = DynamicArrayDestructor (d_array);
+    free (input);
+
+    return 0;
+}
@@ -0,0 +1,562 @@
+#include "binomial_heap.h"
+#include "k_heap.h"
+#include "common.h"
+
+#include <limits.h>
+#include <string.h>
+
+
+
+// "heap_check_test" checks heaps on random keys, nothing is timed,
+// a failed check aborts on assert
+const size_t CHECK_K_VALUES[] = {2, 3, 4, 8, 16};
+const size_t CHECK_SIZES[]    = {0, 1, 2, 17, 1000};
+const int    CHECK_INFINITY_VALUE = INT_MAX;
+const int    CHECK_KEY_RANGE      = 500;
+const unsigned int CHECK_SEED     = 2024;
+
+
+
+int
+CompareKHeapKeys (const k_heap_key* const a,
+                  const k_heap_key* const b)
+{
+    assert (a);
+    assert (b);
+
+    int cmp_status = CompareInt (a->key, b->key);
+
+    if (cmp_status == INT_CMP_LESS)    return K_HEAP_CMP_LESS;
+    if (cmp_status == INT_CMP_GREATER) return K_HEAP_CMP_GREATER;
+    return K_HEAP_CMP_EQUAL;
+}
+
+int
+CompareIntIncreasing (const void* a, const void* b)
+{
+    return CompareInt (a, b);
+}
+
+// k_heap is a max-heap, reference keys are sorted in decreasing order
+int
+CompareIntDecreasing (const void* a, const void* b)
+{
+    return CompareInt (b, a);
+}
+
+int
+KHeapKeyByIndex (const k_heap_t* const heap,
+                 const size_t          index)
+{
+    assert (heap);
+    assert (index < KHeapSize (heap));
+
+    const void* const element =
+        DynamicArrayGetElemPtrByIndex (heap->array, heap->offset + index);
+
+    if (heap->key_size == 0)
+        return *(const int*) (*(k_heap_key* const*) element)->key;
+
+    return *(const int*) element;
+}
+
+// every child is not greater than its parent, children of i are k * i + 1 ... k * i + k
+void
+KHeapCheckOrder (const k_heap_t* const heap)
+{
+    assert (heap);
+
+    const size_t heap_size = KHeapSize (heap);
+
+    for (size_t i = 1; i < heap_size; ++i)
+        assert (KHeapKeyByIndex (heap, i) <= KHeapKeyByIndex (heap, (i - 1) / heap->k));
+}
+
+// roots come in decreasing order and are exactly the keys of reference
+void
+KHeapCheckExtracts (k_heap_t*  const heap,
+                    const int* const reference,
+                    const size_t     elem_number)
+{
+    assert (heap);
+    assert (reference || elem_number == 0);
+
+    assert (KHeapSize (heap) == elem_number);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        const k_heap_key* const root = KHeapGetRoot (heap);
+        assert (root);
+        assert (*(const int*) root->key == reference[i]);
+
+        assert (KHeapExtractRoot (heap) == K_HEAP_SUCCESS);
+        assert (KHeapSize (heap) == elem_number - i - 1);
+
+        KHeapCheckOrder (heap);
+    }
+
+    assert (KHeapGetRoot (heap) == NULL);
+}
+
+k_heap_t*
+KHeapCheckConstructor (const size_t k,
+                       const bool   inline_keys)
+{
+    k_heap_key* const inf_key =
+        KHeapKeyConstructor (&CHECK_INFINITY_VALUE, sizeof (int));
+    assert (inf_key);
+
+    k_heap_t* const heap = inline_keys ?
+        KHeapConstructorInline (k, sizeof (int), inf_key, CompareKHeapKeys) :
+        KHeapConstructor       (k,               inf_key, CompareKHeapKeys);
+    assert (heap);
+
+    // the heap keeps its own copy of infinity key
+    KHeapKeyDestructor (inf_key);
+
+    return heap;
+}
+
+// linear build by KHeapSetArray () and sifts down, like binary_linear_test
+void
+KHeapLinearBuildTest (const int* const keys,
+                      const int* const reference,
+                      const size_t     elem_number,
+                      const size_t     k,
+                      const bool       inline_keys)
+{
+    k_heap_t* heap = KHeapCheckConstructor (k, inline_keys);
+
+    d_array_t* const d_array =
+        DynamicArrayConstructor (inline_keys ? sizeof (int) : sizeof (k_heap_key*));
+    assert (d_array);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        void* const slot = DynamicArrayEmplace (d_array);
+        assert (slot);
+
+        if (inline_keys)
+            *(int*) slot = keys[i];
+        else
+            *(k_heap_key**) slot = KHeapKeyConstructor (&keys[i], sizeof (int));
+    }
+
+    // d_array is owned by the heap from here
+    assert (KHeapSetArray (heap, d_array) == K_HEAP_SUCCESS);
+
+    for (size_t i = KHeapSize (heap) / k + 1; i-- > 0;)
+        assert (KHeapSiftDown (heap, i) == K_HEAP_SUCCESS);
+
+    KHeapCheckOrder    (heap);
+    KHeapCheckExtracts (heap, reference, elem_number);
+
+    heap = KHeapDestructor (heap);
+}
+
+// build by inserts, order is checked after every sift up
+void
+KHeapInsertBuildTest (const int* const keys,
+                      const int* const reference,
+                      const size_t     elem_number,
+                      const size_t     k,
+                      const bool       inline_keys)
+{
+    k_heap_t* heap = KHeapCheckConstructor (k, inline_keys);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        const k_heap_key key = {(void*) &keys[i], sizeof (int)};
+
+        assert (KHeapInsert (heap, &key) == K_HEAP_SUCCESS);
+        KHeapCheckOrder (heap);
+    }
+
+    KHeapCheckExtracts (heap, reference, elem_number);
+
+    heap = KHeapDestructor (heap);
+}
+
+void
+KHeapOrderTest (const size_t elem_number)
+{
+    int* const keys      = (int*) calloc (elem_number + 1, sizeof (int));
+    int* const reference = (int*) calloc (elem_number + 1, sizeof (int));
+    assert (keys);
+    assert (reference);
+
+    // small range, so there are equal keys
+    for (size_t i = 0; i < elem_number; ++i)
+        keys[i] = reference[i] = rand () % CHECK_KEY_RANGE - CHECK_KEY_RANGE / 2;
+
+    qsort (reference, elem_number, sizeof (int), CompareIntDecreasing);
+
+    for (size_t i = 0; i < sizeof (CHECK_K_VALUES) / sizeof (CHECK_K_VALUES[0]); ++i)
+    {
+        for (int inline_keys = 0; inline_keys <= 1; ++inline_keys)
+        {
+            KHeapLinearBuildTest (keys, reference, elem_number, CHECK_K_VALUES[i], inline_keys);
+            KHeapInsertBuildTest (keys, reference, elem_number, CHECK_K_VALUES[i], inline_keys);
+        }
+    }
+
+    free (keys);
+    free (reference);
+}
+
+// inline heap rejects a key longer than key_size and stays as it was
+void
+KHeapLongKeyTest (const size_t k)
+{
+    k_heap_t* heap = KHeapCheckConstructor (k, true);
+
+    for (int i = 0; i < CHECK_KEY_RANGE; ++i)
+    {
+        const int        value = rand () % CHECK_KEY_RANGE;
+        const k_heap_key key   = {(void*) &value, sizeof (int)};
+
+        assert (KHeapInsert (heap, &key) == K_HEAP_SUCCESS);
+    }
+
+    const size_t heap_size  = KHeapSize (heap);
+    const size_t data_bytes = heap->array->size * heap->array->element_size;
+
+    char* const data_copy = (char*) malloc (data_bytes);
+    assert (data_copy);
+    memcpy (data_copy, heap->array->data, data_bytes);
+
+    const char       long_key[sizeof (int) + 1] = {};
+    const k_heap_key long_view = {(void*) long_key, sizeof (long_key)};
+
+    assert (KHeapInsert          (heap, &long_view) == K_HEAP_ERROR);
+    assert (KHeapInsertNoRealloc (heap, &long_view) == K_HEAP_ERROR);
+
+    assert (KHeapSize (heap) == heap_size);
+    assert (memcmp (heap->array->data, data_copy, data_bytes) == 0);
+
+    KHeapCheckOrder (heap);
+
+    free (data_copy);
+    heap = KHeapDestructor (heap);
+}
+
+//-----------------------------------------------------------------------------
+// Binomial heap checks
+//-----------------------------------------------------------------------------
+// 0, 2, 4, ... shuffled: keys are distinct, so a removed key must be absent
+void
+DistinctShuffledKeys (int* const   keys,
+                      const size_t elem_number)
+{
+    assert (keys || elem_number == 0);
+
+    for (size_t i = 0; i < elem_number; ++i)
+        keys[i] = 2 * (int) i;
+
+    for (size_t i = elem_number; i > 1; --i)
+    {
+        const size_t j = (size_t) rand () % i;
+
+        const int tmp = keys[i - 1];
+        keys[i - 1]   = keys[j];
+        keys[j]       = tmp;
+    }
+}
+
+/**
+ * @brief Checks the tree of node and its siblings
+ *
+ * @return number of nodes, counted keys equal to key go to key_number
+ *
+ * Every node is not less than its parent, has degree children and
+ * the handle of its key points back to it.
+ */
+size_t
+BinomialCheckTrees (const binomial_heap_node* const node,
+                    const binomial_heap_node* const parent,
+                    const int                       key,
+                    size_t* const                   key_number)
+{
+    assert (key_number);
+
+    size_t node_number = 0;
+
+    for (const binomial_heap_node* cur = node; cur != NULL; cur = cur->sibling)
+    {
+        assert (cur->parent == parent);
+        assert (parent == NULL || parent->key <= cur->key);
+        assert (cur->handle != NULL && cur->handle->node == cur);
+
+        size_t child_number = 0;
+        for (const binomial_heap_node* child = cur->child; child != NULL; child = child->sibling)
+            child_number++;
+
+        assert (child_number == cur->degree);
+
+        if (cur->key == key) (*key_number)++;
+
+        node_number += 1 + BinomialCheckTrees (cur->child, cur, key, key_number);
+    }
+
+    return node_number;
+}
+
+/**
+ * @return number of nodes with key, heap structure, size, min and slabs are checked
+ */
+size_t
+BinomialCheckHeap (const binomial_heap* const heap,
+                   const int                  key)
+{
+    assert (heap);
+
+    size_t key_number = 0;
+
+    assert (BinomialCheckTrees (heap->head, NULL, key, &key_number) == BinomialHeapSize (heap));
+    assert (heap->node_slab->allocated   == BinomialHeapSize (heap));
+    assert (heap->handle_slab->allocated == BinomialHeapSize (heap));
+
+    // roots go in increasing order of degree, min is the smallest root
+    for (const binomial_heap_node* root = heap->head; root != NULL; root = root->sibling)
+    {
+        assert (root->sibling == NULL || root->degree < root->sibling->degree);
+        assert (heap->min != NULL && heap->min->key <= root->key);
+    }
+
+    assert ((heap->min == NULL) == (heap->head == NULL));
+    assert (heap->min == NULL || heap->min->parent == NULL);
+
+    return key_number;
+}
+
+// ExtractMin () gives keys of reference in increasing order
+void
+BinomialCheckExtracts (binomial_heap* const heap,
+                       const int* const     reference,
+                       const size_t         elem_number)
+{
+    assert (heap);
+    assert (reference || elem_number == 0);
+
+    assert (BinomialHeapSize (heap) == elem_number);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        int key = 0;
+
+        assert (BinomialHeapFindMin (heap)->key == reference[i]);
+        assert (BinomialHeapExtractMin (heap, &key) == BINOMIAL_HEAP_SUCCESS);
+        assert (key == reference[i]);
+
+        BinomialCheckHeap (heap, key);
+    }
+
+    assert (BinomialHeapFindMin (heap) == NULL);
+    assert (BinomialHeapExtractMin (heap, NULL) == BINOMINAL_HEAP_ERROR);
+}
+
+binomial_heap*
+BinomialCheckBuild (const int* const             keys,
+                    binomial_heap_handle** const handles,
+                    const size_t                 elem_number)
+{
+    binomial_heap* const heap = BinomialHeapConstructor ();
+    assert (heap);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        handles[i] = BinomialHeapInsert (heap, keys[i]);
+        assert (handles[i]);
+        assert (handles[i]->node->key == keys[i]);
+    }
+
+    BinomialCheckHeap (heap, 0);
+
+    return heap;
+}
+
+// keys with duplicates come out sorted
+void
+BinomialExtractTest (const size_t elem_number)
+{
+    int* const keys      = (int*) calloc (elem_number + 1, sizeof (int));
+    int* const reference = (int*) calloc (elem_number + 1, sizeof (int));
+    binomial_heap_handle** const handles =
+        (binomial_heap_handle**) calloc (elem_number + 1, sizeof (binomial_heap_handle*));
+    assert (keys);
+    assert (reference);
+    assert (handles);
+
+    for (size_t i = 0; i < elem_number; ++i)
+        keys[i] = reference[i] = rand () % CHECK_KEY_RANGE - CHECK_KEY_RANGE / 2;
+
+    qsort (reference, elem_number, sizeof (int), CompareIntIncreasing);
+
+    binomial_heap* heap = BinomialCheckBuild (keys, handles, elem_number);
+    BinomialCheckExtracts (heap, reference, elem_number);
+    heap = BinomialHeapDestructor (heap);
+
+    free (keys);
+    free (reference);
+    free (handles);
+}
+
+// every key is decreased through its handle, a greater key is rejected
+void
+BinomialDecreaseKeyTest (const size_t elem_number)
+{
+    int* const keys = (int*) calloc (elem_number + 1, sizeof (int));
+    binomial_heap_handle** const handles =
+        (binomial_heap_handle**) calloc (elem_number + 1, sizeof (binomial_heap_handle*));
+    assert (keys);
+    assert (handles);
+
+    DistinctShuffledKeys (keys, elem_number);
+
+    binomial_heap* heap = BinomialCheckBuild (keys, handles, elem_number);
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        assert (BinomialHeapDecreaseKey (heap, handles[i], keys[i] + 1) == BINOMINAL_HEAP_ERROR);
+        assert (handles[i]->node->key == keys[i]);
+
+        // new keys may repeat, the handle tells which node is the decreased one
+        keys[i] -= 2 * (rand () % (int) elem_number) + 1;
+
+        assert (BinomialHeapDecreaseKey (heap, handles[i], keys[i]) == BINOMIAL_HEAP_SUCCESS);
+        assert (handles[i]->node->key == keys[i]);
+        assert (BinomialCheckHeap (heap, keys[i]) >= 1);
+    }
+
+    qsort (keys, elem_number, sizeof (int), CompareIntIncreasing);
+    BinomialCheckExtracts (heap, keys, elem_number);
+
+    heap = BinomialHeapDestructor (heap);
+
+    free (keys);
+    free (handles);
+}
+
+// keys are deleted through handles in random order, the rest is not touched
+void
+BinomialDeleteTest (const size_t elem_number)
+{
+    int* const keys  = (int*) calloc (elem_number + 1, sizeof (int));
+    int* const order = (int*) calloc (elem_number + 1, sizeof (int));
+    binomial_heap_handle** const handles =
+        (binomial_heap_handle**) calloc (elem_number + 1, sizeof (binomial_heap_handle*));
+    assert (keys);
+    assert (order);
+    assert (handles);
+
+    DistinctShuffledKeys (keys,  elem_number);
+    DistinctShuffledKeys (order, elem_number);
+
+    binomial_heap* heap = BinomialCheckBuild (keys, handles, elem_number);
+
+    // half of the keys are deleted, order[i] / 2 is a random permutation
+    const size_t delete_number = elem_number / 2;
+
+    for (size_t i = 0; i < delete_number; ++i)
+    {
+        const size_t index = (size_t) order[i] / 2;
+
+        assert (handles[index]->node->key == keys[index]);
+        assert (BinomialHeapDelete (heap, handles[index]) == BINOMIAL_HEAP_SUCCESS);
+
+        assert (BinomialHeapSize (heap) == elem_number - i - 1);
+        assert (BinomialCheckHeap (heap, keys[index]) == 0);
+
+        handles[index] = NULL;
+    }
+
+    // kept keys go first, their handles still point to them
+    size_t kept_number = 0;
+
+    for (size_t i = 0; i < elem_number; ++i)
+    {
+        if (handles[i] == NULL) continue;
+
+        assert (handles[i]->node->key == keys[i]);
+        keys[kept_number++] = keys[i];
+    }
+
+    assert (kept_number == elem_number - delete_number);
+
+    qsort (keys, kept_number, sizeof (int), CompareIntIncreasing);
+    BinomialCheckExtracts (heap, keys, kept_number);
+
+    heap = BinomialHeapDestructor (heap);
+
+    free (keys);
+    free (order);
+    free (handles);
+}
+
+// handles of the second heap work with the first one after merge
+void
+BinomialMergeTest (const size_t elem_number)
+{
+    int* const keys = (int*) calloc (2 * elem_number + 1, sizeof (int));
+    binomial_heap_handle** const handles =
+        (binomial_heap_handle**) calloc (2 * elem_number + 1, sizeof (binomial_heap_handle*));
+    assert (keys);
+    assert (handles);
+
+    DistinctShuffledKeys (keys, 2 * elem_number);
+
+    binomial_heap* heap_1 = BinomialCheckBuild (keys,               handles,               elem_number);
+    binomial_heap* heap_2 = BinomialCheckBuild (keys + elem_number, handles + elem_number, elem_number);
+
+    assert (BinomialHeapMerge (heap_1, heap_2) == BINOMIAL_HEAP_SUCCESS);
+
+    assert (BinomialHeapSize (heap_2) == 0);
+    assert (BinomialHeapFindMin (heap_2) == NULL);
+    BinomialCheckHeap (heap_1, 0);
+
+    for (size_t i = elem_number; i < 2 * elem_number; ++i)
+    {
+        assert (BinomialHeapDelete (heap_1, handles[i]) == BINOMIAL_HEAP_SUCCESS);
+        assert (BinomialCheckHeap (heap_1, keys[i]) == 0);
+    }
+
+    qsort (keys, elem_number, sizeof (int), CompareIntIncreasing);
+    BinomialCheckExtracts (heap_1, keys, elem_number);
+
+    heap_1 = BinomialHeapDestructor (heap_1);
+    heap_2 = BinomialHeapDestructor (heap_2);
+
+    free (keys);
+    free (handles);
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+
+int main (void)
+{
+    srand (CHECK_SEED);
+
+    for (size_t i = 0; i < sizeof (CHECK_SIZES) / sizeof (CHECK_SIZES[0]); ++i)
+        KHeapOrderTest (CHECK_SIZES[i]);
+
+    printf ("k-heap order: ok\n");
+
+    for (size_t i = 0; i < sizeof (CHECK_K_VALUES) / sizeof (CHECK_K_VALUES[0]); ++i)
+        KHeapLongKeyTest (CHECK_K_VALUES[i]);
+
+    printf ("k-heap inline key length: ok\n");
+
+    for (size_t i = 0; i < sizeof (CHECK_SIZES) / sizeof (CHECK_SIZES[0]); ++i)
+    {
+        BinomialExtractTest     (CHECK_SIZES[i]);
+        BinomialDecreaseKeyTest (CHECK_SIZES[i]);
+        BinomialDeleteTest      (CHECK_SIZES[i]);
+        BinomialMergeTest       (CHECK_SIZES[i]);
+    }
+
+    printf ("binomial heap extract, decrease-key, delete, merge: ok\n");
+
+    return 0;
+}
@@ -4,9 +4,19 @@
 
 
 
+const size_t K_HEAP_CACHE_LINE_SIZE = 64;
+
+
 //-----------------------------------------------------------------------------
 // K-heap static functions prototypes
 //-----------------------------------------------------------------------------
+static k_heap_t*
+KHeapCreate (const size_t k,
+             const size_t key_size,
+             const k_heap_key* const infinity_key,
+             int (*key_cmp) (const k_heap_key* const,
+                             const k_heap_key* const));
+
 static k_heap_error_t
 KHeapPushNewItem (k_heap_t*         const heap,
                   const k_heap_key* const key);
@@ -15,6 +25,11 @@ static k_heap_error_t
 KHeapPushNewItemNoRealloc (k_heap_t*         const heap,
                            const k_heap_key* const key);
 
+static void
+KHeapWriteItem (const k_heap_t*   const heap,
+                void*             const element,
+                const k_heap_key* const key);
+
 static k_heap_error_t
 KHeapCopyLastElement (k_heap_t* const heap);
 
@@ -25,16 +40,31 @@ static k_heap_error_t
 KHeapSiftUp (k_heap_t* const heap,
              const size_t index);
 
+static inline int
+KHeapCompare (const k_heap_t* const heap,
+              const void*     const element_1,
+              const void*     const element_2);
+
 static k_heap_key*
 KHeapKeyCopy (const k_heap_key* const key);
 
 static size_t
-KHeapSize (const k_heap_t* const heap);
+KHeapOffset (const size_t k,
+             const size_t element_size);
+
+static d_array_t*
+KHeapArrayConstructor (const size_t element_size,
+                       const size_t offset);
 
 static void
-KHeapSwap (k_heap_t* const heap,
-           const size_t index_1,
-           const size_t index_2);
+KHeapDestroyKeys (k_heap_t* const heap);
+
+static inline char*
+KHeapData (const k_heap_t* const heap);
+
+static void*
+KHeapGetElemPtr (const k_heap_t* const heap,
+                 const size_t index);
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 
@@ -51,20 +81,19 @@ KHeapConstructor (const size_t k,
                   int (*key_cmp) (const k_heap_key* const,
                                   const k_heap_key* const))
 {
-    if (infinity_key == NULL ||
-        key_cmp      == NULL)
-        return NULL;
-
-    k_heap_t* const heap = (k_heap_t*) malloc (sizeof (k_heap_t));
-    if (heap == NULL)
-        return NULL;
+    return KHeapCreate (k, 0, infinity_key, key_cmp);
+}
 
-    heap->k            = k;
-    heap->infinity_key = KHeapKeyCopy (infinity_key);
-    heap->array        = DynamicArrayConstructor (sizeof (k_heap_key*));
-    heap->key_cmp      = key_cmp;
+k_heap_t*
+KHeapConstructorInline (const size_t k,
+                        const size_t key_size,
+                        const k_heap_key* const infinity_key,
+                        int (*key_cmp) (const k_heap_key* const,
+                                        const k_heap_key* const))
+{
+    if (key_size == 0) return NULL;
 
-    return heap;
+    return KHeapCreate (k, key_size, infinity_key, key_cmp);
 }
 
 k_heap_t*
@@ -75,19 +104,10 @@ KHeapDestructor  (k_heap_t* const heap)
 
     heap->infinity_key = KHeapKeyDestructor (heap->infinity_key);
 
-    k_heap_key** cur_key = NULL;
-    const size_t elem_number = KHeapSize (heap);
-
-    for (size_t i = 0; i < elem_number; ++i)
-    {
-        cur_key = DynamicArrayGetElemPtrByIndex (heap->array, i);
-        
-        if (cur_key != NULL)
-            *cur_key = KHeapKeyDestructor (*cur_key);
-    }
-
+    KHeapDestroyKeys (heap);
     heap->array = DynamicArrayDestructor (heap->array);
 
+    free (heap->hole);
     free (heap);
     return NULL;
 }
@@ -126,11 +146,17 @@ KHeapGetRoot (k_heap_t* const heap)
 {
     if (heap == NULL) return NULL;
 
-    k_heap_key** const key_ptr =
-        DynamicArrayGetElemPtrByIndex (heap->array, 0);
+    if (KHeapSize (heap) == 0) return NULL;
+
+    void* const root = KHeapGetElemPtr (heap, 0);
+
+    if (heap->key_size == 0)
+        return *(k_heap_key**) root;
+
+    heap->root_view.key     = root;
+    heap->root_view.key_len = heap->key_size;
 
-    if (key_ptr == NULL) return NULL;
-    return *key_ptr;
+    return &heap->root_view;
 }
 
 k_heap_error_t
@@ -146,10 +172,81 @@ KHeapExtractRoot (k_heap_t* const heap)
 
     return error_status;
 }
+
+k_heap_error_t
+KHeapSetArray (k_heap_t*  const heap,
+               d_array_t* const array)
+{
+    if (heap  == NULL ||
+        array == NULL ||
+        array->element_size != heap->array->element_size)
+        return K_HEAP_ERROR;
+
+    d_array_t* new_array =
+        KHeapArrayConstructor (heap->array->element_size, heap->offset);
+    if (new_array == NULL) return K_HEAP_ERROR;
+
+    if (DynamicArrayReserve (new_array, heap->offset + array->size) == DYNAMIC_ARRAY_ERROR ||
+        DynamicArrayPushN   (new_array, array->data, array->size)   == DYNAMIC_ARRAY_ERROR)
+    {
+        new_array = DynamicArrayDestructor (new_array);
+        return K_HEAP_ERROR;
+    }
+
+    KHeapDestroyKeys (heap);
+    DynamicArrayDestructor (heap->array);
+    heap->array = new_array;
+
+    // keys are owned by the heap now
+    DynamicArrayDestructor (array);
+
+    return K_HEAP_SUCCESS;
+}
+
+size_t
+KHeapSize (const k_heap_t* const heap)
+{
+    if (heap        == NULL ||
+        heap->array == NULL)
+        return 0;
+
+    return heap->array->size - heap->offset;
+}
 //-------------------------------------
 
 //-------------------------------------
 // Static functions
+static k_heap_t*
+KHeapCreate (const size_t k,
+             const size_t key_size,
+             const k_heap_key* const infinity_key,
+             int (*key_cmp) (const k_heap_key* const,
+                             const k_heap_key* const))
+{
+    if (infinity_key == NULL ||
+        key_cmp      == NULL)
+        return NULL;
+
+    k_heap_t* const heap = (k_heap_t*) calloc (1, sizeof (k_heap_t));
+    if (heap == NULL)
+        return NULL;
+
+    const size_t element_size = (key_size == 0) ? sizeof (k_heap_key*) : key_size;
+
+    heap->k            = k;
+    heap->key_size     = key_size;
+    heap->offset       = KHeapOffset (k, element_size);
+    heap->infinity_key = KHeapKeyCopy (infinity_key);
+    heap->array        = KHeapArrayConstructor (element_size, heap->offset);
+    heap->hole         = malloc (element_size);
+    heap->key_cmp      = key_cmp;
+
+    if (k < 2 || heap->infinity_key == NULL || heap->array == NULL || heap->hole == NULL)
+        return KHeapDestructor (heap);
+
+    return heap;
+}
+
 static k_heap_error_t
 KHeapPushNewItem (k_heap_t*         const heap,
                   const k_heap_key* const key)
@@ -158,15 +255,28 @@ KHeapPushNewItem (k_heap_t*         const heap,
         key   == NULL)
         return K_HEAP_ERROR;
 
-    k_heap_key* new_key = KHeapKeyCopy (key);
-    if (new_key == NULL) return K_HEAP_ERROR;
+    // inline key longer than key_size would be truncated
+    if (heap->key_size != 0 && key->key_len > heap->key_size)
+        return K_HEAP_ERROR;
+
+    // inline key is written in place, pointer key is copied first
+    k_heap_key* new_key = NULL;
 
-    if (DynamicArrayPush (heap->array, &new_key) == DYNAMIC_ARRAY_ERROR)
+    if (heap->key_size == 0)
+    {
+        new_key = KHeapKeyCopy (key);
+        if (new_key == NULL) return K_HEAP_ERROR;
+    }
+
+    void* const element = DynamicArrayEmplace (heap->array);
+    if (element == NULL)
     {
         new_key = KHeapKeyDestructor (new_key);
         return K_HEAP_ERROR;
     }
 
+    KHeapWriteItem (heap, element, (new_key != NULL) ? new_key : key);
+
     return K_HEAP_SUCCESS;
 }
 
@@ -175,46 +285,51 @@ KHeapPushNewItemNoRealloc (k_heap_t*         const heap,
                            const k_heap_key* const key)
 {
     if (heap  == NULL ||
-        key   == NULL)
+        key   == NULL ||
+        heap->array->size == heap->array->capacity)
         return K_HEAP_ERROR;
 
-    k_heap_key* new_key = KHeapKeyCopy (key);
-    if (new_key == NULL) return K_HEAP_ERROR;
+    return KHeapPushNewItem (heap, key);
+}
 
-    if (DynamicArrayPushNoRealloc (heap->array, &new_key) == DYNAMIC_ARRAY_ERROR)
+/**
+ * Pointer mode stores key itself, inline mode copies key->key bytes,
+ * the rest of key_size bytes is zeroed.
+ */
+static void
+KHeapWriteItem (const k_heap_t*   const heap,
+                void*             const element,
+                const k_heap_key* const key)
+{
+    if (heap->key_size == 0)
     {
-        new_key = KHeapKeyDestructor (new_key);
-        return K_HEAP_ERROR;
+        memcpy (element, &key, sizeof (k_heap_key*));
+        return;
     }
 
-    return K_HEAP_SUCCESS;
+    if (key->key_len != 0)
+        memcpy (element, key->key, key->key_len);
+
+    memset ((char*) element + key->key_len, 0, heap->key_size - key->key_len);
 }
 
 static k_heap_error_t
 KHeapCopyLastElement (k_heap_t* const heap)
 {
     if (heap        == NULL ||
-        heap->array == NULL)
+        heap->array == NULL ||
+        KHeapSize (heap) == 0)
         return K_HEAP_ERROR;
 
-    k_heap_key** const last_key_ptr =
-        DynamicArrayGetElemPtrByIndex (heap->array, KHeapSize (heap) - 1);
-    if (last_key_ptr == NULL) return K_HEAP_ERROR;
-
-    k_heap_key* const last_key = *last_key_ptr;
-    if (last_key == NULL) return K_HEAP_ERROR;
-
-    k_heap_key** const root_key_ptr =
-        DynamicArrayGetElemPtrByIndex (heap->array, 0);
-    if (root_key_ptr == NULL) return K_HEAP_ERROR;
+    void* const last_ptr = KHeapGetElemPtr (heap, KHeapSize (heap) - 1);
+    void* const root_ptr = KHeapGetElemPtr (heap, 0);
 
-    k_heap_key* const root_key = *root_key_ptr;
-    if (root_key == NULL) return K_HEAP_ERROR;
+    if (heap->key_size == 0)
+        KHeapKeyDestructor (*(k_heap_key**) root_ptr);
 
-    if (root_key == last_key) return K_HEAP_SUCCESS;
-
-    KHeapKeyDestructor (root_key);
-    *root_key_ptr = KHeapKeyCopy (last_key);
+    // the last element moves to the root, nothing is copied or allocated
+    if (root_ptr != last_ptr)
+        memcpy (root_ptr, last_ptr, heap->array->element_size);
 
     return K_HEAP_SUCCESS;
 }
@@ -223,16 +338,8 @@ static k_heap_error_t
 KHeapPopLastElement (k_heap_t* const heap)
 {
     if (heap == NULL) return K_HEAP_ERROR;
-    
-    k_heap_key** const last_key_ptr =
-        DynamicArrayGetElemPtrByIndex (heap->array, KHeapSize (heap) - 1);
-    if (last_key_ptr == NULL) return K_HEAP_ERROR;
-
-    k_heap_key* const last_key = *last_key_ptr;
-    if (last_key == NULL) return K_HEAP_ERROR;
-
-    KHeapKeyDestructor (last_key);
 
+    // the last key is at the root now or destroyed with the root
     d_array_error_t error_status = DynamicArrayPop (heap->array);
 
     if (error_status == DYNAMIC_ARRAY_ERROR) return K_HEAP_ERROR;
@@ -245,31 +352,32 @@ KHeapSiftUp (k_heap_t* const heap,
 {
     if (heap          == NULL ||
         heap->array   == NULL ||
-        heap->key_cmp == NULL)
+        heap->key_cmp == NULL ||
+        index >= KHeapSize (heap))
         return K_HEAP_ERROR;
 
-    size_t cur_index    = index;
-    size_t parent_index = 0;
+    char* const  data         = KHeapData (heap);
+    const size_t element_size = heap->array->element_size;
 
-    k_heap_key** cur_key_ptr    = NULL;
-    k_heap_key** parent_key_ptr = NULL;
+    // parents less than the element move down into the hole, it is written once
+    memcpy (heap->hole, data + index * element_size, element_size);
+
+    size_t cur_index = index;
 
     while (cur_index != 0)
     {
-        parent_index = (cur_index - 1) / 2;
-
-        cur_key_ptr    = DynamicArrayGetElemPtrByIndex (heap->array, cur_index);
-        parent_key_ptr = DynamicArrayGetElemPtrByIndex (heap->array, parent_index);
+        const size_t parent_index = (cur_index - 1) / heap->k;
+        char* const  parent       = data + parent_index * element_size;
 
-        if (heap->key_cmp (*parent_key_ptr, *cur_key_ptr) == K_HEAP_CMP_LESS)
-        {
-            KHeapSwap (heap, parent_index, cur_index);
-            cur_index = parent_index;
-        }
+        if (KHeapCompare (heap, parent, heap->hole) != K_HEAP_CMP_LESS)
+            break;
 
-        else break;
+        memcpy (data + cur_index * element_size, parent, element_size);
+        cur_index = parent_index;
     }
 
+    memcpy (data + cur_index * element_size, heap->hole, element_size);
+
     return K_HEAP_SUCCESS;
 }
 
@@ -285,69 +393,140 @@ KHeapSiftDown (k_heap_t* const heap,
 
     if (index >= heap_size) return K_HEAP_SUCCESS;
 
-    size_t min_index         = index;
-    size_t left_child_index  = index * 2 + 1;
-    size_t right_child_index = index * 2 + 2;
+    char* const  data         = KHeapData (heap);
+    const size_t element_size = heap->array->element_size;
+    const size_t k            = heap->k;
+
+    // the greatest child moves up into the hole while it's greater than the element
+    memcpy (heap->hole, data + index * element_size, element_size);
 
-    k_heap_key** min_key   =
-        DynamicArrayGetElemPtrByIndex (heap->array, min_index);
+    size_t cur_index = index;
 
-    k_heap_key** left_key  = 
-        DynamicArrayGetElemPtrByIndex (heap->array, left_child_index);
+    while (true)
+    {
+        const size_t first_child = cur_index * k + 1;
+        if (first_child >= heap_size) break;
 
-    k_heap_key** right_key = 
-        DynamicArrayGetElemPtrByIndex (heap->array, right_child_index);
+        const size_t last_child = (heap_size - first_child > k) ?
+                                  first_child + k : heap_size;
 
-    if (left_child_index < heap_size && left_key != NULL &&
-        heap->key_cmp (*min_key, *left_key) == K_HEAP_CMP_LESS)
-        min_index = left_child_index;
+        // children of a node are one aligned block, see KHeapOffset()
+        size_t max_child = first_child;
 
-    min_key = DynamicArrayGetElemPtrByIndex (heap->array, min_index);
+        for (size_t child = first_child + 1; child < last_child; ++child)
+            if (KHeapCompare (heap, data + max_child * element_size,
+                                    data + child     * element_size) == K_HEAP_CMP_LESS)
+                max_child = child;
 
-    if (right_child_index < heap_size && right_key != NULL &&
-        heap->key_cmp (*min_key, *right_key) == K_HEAP_CMP_LESS)
-        min_index = right_child_index;
+        if (KHeapCompare (heap, heap->hole, data + max_child * element_size) != K_HEAP_CMP_LESS)
+            break;
 
-    if (min_index != index)
-    {
-        KHeapSwap (heap, min_index, index);
-        return KHeapSiftDown (heap, min_index);
+        memcpy (data + cur_index * element_size, data + max_child * element_size, element_size);
+        cur_index = max_child;
     }
 
+    memcpy (data + cur_index * element_size, heap->hole, element_size);
+
     return K_HEAP_SUCCESS;
 }
 
+/**
+ * Pointer mode compares keys the elements point to. Inline mode passes
+ * key_cmp views of the elements on the stack, so it works with the same
+ * comparator and nothing is allocated.
+ */
+static inline int
+KHeapCompare (const k_heap_t* const heap,
+              const void*     const element_1,
+              const void*     const element_2)
+{
+    if (heap->key_size == 0)
+        return heap->key_cmp (*(k_heap_key* const*) element_1,
+                              *(k_heap_key* const*) element_2);
+
+    const k_heap_key view_1 = {(void*) element_1, heap->key_size};
+    const k_heap_key view_2 = {(void*) element_2, heap->key_size};
+
+    return heap->key_cmp (&view_1, &view_2);
+}
+
+/**
+ * Children of node i are k * i + 1 ... k * i + k. With k - 1 empty slots
+ * before the root they are at array indexes k * (i + 1) ... k * (i + 1) + k - 1,
+ * so with cache-line aligned data they start a block of k * element_size
+ * bytes: for pointers and k = 2, 4, 8 all children of a node are in one
+ * cache line, for k = 16 in two whole lines. If the block doesn't divide
+ * a line or a whole number of lines, there is no offset.
+ */
 static size_t
-KHeapSize (const k_heap_t* const heap)
+KHeapOffset (const size_t k,
+             const size_t element_size)
 {
-    if (heap        == NULL ||
-        heap->array == NULL)
-        return 0;
+    const size_t children_bytes = k * element_size;
+
+    if (k >= 2 &&
+        (K_HEAP_CACHE_LINE_SIZE % children_bytes == 0 ||
+         children_bytes % K_HEAP_CACHE_LINE_SIZE == 0))
+        return k - 1;
+
+    return 0;
+}
 
-    return heap->array->size;
+static d_array_t*
+KHeapArrayConstructor (const size_t element_size,
+                       const size_t offset)
+{
+    d_array_t* const array =
+        DynamicArrayConstructorWithMode (element_size,
+                                         DYNAMIC_ARRAY_MEMORY_ALIGNED);
+    if (array == NULL) return NULL;
+
+    // empty slots are zero bytes, NULL keys in pointer mode
+    if (DynamicArrayResize (array, offset) == DYNAMIC_ARRAY_ERROR)
+        return DynamicArrayDestructor (array);
+
+    return array;
 }
 
 static void
-KHeapSwap (k_heap_t* const heap,
-           const size_t index_1,
-           const size_t index_2)
+KHeapDestroyKeys (k_heap_t* const heap)
 {
-    if (heap        == NULL ||
-        heap->array == NULL)
-        return;
+    const size_t elem_number = KHeapSize (heap);
+
+    // inline keys are a part of the array
+    if (heap->key_size == 0)
+    {
+        for (size_t i = 0; i < elem_number; ++i)
+        {
+            k_heap_key** const cur_key = KHeapGetElemPtr (heap, i);
+
+            if (cur_key != NULL)
+                *cur_key = KHeapKeyDestructor (*cur_key);
+        }
+    }
 
-    k_heap_key** const key_ptr_1 =
-        DynamicArrayGetElemPtrByIndex (heap->array, index_1);
-    if (key_ptr_1 == NULL) return;
+    if (elem_number != 0)
+        heap->array->size = heap->offset;
+}
 
-    k_heap_key** const key_ptr_2 =
-        DynamicArrayGetElemPtrByIndex (heap->array, index_2);
-    if (key_ptr_2 == NULL) return;
+/**
+ * Elements without bounds checks, for sifts
+ */
+static inline char*
+KHeapData (const k_heap_t* const heap)
+{
+    return (char*) heap->array->data + heap->offset * heap->array->element_size;
+}
 
-    k_heap_key* const tmp_key = *key_ptr_1;
+static void*
+KHeapGetElemPtr (const k_heap_t* const heap,
+                 const size_t index)
+{
+    if (heap        == NULL ||
+        heap->array == NULL)
+        return NULL;
 
-    *key_ptr_1 = *key_ptr_2;
-    *key_ptr_2 = tmp_key;
+    return DynamicArrayGetElemPtrByIndex (heap->array, heap->offset + index);
 }
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
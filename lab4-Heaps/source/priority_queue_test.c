@@ -0,0 +1,201 @@
+#include "binomial_heap.h"
+#include "k_heap.h"
+#include "common.h"
+
+#include <limits.h>
+#include <string.h>
+
+
+// "priority_queue_test heap operation [k] < input", heap is binomial or k_heap,
+// operation is insert, extract, decrease or delete, k is arity of k_heap;
+// k_heap has no handles, so decrease and delete are measured on binomial only;
+// results of the operations are checked by heap_check_test, not here
+const size_t PQ_K_VALUE = 2;
+const int    PQ_K_HEAP_INFINITY_VALUE = INT_MIN;
+
+enum pq_operation
+{
+    PQ_INSERT   = 0,
+    PQ_EXTRACT  = 1,
+    PQ_DECREASE = 2,
+    PQ_DELETE   = 3,
+    PQ_UNKNOWN  = 4
+};
+
+
+
+// k_heap is a max-heap, reversed comparison makes it a min-heap like binomial
+int
+CompareMinKHeapKeys (const k_heap_key* const a,
+                     const k_heap_key* const b)
+{
+    assert (a);
+    assert (b);
+
+    int cmp_status = CompareInt (b->key, a->key);
+
+    if (cmp_status == INT_CMP_LESS)    return K_HEAP_CMP_LESS;
+    if (cmp_status == INT_CMP_GREATER) return K_HEAP_CMP_GREATER;
+    return K_HEAP_CMP_EQUAL;
+}
+
+clock_t
+BinomialHeapOperationTest (const int* const        array,
+                           const size_t            elem_number,
+                           const enum pq_operation operation)
+{
+    assert (array);
+
+    binomial_heap* heap = BinomialHeapConstructor ();
+    assert (heap);
+
+    binomial_heap_handle** const handles =
+        (binomial_heap_handle**) calloc (elem_number, sizeof (binomial_heap_handle*));
+    assert (handles);
+
+    clock_t begin = 0;
+    clock_t end   = 0;
+
+    // the heap is built untimed for every operation but insert
+    if (operation == PQ_INSERT) begin = clock ();
+
+    for (size_t i = 0; i < elem_number; i++)
+    {
+        handles[i] = BinomialHeapInsert (heap, array[i]);
+        assert (handles[i]);
+    }
+
+    if (operation != PQ_INSERT) begin = clock ();
+
+    binomial_heap_error_t error_status = BINOMIAL_HEAP_SUCCESS;
+
+    switch (operation)
+    {
+        case PQ_INSERT:
+            break;
+
+        case PQ_EXTRACT:
+            for (size_t i = 0; i < elem_number; i++)
+                error_status |= BinomialHeapExtractMin (heap, NULL);
+            break;
+
+        // halving never increases non-negative keys of generate_array
+        case PQ_DECREASE:
+            for (size_t i = 0; i < elem_number; i++)
+                error_status |= BinomialHeapDecreaseKey (heap, handles[i],
+                                                         (array[i] >= 0) ? array[i] / 2 : array[i]);
+            break;
+
+        // input order is random, so keys are deleted from all depths
+        case PQ_DELETE:
+            for (size_t i = 0; i < elem_number; i++)
+                error_status |= BinomialHeapDelete (heap, handles[i]);
+            break;
+
+        case PQ_UNKNOWN:
+        default:
+            assert (0);
+    }
+
+    end = clock ();
+
+    assert (error_status == BINOMIAL_HEAP_SUCCESS);
+
+    free (handles);
+    heap = BinomialHeapDestructor (heap);
+
+    return end - begin;
+}
+
+clock_t
+KHeapOperationTest (const int* const        array,
+                    const size_t            elem_number,
+                    const enum pq_operation operation,
+                    const size_t            k)
+{
+    assert (array);
+    assert (operation == PQ_INSERT || operation == PQ_EXTRACT);
+
+    k_heap_key* inf_key =
+        KHeapKeyConstructor (&PQ_K_HEAP_INFINITY_VALUE, sizeof (int));
+    assert (inf_key);
+
+    k_heap_t* heap =
+        KHeapConstructorInline (k, sizeof (int), inf_key, CompareMinKHeapKeys);
+    assert (heap);
+
+    clock_t begin = 0;
+    clock_t end   = 0;
+
+    if (operation == PQ_INSERT) begin = clock ();
+
+    k_heap_error_t error_status = K_HEAP_SUCCESS;
+
+    for (size_t i = 0; i < elem_number; i++)
+    {
+        const k_heap_key key = {.key = (void*) &array[i], .key_len = sizeof (int)};
+        error_status |= KHeapInsert (heap, &key);
+    }
+
+    if (operation == PQ_EXTRACT)
+    {
+        begin = clock ();
+
+        for (size_t i = 0; i < elem_number; i++)
+            error_status |= KHeapExtractRoot (heap);
+    }
+
+    end = clock ();
+
+    assert (error_status == K_HEAP_SUCCESS);
+
+    inf_key = KHeapKeyDestructor (inf_key);
+    heap    = KHeapDestructor    (heap);
+
+    return end - begin;
+}
+
+enum pq_operation
+GetOperation (const char* const name)
+{
+    assert (name);
+
+    if (strcmp (name, "insert")   == 0) return PQ_INSERT;
+    if (strcmp (name, "extract")  == 0) return PQ_EXTRACT;
+    if (strcmp (name, "decrease") == 0) return PQ_DECREASE;
+    if (strcmp (name, "delete")   == 0) return PQ_DELETE;
+
+    return PQ_UNKNOWN;
+}
+
+
+
+int main (int argc, char* argv[])
+{
+    if (argc < 3) return 1;
+
+    const bool              binomial  = (strcmp (argv[1], "binomial") == 0);
+    const enum pq_operation operation = GetOperation (argv[2]);
+
+    if (!binomial && strcmp (argv[1], "k_heap") != 0) return 1;
+    if (operation == PQ_UNKNOWN)                      return 1;
+    if (!binomial && operation != PQ_INSERT && operation != PQ_EXTRACT) return 1;
+
+    const size_t k = (argc > 3) ? strtoull (argv[3], NULL, 10) : PQ_K_VALUE;
+    if (k < 2) return 1;
+
+    size_t elem_number = 0;
+    if (scanf ("%zd", &elem_number) != 1) return 1;
+
+    printf ("%zu ", elem_number);
+
+    int* const array = ReadIntArray (elem_number);
+    assert (array);
+
+    printf ("%ld\n", binomial ?
+                     BinomialHeapOperationTest (array, elem_number, operation) :
+                     KHeapOperationTest        (array, elem_number, operation, k));
+
+    free (array);
+    return 0;
+}
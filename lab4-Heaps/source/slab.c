@@ -0,0 +1,192 @@
+#include "../include/slab.h"
+
+
+
+const size_t SLAB_INITIAL_BLOCK_CAPACITY = 64;
+const size_t SLAB_MAX_BLOCK_CAPACITY     = 1 << 16;
+
+
+
+//-----------------------------------------------------------------------------
+// Static functions prototypes
+//-----------------------------------------------------------------------------
+static bool
+SlabAddBlock (slab_t* const slab);
+
+static inline void*
+SlabNextFree (const void* const element);
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+
+//-----------------------------------------------------------------------------
+// Slab allocator functions implementation
+//-----------------------------------------------------------------------------
+//-------------------------------------
+// Constructor and destructor
+slab_t*
+SlabConstructor (const size_t element_size)
+{
+    if (element_size == 0) return NULL;
+
+    slab_t* const slab = (slab_t*) calloc (1, sizeof (slab_t));
+    if (slab == NULL) return NULL;
+
+    // free elements keep the pointer to the next one
+    const size_t min_size = (element_size < sizeof (void*)) ? sizeof (void*) : element_size;
+
+    slab->element_size   = (min_size + sizeof (void*) - 1) / sizeof (void*) * sizeof (void*);
+    slab->block_capacity = SLAB_INITIAL_BLOCK_CAPACITY;
+
+    return slab;
+}
+
+slab_t*
+SlabDestructor (slab_t* const slab)
+{
+    if (slab == NULL) return NULL;
+
+    slab_block_t* block = slab->blocks;
+
+    while (block != NULL)
+    {
+        slab_block_t* const next = block->next;
+        free (block);
+        block = next;
+    }
+
+    free (slab);
+    return NULL;
+}
+//-------------------------------------
+
+//-------------------------------------
+// Interface
+void*
+SlabAlloc (slab_t* const slab)
+{
+    if (slab == NULL) return NULL;
+
+    void* element = slab->free_list;
+
+    if (element != NULL)
+    {
+        slab->free_list = SlabNextFree (element);
+        if (slab->free_list == NULL) slab->free_tail = NULL;
+    }
+
+    else
+    {
+        if (slab->bump_left == 0 && !SlabAddBlock (slab))
+            return NULL;
+
+        element = slab->bump;
+        slab->bump += slab->element_size;
+        slab->bump_left--;
+    }
+
+    slab->allocated++;
+    return element;
+}
+
+void
+SlabFree (slab_t* const slab,
+          void*   const element)
+{
+    if (slab == NULL || element == NULL) return;
+
+    memcpy (element, &slab->free_list, sizeof (void*));
+
+    if (slab->free_list == NULL) slab->free_tail = element;
+    slab->free_list = element;
+
+    slab->allocated--;
+}
+
+void
+SlabMerge (slab_t* const destination,
+           slab_t* const source)
+{
+    if (destination == NULL || source == NULL || destination == source ||
+        destination->element_size != source->element_size)
+        return;
+
+    if (source->blocks != NULL)
+    {
+        if (destination->blocks == NULL) destination->blocks            = source->blocks;
+        else                             destination->blocks_tail->next = source->blocks;
+
+        destination->blocks_tail = source->blocks_tail;
+    }
+
+    if (source->free_list != NULL)
+    {
+        // source free list goes after destination free list
+        if (destination->free_list == NULL)
+            destination->free_list = source->free_list;
+        else
+            memcpy (destination->free_tail, &source->free_list, sizeof (void*));
+
+        destination->free_tail = source->free_tail;
+    }
+
+    // unused rest of source's newest block is not reused
+    destination->allocated += source->allocated;
+
+    if (source->block_capacity > destination->block_capacity)
+        destination->block_capacity = source->block_capacity;
+
+    source->blocks      = NULL;
+    source->blocks_tail = NULL;
+    source->free_list   = NULL;
+    source->free_tail   = NULL;
+    source->bump        = NULL;
+    source->bump_left   = 0;
+    source->allocated   = 0;
+}
+//-------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+
+//-----------------------------------------------------------------------------
+// Static functions implementation
+//-----------------------------------------------------------------------------
+static bool
+SlabAddBlock (slab_t* const slab)
+{
+    const size_t capacity = slab->block_capacity;
+
+    // header size keeps elements aligned like pointers
+    slab_block_t* const block =
+        (slab_block_t*) malloc (sizeof (slab_block_t) + capacity * slab->element_size);
+    if (block == NULL) return false;
+
+    block->next     = NULL;
+    block->capacity = capacity;
+
+    if (slab->blocks == NULL) slab->blocks            = block;
+    else                      slab->blocks_tail->next = block;
+
+    slab->blocks_tail = block;
+    slab->bump        = (char*) (block + 1);
+    slab->bump_left   = capacity;
+
+    if (slab->block_capacity < SLAB_MAX_BLOCK_CAPACITY)
+        slab->block_capacity *= 2;
+
+    return true;
+}
+
+static inline void*
+SlabNextFree (const void* const element)
+{
+    void* next = NULL;
+    memcpy (&next, element, sizeof (void*));
+
+    return next;
+}
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------